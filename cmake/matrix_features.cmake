@@ -11,10 +11,16 @@ option(MATRIX_FEATURE_MINOR_MATRIX "Enable minor matrix operation" ${_matrix_opt
 option(MATRIX_FEATURE_COFACTOR "Enable cofactor element operation" ${_matrix_optional_default})
 option(MATRIX_FEATURE_CRAMER "Enable Cramer's rule operation (and det-replace-column helper for steps)" ${_matrix_optional_default})
 
+option(MATRIX_FEATURE_THREADS "Run independent sub-computations (diagonal blocks) on worker threads (native only)" OFF)
+
 option(MATRIX_SHELL_DEBUG "Enable shell debug logging" OFF)
 
 function(matrix_resolve_feature_deps)
-  # for future dependency toggles
+  # no threads on the calculator
+  if(MATRIX_BUILD_CE AND MATRIX_FEATURE_THREADS)
+    message(WARNING "MATRIX_FEATURE_THREADS is native only; disabling it for the CE build.")
+    set(MATRIX_FEATURE_THREADS OFF CACHE BOOL "" FORCE)
+  endif()
 endfunction()
 
 function(matrix_get_feature_compile_definitions out_var)
@@ -44,6 +50,12 @@ function(matrix_get_feature_compile_definitions out_var)
     list(APPEND defs MATRIX_CORE_ENABLE_CRAMER=0 MATRIX_SHELL_ENABLE_CRAMER=0)
   endif()
 
+  if(MATRIX_FEATURE_THREADS)
+    list(APPEND defs MATRIX_CORE_ENABLE_THREADS=1)
+  else()
+    list(APPEND defs MATRIX_CORE_ENABLE_THREADS=0)
+  endif()
+
   if(MATRIX_SHELL_DEBUG)
     list(APPEND defs MATRIX_SHELL_ENABLE_DEBUG=1)
   else()
@@ -61,5 +73,5 @@ function(matrix_get_feature_compile_options out_var)
 endfunction()
 
 function(matrix_print_feature_summary)
-  message(STATUS "Matrix features: PROJECTION=${MATRIX_FEATURE_PROJECTION} MINOR_MATRIX=${MATRIX_FEATURE_MINOR_MATRIX} COFACTOR=${MATRIX_FEATURE_COFACTOR} CRAMER=${MATRIX_FEATURE_CRAMER} SHELL_DEBUG=${MATRIX_SHELL_DEBUG}")
+  message(STATUS "Matrix features: PROJECTION=${MATRIX_FEATURE_PROJECTION} MINOR_MATRIX=${MATRIX_FEATURE_MINOR_MATRIX} COFACTOR=${MATRIX_FEATURE_COFACTOR} CRAMER=${MATRIX_FEATURE_CRAMER} THREADS=${MATRIX_FEATURE_THREADS} SHELL_DEBUG=${MATRIX_SHELL_DEBUG}")
 endfunction()
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+#include "matrix_core/arena.hpp"
+#include "matrix_core/error.hpp"
+#include "matrix_core/matrix.hpp"
+#include "matrix_core/rational.hpp"
+
+namespace matrix_core::detail {
+// fraction-free (Bareiss) determinant; m is destroyed
+//
+// every division is exact, so integer input keeps integer intermediates
+ErrorCode bareiss_det(InOut MatrixMutView m, Out Rational* out) noexcept;
+
+// adj(A) = C^T for a square A (n >= 1), so adj(A)_ji = (-1)^{i+j} M_ij
+//
+// nonsingular A: det(A) A^{-1} from one PLU factorization. singular A (or a
+// factor path that overflows): every cofactor from a bareiss_det of its
+// minor; with MATRIX_CORE_ENABLE_THREADS the rows of that grid run in
+// parallel
+ErrorCode adjugate(In MatrixView a, InOut Arena& scratch, Out MatrixMutView out) noexcept;
+
+// the single cofactor C_ij = adj(A)_ji, through one solve when A is
+// nonsingular
+ErrorCode cofactor(In MatrixView a, In std::uint8_t i, In std::uint8_t j, InOut Arena& scratch, Out Rational* out) noexcept;
+} // namespace matrix_core::detail
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "matrix_core/arena.hpp"
+#include "matrix_core/config.hpp"
+#include "matrix_core/error.hpp"
+#include "matrix_core/matrix.hpp"
+
+namespace matrix_core::detail {
+// block-diagonal structure of a square matrix up to a symmetric permutation:
+// i and j share a block when they are connected through nonzero a_ij / a_ji
+//
+// block b covers the original indices perm[start[b] .. start[b + 1]), in
+// ascending order; blocks are ordered by their smallest index
+struct BlockPartition {
+		std::uint8_t n = 0;
+		std::uint8_t count = 0;
+		std::uint8_t perm[kMaxRows] = {};
+		std::uint8_t start[kMaxRows + 1] = {};
+
+		std::uint8_t size(std::uint8_t b) const noexcept { return static_cast<std::uint8_t>(start[b + 1] - start[b]); }
+		bool is_identity() const noexcept {
+				for (std::uint8_t i = 0; i < n; i++) {
+						if (perm[i] != i)
+								return false;
+				}
+				return true;
+		}
+};
+
+// connected components of the nonzero pattern of a (a must be square)
+void block_partition(In MatrixView a, Out BlockPartition* out) noexcept;
+
+// copies block b of a into a new size(b) x size(b) matrix
+ErrorCode block_gather(InOut Arena& arena, In MatrixView a, In const BlockPartition& p, In std::uint8_t b, Out MatrixMutView* out) noexcept;
+
+// writes block b back into the matching rows/cols of dst (the inverse of
+// block_gather)
+void block_scatter(In MatrixView blk, In const BlockPartition& p, In std::uint8_t b, Out MatrixMutView dst) noexcept;
+
+// P A P^T as a new matrix (block-diagonal)
+ErrorCode block_permuted(InOut Arena& arena, In MatrixView a, In const BlockPartition& p, Out MatrixMutView* out) noexcept;
+} // namespace matrix_core::detail
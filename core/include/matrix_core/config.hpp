@@ -23,3 +23,6 @@ constexpr std::size_t kMaxEntries = static_cast<std::size_t>(kMaxRows) * static_
 #ifndef MATRIX_CORE_ENABLE_CRAMER
 #define MATRIX_CORE_ENABLE_CRAMER 1
 #endif
+#ifndef MATRIX_CORE_ENABLE_THREADS
+#define MATRIX_CORE_ENABLE_THREADS 0
+#endif
@@ -6,6 +6,7 @@
 #include "matrix_core/error.hpp"
 #include "matrix_core/matrix.hpp"
 #include "matrix_core/row_ops.hpp"
+#include "matrix_core/row_reduction.hpp"
 
 namespace matrix_core::detail {
 // determinant via row ops (triangularize + multiply diagonal), with op-count
@@ -16,4 +17,13 @@ namespace matrix_core::detail {
 // meaningful)
 ErrorCode det_elim(
         InOut MatrixMutView m, Out Rational* det_out, Out std::size_t* op_count, In std::size_t stop_after, Out RowOp* last_op) noexcept;
+
+// det_elim to the end, obs counting its ops and OpGroups
+ErrorCode det_elim_observed(InOut MatrixMutView m, Out Rational* det_out, InOut OpObserver* obs) noexcept;
+
+// replays det_elim on m through explanation step `step` (1 based, one op or
+// with by_group one OpGroup) and writes that step's caption when caption is
+// set; StepOutOfRange past the last step
+ErrorCode det_elim_step(
+        InOut MatrixMutView m, In std::size_t step, In bool by_group, Out char* caption, In std::size_t caption_cap) noexcept;
 } // namespace matrix_core::detail
@@ -26,6 +26,8 @@ enum class ErrorCode : std::uint8_t {
 		IndexOutOfRange,
 		StepOutOfRange,
 		Internal,
+		Inconsistent, // A x = b has no solution
+		Pending,      // a resumable op ran out of budget; call it again to continue
 };
 
 struct Error {
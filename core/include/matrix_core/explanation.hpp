@@ -5,17 +5,47 @@
 
 #include "matrix_core/arena.hpp"
 #include "matrix_core/error.hpp"
+#include "matrix_core/latex.hpp"
+#include "matrix_core/writer.hpp"
 
 namespace matrix_core {
+class StepCache;
+
 struct StepRenderBuffers {
 		char* caption = nullptr;
 		std::size_t caption_cap = 0;
 		char* latex = nullptr;
 		std::size_t latex_cap = 0;
 		Arena* scratch = nullptr;
+		StepCache* cache = nullptr; // optional, see StepCache
+		latex::RowFragments* rows = nullptr; // optional, for renderers of row operation steps
+		latex::MatrixStyle style = latex::MatrixStyle::Plain; // of the bracketed matrices a step shows
+		const WriterSink* sink = nullptr; // set by Explanation::stream_step
+
+		// what renderers write the LaTeX through
+		latex::Buffer latex_buffer() const noexcept { return {latex, latex_cap, sink}; }
+		Writer latex_writer() const noexcept {
+				Writer w{latex, latex_cap, 0};
+				w.sink = sink;
+				return w;
+		}
+};
+
+// one buffer a step is rendered into as a single TeX document: the first
+// caption_cap bytes take the caption, the rest (after a newline) the LaTeX
+struct StepDocument {
+		char* data = nullptr;
+		std::size_t cap = 0;
+		std::size_t caption_cap = 0;
+		char* text = nullptr; // set by render_document: where the document starts
 };
 
 struct ExplanationVTable;
+class Explanation;
+
+// makes the real explanation behind a lazy one from the recipe handed to
+// Explanation::make_lazy, allocating its context from persist
+using ExplanationBuilder = ErrorCode (*)(In const void* recipe, InOut Arena& persist, InOut Arena& scratch, Out Explanation* out) noexcept;
 
 class Explanation {
 	  public:
@@ -33,11 +63,104 @@ class Explanation {
 		std::size_t step_count() const noexcept;
 		ErrorCode render_step(In std::size_t index, In const StepRenderBuffers& out) const noexcept;
 
+		// render_step straight into doc, as the caption, a newline and the
+		// LaTeX (just the LaTeX without a caption). the LaTeX is written in
+		// place and the caption moved up against it, so the document needs no
+		// second copy. out supplies scratch, cache and rows; its text buffers
+		// are not used. a step not in the cache is measured first, so one too
+		// long for doc fails with BufferTooSmall and leaves doc empty
+		ErrorCode render_document(In std::size_t index, In const StepRenderBuffers& out, InOut StepDocument* doc) const noexcept;
+
+		// render_step with the LaTeX handed to sink in chunks rather than kept:
+		// out.latex is only the chunk buffer, so a step of any size goes
+		// through one of a few dozen bytes, and matrices arrive a row at a
+		// time. the caption is written to out.caption as usual. the step cache
+		// and row fragments are not used
+		ErrorCode stream_step(In std::size_t index, In const StepRenderBuffers& out, In const WriterSink& sink) const noexcept;
+
+		// the buffer size (terminator included) render_step needs for the
+		// LaTeX of step index, found by streaming it through a counter. the
+		// caption is written to out.caption as usual
+		ErrorCode step_latex_size(In std::size_t index, In const StepRenderBuffers& out, Out std::size_t* bytes) const noexcept;
+
 		static Explanation make(void* ctx, const ExplanationVTable* vtable) noexcept;
 
+		// an explanation that only keeps recipe until build() makes the real
+		// one; until then it has no steps and render_step() fails with
+		// Internal. the wrapper is allocated from persist, recipe must outlive
+		// it, and build_bytes bounds what build(recipe) allocates. Overflow
+		// when persist is full
+		static ErrorCode make_lazy(InOut Arena& persist,
+		        In const void* recipe,
+		        In ExplanationBuilder build,
+		        In std::size_t build_bytes,
+		        Out Explanation* out) noexcept;
+
+		bool lazy() const noexcept;
+
+		// what build() may allocate from persist; 0 when there is nothing to build
+		std::size_t build_bytes() const noexcept;
+
+		// the explanation to step through: for a lazy one the real explanation,
+		// built from the recipe with its context in persist (clearing scratch),
+		// otherwise a borrow of this one. persist is left as it was on failure
+		ErrorCode build(InOut Arena& persist, InOut Arena& scratch, Out Explanation* out) const noexcept;
+
+		// a second handle on the same context that never destroys it; valid as
+		// long as this one is
+		Explanation borrow() const noexcept;
+
 	  private:
+		// render_step past the cache lookup
+		ErrorCode render_uncached(std::size_t index, const StepRenderBuffers& out) const noexcept;
+
 		void* ctx_ = nullptr;
 		const ExplanationVTable* vtable_ = nullptr;
+		std::uint32_t id_ = 0; // what StepCache keys on, new per make()
+		bool owned_ = true;
+};
+
+// the last few steps Explanation::render_step wrote, so paging back and
+// forth renders each step once. entry storage (a caption and a LaTeX buffer
+// per entry, sized by the host) is carved out of the arena passed to init.
+// a hit copies the stored text into the caller's buffers; a miss renders and
+// keeps a copy, evicting the least recently used entry. steps are keyed on
+// the explanation, the index and the style they were rendered in. every
+// Explanation::make gives a new key, so an explanation built again in the
+// same arena (say with another ExplainDetail) does not hit its predecessor's
+// steps
+class StepCache {
+	  public:
+		ErrorCode init(InOut Arena& arena, In std::uint8_t capacity, In std::size_t caption_cap, In std::size_t latex_cap) noexcept;
+
+		void clear() noexcept;
+
+		std::uint8_t capacity() const noexcept { return capacity_; }
+		std::size_t hits() const noexcept { return hits_; }
+		std::size_t misses() const noexcept { return misses_; }
+
+	  private:
+		friend class Explanation;
+
+		struct Entry {
+				std::uint32_t id = 0;
+				std::size_t index = 0;
+				latex::MatrixStyle style = latex::MatrixStyle::Plain;
+				std::uint32_t stamp = 0; // 0 = empty
+				char* caption = nullptr;
+				char* latex = nullptr;
+		};
+
+		bool find(In std::uint32_t id, In std::size_t index, In const StepRenderBuffers& out) noexcept;
+		void keep(In std::uint32_t id, In std::size_t index, In const StepRenderBuffers& out) noexcept;
+
+		Entry* entries_ = nullptr;
+		std::uint8_t capacity_ = 0;
+		std::size_t caption_cap_ = 0;
+		std::size_t latex_cap_ = 0;
+		std::uint32_t clock_ = 0;
+		std::size_t hits_ = 0;
+		std::size_t misses_ = 0;
 };
 
 struct ExplanationVTable {
@@ -3,16 +3,28 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "matrix_core/arena.hpp"
+#include "matrix_core/config.hpp"
 #include "matrix_core/error.hpp"
 #include "matrix_core/matrix.hpp"
 #include "matrix_core/rational.hpp"
 
+namespace matrix_core {
+struct WriterSink;
+} // namespace matrix_core
+
 namespace matrix_core::latex {
+// with a sink, data is only the chunk buffer of a streamed write (see
+// Writer); matrices are handed over a row at a time
 struct Buffer {
 		char* data = nullptr;
 		std::size_t cap = 0;
+		const WriterSink* sink = nullptr;
 };
 
+// the longest LaTeX of one rational, \frac{-9223372036854775808}{9223372036854775807}
+constexpr std::size_t kRationalLatexMax = 48;
+
 ErrorCode write_rational(In const Rational& r, Out Buffer out) noexcept;
 ErrorCode write_rational_display(In const Rational& r, Out Buffer out) noexcept;
 
@@ -25,10 +37,120 @@ enum class MatrixBrackets : std::uint8_t {
 ErrorCode write_matrix(In MatrixView m, In MatrixBrackets brackets, Out Buffer out) noexcept;
 ErrorCode write_matrix_display(In MatrixView m, In MatrixBrackets brackets, Out Buffer out) noexcept;
 
+// how a bracketed (not augmented) matrix is laid out
+enum class MatrixStyle : std::uint8_t {
+		Plain,
+		// entries with a common denominator d > 1 as \frac{1}{d} times an
+		// integer matrix, when that is shorter than Plain. vmatrix stays Plain,
+		// since a determinant does not scale that way
+		FactorDenominator,
+};
+
+// the least common denominator of m's entries (1 for an integer matrix);
+// Overflow when it does not fit
+ErrorCode common_denominator(In MatrixView m, Out std::int64_t* d) noexcept;
+
+// write_matrix_display in the given style
+ErrorCode write_matrix_display(In MatrixView m, In MatrixBrackets brackets, In MatrixStyle style, Out Buffer out) noexcept;
+
 // writes an augmented matrix [L | R] using the latex array environment
 //
 // example:
 //   \\left[\\begin{array}{rr|rr} ... \\end{array}\\right]
 ErrorCode write_augmented_matrix(In MatrixView left, In MatrixView right, Out Buffer out) noexcept;
 ErrorCode write_augmented_matrix_display(In MatrixView left, In MatrixView right, Out Buffer out) noexcept;
+
+// the buffer size (terminator included) the writer of the same name needs
+// for these arguments, found without writing anything. errors are the
+// writer's, except that there is no BufferTooSmall
+ErrorCode write_rational_size(In const Rational& r, Out std::size_t* bytes) noexcept;
+ErrorCode write_rational_display_size(In const Rational& r, Out std::size_t* bytes) noexcept;
+ErrorCode write_matrix_size(In MatrixView m, In MatrixBrackets brackets, Out std::size_t* bytes) noexcept;
+ErrorCode write_matrix_display_size(In MatrixView m, In MatrixBrackets brackets, Out std::size_t* bytes) noexcept;
+ErrorCode write_matrix_display_size(
+        In MatrixView m, In MatrixBrackets brackets, In MatrixStyle style, Out std::size_t* bytes) noexcept;
+ErrorCode write_augmented_matrix_size(In MatrixView left, In MatrixView right, Out std::size_t* bytes) noexcept;
+ErrorCode write_augmented_matrix_display_size(In MatrixView left, In MatrixView right, Out std::size_t* bytes) noexcept;
+
+// the largest buffer size (terminator included) write_matrix needs for a
+// rows x cols matrix whose entries take at most entry_bytes each. the bracket
+// environments are all as long as bmatrix
+constexpr std::size_t matrix_bound(std::uint8_t rows, std::uint8_t cols, std::size_t entry_bytes = kRationalLatexMax) noexcept {
+		const std::size_t entries = static_cast<std::size_t>(rows) * cols;
+		const std::size_t amps = (cols == 0) ? 0 : static_cast<std::size_t>(rows) * (cols - 1u) * 3u;
+		const std::size_t breaks = (rows == 0) ? 0 : (rows - 1u) * 4u;
+		// \begin{bmatrix} ... \end{bmatrix}
+		return 15u + entries * entry_bytes + amps + breaks + 13u + 1u;
+}
+
+constexpr std::size_t matrix_display_bound(std::uint8_t rows, std::uint8_t cols, std::size_t entry_bytes = kRationalLatexMax) noexcept {
+		return matrix_bound(rows, cols, entry_bytes) + 4u;
+}
+
+// write_augmented_matrix's counterpart of matrix_bound
+constexpr std::size_t augmented_matrix_bound(
+        std::uint8_t rows, std::uint8_t left_cols, std::uint8_t right_cols, std::size_t entry_bytes = kRationalLatexMax) noexcept {
+		const std::uint8_t cols = static_cast<std::uint8_t>(left_cols + right_cols);
+		// \left[\begin{array}{r..r|r..r} ... \end{array}\right], the body as in a bmatrix
+		return 20u + cols + 2u + (matrix_bound(rows, cols, entry_bytes) - 15u - 13u) + 18u;
+}
+
+constexpr std::size_t augmented_matrix_display_bound(
+        std::uint8_t rows, std::uint8_t left_cols, std::uint8_t right_cols, std::size_t entry_bytes = kRationalLatexMax) noexcept {
+		return augmented_matrix_bound(rows, left_cols, right_cols, entry_bytes) + 4u;
+}
+
+// which step a write_rows_display is for. changed has a bit per row the
+// step's row operation wrote, relative to step index - 1 of the same owner
+struct RowStep {
+		const void* owner = nullptr;
+		std::size_t index = 0;
+		std::uint32_t changed = 0;
+};
+
+constexpr std::uint32_t kAllRows = (1u << kMaxRows) - 1u;
+
+// the LaTeX of each row of the matrix the last step showed, so the next step
+// formats again only the rows its row operation changed. row storage (a
+// fixed capacity per row) is carved out of the arena passed to init; rows
+// that do not fit fall back to writing the whole matrix
+class RowFragments;
+
+// write_matrix_display of left (right.cols == 0) or
+// write_augmented_matrix_display of [left | right], byte for byte, keeping the
+// rows in frags: rows not in step.changed are reused when frags holds step
+// index - 1 of step.owner in the same shape, and all of them when it holds
+// step index itself
+ErrorCode write_rows_display(
+        In MatrixView left, In MatrixView right, In const RowStep& step, InOut RowFragments& frags, Out Buffer out) noexcept;
+
+// the size write_rows_display needs, whatever frags holds
+ErrorCode write_rows_display_size(In MatrixView left, In MatrixView right, Out std::size_t* bytes) noexcept;
+
+class RowFragments {
+	  public:
+		ErrorCode init(InOut Arena& arena, In std::size_t row_cap) noexcept;
+
+		// forgets the rows, e.g. before showing another explanation whose
+		// context may reuse the owner address
+		void clear() noexcept;
+
+		// rows formatted so far, reused ones not counted
+		std::size_t rows_written() const noexcept { return rows_written_; }
+
+	  private:
+		friend ErrorCode write_rows_display(MatrixView left, MatrixView right, const RowStep& step, RowFragments& frags,
+		                                    Buffer out) noexcept;
+
+		char* row(std::uint8_t r) noexcept { return data_ + static_cast<std::size_t>(r) * row_cap_; }
+
+		char* data_ = nullptr;
+		std::size_t row_cap_ = 0;
+		const void* owner_ = nullptr; // nullptr = holds nothing
+		std::size_t index_ = 0;
+		std::uint8_t rows_ = 0;
+		std::uint8_t left_cols_ = 0;
+		std::uint8_t right_cols_ = 0;
+		std::size_t rows_written_ = 0;
+};
 } // namespace matrix_core::latex
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "matrix_core/error.hpp"
+#include "matrix_core/matrix.hpp"
+#include "matrix_core/row_ops.hpp"
+
+namespace matrix_core::detail {
+// symmetric LDL^T elimination without pivoting, reading and updating only the
+// lower triangle of m
+//
+// each op is the congruence R_i <- R_i + k R_j, C_i <- C_i + k C_j (reported
+// as an AddMul RowOp), so the matrix stays symmetric and ends up as D. on
+// completion the diagonal holds D and the strict upper triangle holds L^T
+// (m(j, i) = l_ij)
+//
+// returns DivisionByZero when a zero pivot has a nonzero entry below it; the
+// caller should fall back to the pivoting path. a zero pivot over an already
+// zero column is skipped (D then has a zero, A is singular)
+//
+// if stop_after != size_t(-1), stops after exactly stop_after ops (1 based)
+ErrorCode ldlt_elim(InOut MatrixMutView m, Out std::size_t* op_count, In std::size_t stop_after, Out RowOp* last_op) noexcept;
+
+// det(A) = prod(D) for a completed ldlt_elim factor
+ErrorCode ldlt_det(In MatrixView f, Out Rational* det_out) noexcept;
+
+// number of row ops the [A | I] symmetric Gauss-Jordan replay performs for a
+// completed factor: one per nonzero l_ij on the way down and up, plus one
+// scale per d_i != 1
+std::size_t ldlt_inverse_op_count(In MatrixView f) noexcept;
+
+// the OpGroups of that replay: one per column of L with a nonzero l_ij on
+// the way down, one per column of L^T with one on the way up, plus one for
+// all the scales
+std::size_t ldlt_inverse_group_count(In MatrixView f) noexcept;
+
+// solves A x = b (b, x are n x 1) with a completed, nonsingular factor
+ErrorCode ldlt_solve(In MatrixView f, In MatrixView b, Out MatrixMutView x) noexcept;
+
+// mirrors the lower triangle of a partially eliminated m into its upper
+// triangle (drops the stored L^T) so the current symmetric matrix can be shown
+void ldlt_mirror_lower(InOut MatrixMutView m) noexcept;
+} // namespace matrix_core::detail
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "matrix_core/arena.hpp"
+#include "matrix_core/config.hpp"
+#include "matrix_core/error.hpp"
+#include "matrix_core/matrix.hpp"
+#include "matrix_core/rational.hpp"
+#include "matrix_core/row_ops.hpp"
+
+namespace matrix_core {
+
+// exact PLU factorization P A = L U of a square matrix
+//
+// pivots are picked like det_elim (first nonzero entry at or below the
+// diagonal), so the forward row ops match the determinant explanation
+//
+// lu holds U on and above the diagonal and the unit lower L multipliers below
+// it; row i of P A is row perm[i] of A. a column without a pivot is skipped and
+// leaves a zero on the diagonal (singular == true)
+struct LuFactor {
+		MatrixMutView lu{};
+		std::uint8_t perm[kMaxRows] = {};
+		std::int8_t sign = 1;
+		bool singular = false;
+		std::size_t op_count = 0; // swaps + nonzero eliminations
+		std::size_t det_ops = 0;  // ops before the first column without a pivot (what det_elim performs)
+		std::size_t groups = 0;     // OpGroups among op_count (columns that needed an op)
+		std::size_t det_groups = 0; // ... and among det_ops
+};
+
+// factors m in place (m becomes out->lu)
+//
+// if stop_after != size_t(-1), stops after exactly stop_after ops (1 based)
+// and reports the last one; the factor is then partial
+ErrorCode lu_factor_in_place(InOut MatrixMutView m, Out LuFactor* out, In std::size_t stop_after, Out RowOp* last_op) noexcept;
+
+// copies a into arena and factors the copy
+ErrorCode lu_factor(In MatrixView a, InOut Arena& arena, Out LuFactor* out) noexcept;
+
+// det(A) = sign * prod(u_ii)
+ErrorCode lu_det(In const LuFactor& f, Out Rational* out) noexcept;
+
+// solves A X = B column by column (B, X are n x k) through L y = P b, U x = y
+// returns Singular when f is singular
+ErrorCode lu_solve(In const LuFactor& f, In MatrixView b, Out MatrixMutView x) noexcept;
+
+// A^{-1} from n solves against the columns of I
+ErrorCode lu_inverse(In const LuFactor& f, Out MatrixMutView out) noexcept;
+
+// number of row ops the forward / scale / back [A | I] replay performs for a
+// nonsingular factor: the forward ops, one scale per u_ii != 1, one op per
+// nonzero u_ij above the diagonal
+std::size_t lu_inverse_op_count(In const LuFactor& f) noexcept;
+
+// the OpGroups of that replay: the forward groups, one for all the scales,
+// one per column with a nonzero u_ij above the diagonal
+std::size_t lu_inverse_group_count(In const LuFactor& f) noexcept;
+
+// expands f into separate n x n L, U and P (P A = L U); any output may have
+// null data to skip it
+void lu_unpack(In const LuFactor& f, Out MatrixMutView l, Out MatrixMutView u, Out MatrixMutView p) noexcept;
+
+// small LRU of factors keyed on matrix contents (content_hash), so repeated
+// ops on an unchanged slot skip the elimination. every entry keeps a copy of
+// the matrix it factored and a hit must match it. entry storage is carved out
+// of the arena passed to init and lives as long as that arena region
+class LuCache {
+	  public:
+		ErrorCode init(InOut Arena& arena, In std::uint8_t capacity) noexcept;
+
+		// returns the factor for a, factoring into the least recently used entry
+		// on a miss. the pointer stays valid until the next get() miss
+		ErrorCode get(In MatrixView a, Out const LuFactor** out) noexcept;
+
+		void clear() noexcept;
+
+		std::uint8_t capacity() const noexcept { return capacity_; }
+		std::size_t hits() const noexcept { return hits_; }
+		std::size_t misses() const noexcept { return misses_; }
+
+	  private:
+		struct Entry {
+				std::uint64_t hash = 0;
+				std::uint32_t stamp = 0; // 0 = empty
+				Rational* storage = nullptr;
+				Rational* input = nullptr; // the factored matrix; storage is overwritten
+				LuFactor factor;
+		};
+
+		Entry* entries_ = nullptr;
+		std::uint8_t capacity_ = 0;
+		std::uint32_t clock_ = 0;
+		std::size_t hits_ = 0;
+		std::size_t misses_ = 0;
+};
+
+// det(A), rank(A) and, while A is nonsingular, A^{-1} kept current across
+// single entry edits
+//
+// a nonsingular A updates in O(n^2): A' = A + d e_r e_c^T gives
+// det(A') = det(A) g and Sherman-Morrison
+// A'^{-1} = A^{-1} - (d / g) A^{-1} e_r e_c^T A^{-1}, g = 1 + d (A^{-1})_cr.
+// anything else (g == 0, a singular or non square A, an overflow) refactors
+// the edited matrix. the inverse storage is carved out of the arena passed to
+// init, like LuCache
+class EditTracker {
+	  public:
+		ErrorCode init(InOut Arena& arena) noexcept;
+
+		// refactors a from scratch
+		ErrorCode reset(In MatrixView a, InOut Arena& scratch) noexcept;
+
+		// a already holds the new value at (r, c), old_value the one before
+		ErrorCode update(
+		        In MatrixView a, In std::uint8_t r, In std::uint8_t c, In const Rational& old_value, InOut Arena& scratch) noexcept;
+
+		bool known() const noexcept { return known_; } // false until reset() and after an overflow
+		bool square() const noexcept { return square_; }
+		const Rational& det() const noexcept { return det_; } // square only
+		std::uint8_t rank() const noexcept { return rank_; }
+		bool has_inverse() const noexcept { return known_ && square_ && !det_.is_zero(); }
+		MatrixView inverse() const noexcept { return inv_.view(); }
+
+		std::size_t refactors() const noexcept { return refactors_; }
+
+	  private:
+		ErrorCode sherman_morrison(In std::uint8_t r, In std::uint8_t c, In const Rational& delta) noexcept;
+
+		Rational* storage_ = nullptr;
+		MatrixMutView inv_{};
+		Rational det_ = Rational::from_int(0);
+		std::uint8_t rank_ = 0;
+		bool square_ = false;
+		bool known_ = false;
+		std::size_t refactors_ = 0;
+};
+
+} // namespace matrix_core
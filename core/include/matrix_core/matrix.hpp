@@ -10,19 +10,30 @@
 #include "matrix_core/rational.hpp"
 
 namespace matrix_core {
+// entry (r, c) lives at data[r * stride + c * col_stride]; col_stride is 1
+// for row-major storage, and swapping the two strides (see transposed()) gives
+// the transpose without touching the entries
 struct MatrixView {
 		std::uint8_t rows = 0;
 		std::uint8_t cols = 0;
 		std::uint8_t stride = 0;
 		const Rational* data = nullptr;
+		std::uint8_t col_stride = 1;
 
 		constexpr Dim dim() const noexcept { return {rows, cols}; }
 
+		constexpr MatrixView transposed() const noexcept { return {cols, rows, col_stride, data, stride}; }
+
+		// columns [first, first + count) over the same entries
+		constexpr MatrixView columns(std::uint8_t first, std::uint8_t count) const noexcept {
+				return {rows, count, stride, data + static_cast<std::size_t>(first) * col_stride, col_stride};
+		}
+
 		const Rational& at(std::uint8_t r, std::uint8_t c) const noexcept {
 				assert(data);
 				assert(r < rows);
 				assert(c < cols);
-				return data[static_cast<std::size_t>(r) * stride + static_cast<std::size_t>(c)];
+				return data[static_cast<std::size_t>(r) * stride + static_cast<std::size_t>(c) * col_stride];
 		}
 };
 
@@ -31,23 +42,64 @@ struct MatrixMutView {
 		std::uint8_t cols = 0;
 		std::uint8_t stride = 0;
 		Rational* data = nullptr;
+		std::uint8_t col_stride = 1;
 
-		MatrixView view() const noexcept { return {rows, cols, stride, data}; }
+		MatrixView view() const noexcept { return {rows, cols, stride, data, col_stride}; }
 
 		constexpr Dim dim() const noexcept { return {rows, cols}; }
 
+		constexpr MatrixMutView transposed() const noexcept { return {cols, rows, col_stride, data, stride}; }
+
+		constexpr MatrixMutView columns(std::uint8_t first, std::uint8_t count) const noexcept {
+				return {rows, count, stride, data + static_cast<std::size_t>(first) * col_stride, col_stride};
+		}
+
 		const Rational& at(std::uint8_t r, std::uint8_t c) const noexcept {
 				assert(data);
 				assert(r < rows);
 				assert(c < cols);
-				return data[static_cast<std::size_t>(r) * stride + static_cast<std::size_t>(c)];
+				return data[static_cast<std::size_t>(r) * stride + static_cast<std::size_t>(c) * col_stride];
 		}
 
 		Rational& at_mut(std::uint8_t r, std::uint8_t c) noexcept {
 				assert(data);
 				assert(r < rows);
 				assert(c < cols);
-				return data[static_cast<std::size_t>(r) * stride + static_cast<std::size_t>(c)];
+				return data[static_cast<std::size_t>(r) * stride + static_cast<std::size_t>(c) * col_stride];
+		}
+};
+
+// a with row del_r and column del_c left out, read through index maps so
+// nothing is copied. swapping two map entries swaps rows (or columns) of the
+// view for free; kernels that write materialize it first (matrix_copy)
+struct MinorView {
+		MatrixView base{};
+		std::uint8_t rows = 0;
+		std::uint8_t cols = 0;
+		std::uint8_t row_map[kMaxRows] = {};
+		std::uint8_t col_map[kMaxCols] = {};
+
+		constexpr Dim dim() const noexcept { return {rows, cols}; }
+
+		const Rational& at(std::uint8_t r, std::uint8_t c) const noexcept {
+				assert(r < rows);
+				assert(c < cols);
+				return base.at(row_map[r], col_map[c]);
+		}
+};
+
+// [left | right] read side by side, e.g. [A | b] or [A | I], without copying
+// either block; right may be empty (no columns)
+struct AugmentedView {
+		MatrixView left{};
+		MatrixView right{};
+
+		constexpr std::uint8_t rows() const noexcept { return left.rows; }
+		constexpr std::uint8_t cols() const noexcept { return static_cast<std::uint8_t>(left.cols + right.cols); }
+		constexpr Dim dim() const noexcept { return {rows(), cols()}; }
+
+		const Rational& at(std::uint8_t r, std::uint8_t c) const noexcept {
+				return (c < left.cols) ? left.at(r, c) : right.at(r, static_cast<std::uint8_t>(c - left.cols));
 		}
 };
 
@@ -56,6 +108,26 @@ ErrorCode matrix_clone(InOut Arena& arena, In MatrixView src, Out MatrixMutView*
 ErrorCode matrix_copy(In MatrixView src, Out MatrixMutView dst) noexcept;
 void matrix_fill_zero(Out MatrixMutView m) noexcept;
 
+// a needs at least 2 rows and columns
+ErrorCode minor_view(In MatrixView a, In std::uint8_t del_r, In std::uint8_t del_c, Out MinorView* out) noexcept;
+ErrorCode matrix_copy(In const MinorView& src, Out MatrixMutView dst) noexcept;
+ErrorCode matrix_clone(InOut Arena& arena, In const MinorView& src, Out MatrixMutView* out) noexcept;
+
+// left and right need the same row count and at most kMaxCols columns together
+ErrorCode augmented_view(In MatrixView left, In MatrixView right, Out AugmentedView* out) noexcept;
+ErrorCode matrix_copy(In const AugmentedView& src, Out MatrixMutView dst) noexcept;
+
+// order independent content hash: the dims plus one mixed word per entry,
+// summed, so an edit updates it in O(1) instead of rehashing every entry
+std::uint64_t content_hash(In MatrixView a) noexcept;
+std::uint64_t content_hash_update(
+        In std::uint64_t h, In std::uint8_t r, In std::uint8_t c, In const Rational& old_value, In const Rational& new_value) noexcept;
+
+// same dims and entries; caches confirm a hash hit with it
+bool matrix_equal(In MatrixView a, In MatrixView b) noexcept;
+
+bool matrix_is_symmetric(In MatrixView m) noexcept;
+
 ErrorCode matrix_add(In MatrixView a, In MatrixView b, Out MatrixMutView out) noexcept;
 ErrorCode matrix_sub(In MatrixView a, In MatrixView b, Out MatrixMutView out) noexcept;
 ErrorCode matrix_mul(In MatrixView a, In MatrixView b, Out MatrixMutView out) noexcept;
@@ -5,9 +5,11 @@
 #include "matrix_core/error.hpp"
 #include "matrix_core/explanation.hpp"
 #include "matrix_core/latex.hpp"
+#include "matrix_core/lu.hpp"
 #include "matrix_core/matrix.hpp"
 #include "matrix_core/ops.hpp"
 #include "matrix_core/rational.hpp"
+#include "matrix_core/result_cache.hpp"
 #include "matrix_core/row_ops.hpp"
 #include "matrix_core/slab.hpp"
 #include "matrix_core/spaces.hpp"
@@ -7,20 +7,27 @@
 #include "matrix_core/config.hpp"
 #include "matrix_core/error.hpp"
 #include "matrix_core/explanation.hpp"
+#include "matrix_core/lu.hpp"
 #include "matrix_core/matrix.hpp"
 #include "matrix_core/rational.hpp"
 #include "matrix_core/row_ops.hpp"
+#include "matrix_core/row_reduction.hpp"
+#include "matrix_core/spaces.hpp"
 
 namespace matrix_core {
 enum class ExplainDetail : std::uint8_t {
 		Full = 0,
-		Compact, // fewer, higher level steps
+		Compact, // one step per OpGroup (pivot column) in echelon, inverse, det, det replace column and cofactor
 };
 
 struct ExplainOptions {
 		bool enable = false;
 		Arena* persist = nullptr; // required when enable==true
 		ExplainDetail detail = ExplainDetail::Full;
+		// op_det and op_inverse (and their _cached forms) only keep a recipe;
+		// the host makes the explanation with Explanation::build when the
+		// steps are asked for. other ops build it right away
+		bool lazy = false;
 };
 
 // indices in these APIs are 0 based (consistent with m.at(r, c))
@@ -34,11 +41,16 @@ struct ExplainOptions {
 // - step rendering requires StepRenderBuffers::scratch to be a valid arena, it
 // is
 //   cleared by the renderer on each call
+// - a lazy explanation reruns the op in the scratch arena handed to
+//   Explanation::build, clearing it
 //
 Error op_add(In MatrixView a, In MatrixView b, Out MatrixMutView out, Out Explanation* expl, In const ExplainOptions& opts) noexcept;
 Error op_sub(In MatrixView a, In MatrixView b, Out MatrixMutView out, Out Explanation* expl, In const ExplainOptions& opts) noexcept;
 Error op_mul(In MatrixView a, In MatrixView b, Out MatrixMutView out, Out Explanation* expl, In const ExplainOptions& opts) noexcept;
 Error op_transpose(In MatrixView a, Out MatrixMutView out, Out Explanation* expl, In const ExplainOptions& opts) noexcept;
+// A^T as a view of a's entries (strides swapped, nothing copied); valid as
+// long as a's storage is
+Error op_transpose_view(In MatrixView a, Out MatrixView* out, Out Explanation* expl, In const ExplainOptions& opts) noexcept;
 
 enum class EchelonKind : std::uint8_t {
 		Ref,
@@ -48,8 +60,77 @@ enum class EchelonKind : std::uint8_t {
 Error op_echelon(
         In MatrixView a, In EchelonKind kind, Out MatrixMutView out, Out Explanation* expl, In const ExplainOptions& opts) noexcept;
 
+// op_echelon of [left | right], read through the view so the augmented input
+// is never materialized; out is the full rows x (left + right cols) result and
+// steps show the bar between the blocks
+Error op_echelon_augmented(In const AugmentedView& a,
+        In EchelonKind kind,
+        Out MatrixMutView out,
+        Out Explanation* expl,
+        In const ExplainOptions& opts) noexcept;
+
+// op_echelon_augmented in slices, so a host can keep drawing (and let the
+// user cancel) while a large reduction runs
+//
+// op_echelon_begin copies a into out. each op_echelon_run then applies at
+// most budget row operations and returns Pending until the reduction is
+// done; the finishing run builds the explanation like op_echelon_augmented.
+// task and out must stay put between runs, dropping the task cancels
+struct EchelonTask {
+		AugmentedView input{};
+		EchelonKind kind{};
+		MatrixMutView out{};
+		EchelonCursor cursor{};
+		OpObserver obs{}; // ops and OpGroups so far
+};
+
+Error op_echelon_begin(In const AugmentedView& a, In EchelonKind kind, Out MatrixMutView out, Out EchelonTask* task) noexcept;
+Error op_echelon_run(InOut EchelonTask* task, In std::size_t budget, Out Explanation* expl, In const ExplainOptions& opts) noexcept;
+
+// 0..100, from the columns already reduced
+std::uint8_t op_echelon_progress(In const EchelonTask& task) noexcept;
+
+// solves A X = B for all k columns of B with one RREF of [A | B]
+//
+// B is carried as a second block next to A rather than copied into one
+// matrix, so A (m x n) and B (m x k) can each take a full slot. only A's
+// columns are pivoted. x_out (n x k) gets one solution per column with the
+// free variables set to 0; a column with no solution fails with
+// Inconsistent and err.j its index
+//
+// when opts.enable==true, steps show [A | B] after each row operation of the
+// shared elimination
+Error op_solve_multi(In MatrixView a,
+        In MatrixView b,
+        InOut Arena& scratch,
+        Out MatrixMutView x_out,
+        Out Explanation* expl,
+        In const ExplainOptions& opts) noexcept;
+
+// rank, pivots and the bases of Col(A), Row(A), Null(A) and Null(A^T), all
+// from one RREF of [A | I] (see FundamentalSpaces) and served from cache
+// while a is unchanged; *out stays valid until the next cache miss
+//
+// when opts.enable==true, steps replay that elimination: on [A | I] when
+// show_identity (the Null(A^T) basis is read from I's block), else on A alone
+Error op_fundamental_spaces(In MatrixView a,
+        InOut SpacesCache& cache,
+        InOut Arena& scratch,
+        In bool show_identity,
+        Out const FundamentalSpaces** out,
+        Out Explanation* expl,
+        In const ExplainOptions& opts) noexcept;
+
 Error op_det(In MatrixView a, InOut Arena& scratch, Out Rational* out, Out Explanation* expl, In const ExplainOptions& opts) noexcept;
 
+// op_det reusing the cached PLU factor of a (same result and steps)
+Error op_det_cached(In MatrixView a,
+        InOut LuCache& cache,
+        InOut Arena& scratch,
+        Out Rational* out,
+        Out Explanation* expl,
+        In const ExplainOptions& opts) noexcept;
+
 // determinant of A with column "col" replaced by vector "b" (n x 1), useful for
 // cramer's rule step breakdown (Δ_i)
 Error op_det_replace_column(In MatrixView a,
@@ -81,16 +162,45 @@ Error op_minor_matrix(In MatrixView a, InOut Arena& scratch, Out MatrixMutView o
 // cramers rule solve (Ax=b), returning x as an n x 1 matrix. no step breakdown
 // is produced here, shell can request Δ and Δ_i explanations via op_det()
 // and op_det_replace_column()
+//
+// A is factored once and x comes from two triangular solves; x_i = Δ_i / Δ
+// holds exactly, so Δ_i = Δ x_i needs no further elimination
 Error op_cramer_solve(In MatrixView a, In MatrixView b, InOut Arena& scratch, Out MatrixMutView x_out) noexcept;
 
-// inverse via gauss jordan elimination on the augmented matrix [A | I]
+// op_cramer_solve reusing the cached PLU factor of a
+Error op_cramer_solve_cached(
+        In MatrixView a, In MatrixView b, InOut LuCache& cache, InOut Arena& scratch, Out MatrixMutView x_out) noexcept;
+
+// inverse from a PLU factorization (n triangular solves)
 //
 // on success, writes A^{-1} into out
-// when opts.enable==true, explanation steps render the augmented matrix after
-// each row operation
+// when opts.enable==true, explanation steps render the augmented matrix [A | I]
+// after each row operation of the matching elimination (forward with swaps,
+// scale the pivots, then back)
 Error op_inverse(
         In MatrixView a, InOut Arena& scratch, Out MatrixMutView out, Out Explanation* expl, In const ExplainOptions& opts) noexcept;
 
+// op_inverse reusing the cached PLU factor of a (same result and steps)
+Error op_inverse_cached(In MatrixView a,
+        InOut LuCache& cache,
+        InOut Arena& scratch,
+        Out MatrixMutView out,
+        Out Explanation* expl,
+        In const ExplainOptions& opts) noexcept;
+
+// PLU factorization P A = L U of square A (first nonzero pivot)
+//
+// l_out, u_out and p_out are n x n
+// when opts.enable==true, explanation steps show U forming after each row op,
+// then L (and P when rows were swapped)
+Error op_lu(In MatrixView a,
+        InOut Arena& scratch,
+        Out MatrixMutView l_out,
+        Out MatrixMutView u_out,
+        Out MatrixMutView p_out,
+        Out Explanation* expl,
+        In const ExplainOptions& opts) noexcept;
+
 /// Vector operations
 
 // dot product of two vectors. vectors may be represented as n×1 or 1×n
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+#include "matrix_core/config.hpp"
+#include "matrix_core/error.hpp"
+
+namespace matrix_core::detail {
+using ParallelTask = void (*)(void* ctx, std::uint8_t index) noexcept;
+
+// runs task(ctx, i) for every i < count and returns once all are done
+//
+// with MATRIX_CORE_ENABLE_THREADS the tasks run on worker threads, so they
+// must not share mutable state (give each its own scratch memory); otherwise
+// they run inline, in order
+void parallel_for(In std::uint8_t count, In ParallelTask task, InOut void* ctx) noexcept;
+} // namespace matrix_core::detail
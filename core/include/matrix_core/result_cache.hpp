@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "matrix_core/arena.hpp"
+#include "matrix_core/config.hpp"
+#include "matrix_core/error.hpp"
+#include "matrix_core/explanation.hpp"
+#include "matrix_core/matrix.hpp"
+
+namespace matrix_core {
+
+// what a cached result was computed from. op, tag and flags are host defined
+// (e.g. operation id, input slots, explanation detail); a and b are content
+// hashes of the inputs (see content_hash). the key only narrows the search:
+// an entry also keeps a copy of its input and a hit must match it
+struct ResultKey {
+		std::uint8_t op = 0;
+		std::uint8_t flags = 0;
+		std::uint16_t tag = 0;
+		std::uint64_t a = 0;
+		std::uint64_t b = 0;
+
+		bool operator==(const ResultKey& o) const noexcept {
+				return op == o.op && flags == o.flags && tag == o.tag && a == o.a && b == o.b;
+		}
+};
+
+// small LRU cache of op results and their explanations
+//
+// every entry owns one host provided block and an arena over it; a miss hands
+// out the least recently used entry, the op allocates its result and its
+// explanation context (opts.persist) from that entry's arena, and commit()
+// publishes them. begin() copies the input into the arena first, so a block
+// must also fit the largest input. the host adds blocks while memory is plentiful and calls
+// release() to give them all back when it runs low
+class ResultCache {
+	  public:
+		static constexpr std::uint8_t kMaxEntries = 4;
+
+		struct Entry {
+				ResultKey key{};
+				std::uint32_t stamp = 0; // 0 = empty
+				Arena arena{};
+				Explanation expl{};
+				const void* payload = nullptr;
+				MatrixView input{}; // in arena
+		};
+
+		// adds an entry backed by mem; Overflow once kMaxEntries are in use
+		ErrorCode add_block(InOut void* mem, In std::size_t bytes) noexcept;
+		std::uint8_t block_count() const noexcept { return count_; }
+
+		// forgets every entry and block; the host may then reuse the memory
+		void release() noexcept;
+
+		// the entry for key computed from input, or nullptr. a hit makes it the
+		// most recently used
+		const Entry* find(In const ResultKey& key, In MatrixView input) noexcept;
+
+		// the entry to fill for key: the least recently used one, emptied, with
+		// a copy of input in its arena. the arena stays valid until the next
+		// begin() or release(). nullptr without blocks or when input does not fit
+		Entry* begin(In const ResultKey& key, In MatrixView input) noexcept;
+
+		// publishes what begin() handed out; payload must live in entry->arena
+		void commit(InOut Entry* entry, In Explanation&& expl, In const void* payload) noexcept;
+
+		// empties every entry, keeping the blocks
+		void clear() noexcept;
+
+		std::size_t hits() const noexcept { return hits_; }
+		std::size_t misses() const noexcept { return misses_; }
+
+	  private:
+		Entry entries_[kMaxEntries]{};
+		std::uint8_t count_ = 0;
+		std::uint32_t clock_ = 0;
+		std::size_t hits_ = 0;
+		std::size_t misses_ = 0;
+};
+
+} // namespace matrix_core
@@ -20,7 +20,34 @@ struct RowOp {
 		Rational scalar = Rational::from_int(0);
 };
 
+// the rows op writes, a bit per row
+inline std::uint32_t row_op_rows(const RowOp& op) noexcept {
+		std::uint32_t rows = 1u << op.target_row;
+		if (op.kind == RowOpKind::Swap)
+				rows |= 1u << op.source_row;
+		return rows;
+}
+
+// the row ops an elimination spends on one pivot: everything done for pivot
+// column col with its pivot in row, or (col == kScaleGroup) one pass scaling
+// every pivot row. a group is one step of an ExplainDetail::Compact
+// explanation
+struct OpGroup {
+		std::uint8_t row = 0;
+		std::uint8_t col = 0;
+		std::size_t ops = 0;
+};
+
+constexpr std::uint8_t kScaleGroup = 0xFF;
+
 // human readable caption for a RowOp (1 based row indices)
 ErrorCode row_op_caption(In const RowOp& op, Out char* out, In std::size_t cap) noexcept;
 
+// caption for a symmetric (congruence) AddMul: the row op followed by the
+// same op on columns, R_i <- R_i + k R_j, C_i <- C_i + k C_j
+ErrorCode congruence_op_caption(In const RowOp& op, Out char* out, In std::size_t cap) noexcept;
+
+// caption for an OpGroup, e.g. "Pivot $R_{2}$, clear $C_{3}$ (2 ops)"
+ErrorCode op_group_caption(In const OpGroup& g, Out char* out, In std::size_t cap) noexcept;
+
 } // namespace matrix_core
@@ -55,18 +55,67 @@ struct OpObserver {
 		std::size_t count = 0;
 		RowOp last_op{};
 		bool has_last = false;
+		// ops this call may still apply; echelon_resume returns Pending
+		// once it reaches 0 (at once when it starts there). -1 is unlimited
+		// and never counted down, and the countdown stops at 0
+		std::size_t budget = static_cast<std::size_t>(-1);
+		// OpGroups finished, and the 1 based one to stop after
+		std::size_t group_target = static_cast<std::size_t>(-1);
+		std::size_t groups = 0;
+		OpGroup last_group{};
+		std::size_t group_mark = 0; // count when the previous group ended
 
 		bool on_op(const RowOp& op) noexcept {
 				count++;
 				last_op = op;
 				has_last = true;
+				if (budget != 0 && budget != static_cast<std::size_t>(-1))
+						budget--;
 				return count != target;
 		}
+
+		// drivers call this when they are done with a pivot; a pivot that
+		// needed no ops is not a group
+		bool on_group(std::uint8_t row, std::uint8_t col) noexcept {
+				if (count == group_mark)
+						return true;
+				groups++;
+				last_group = OpGroup{row, col, count - group_mark};
+				group_mark = count;
+				return groups != group_target;
+		}
+
+		// a driver returned early because on_op or on_group asked it to
+		bool stopped() const noexcept { return count == target || groups == group_target; }
+
+		// an explanation step is one op, or with by_group one OpGroup
+		void stop_after_step(std::size_t step, bool by_group) noexcept { (by_group ? group_target : target) = step; }
+		std::size_t steps(bool by_group) const noexcept { return by_group ? groups : count; }
+		ErrorCode step_caption(bool by_group, char* out, std::size_t cap) const noexcept {
+				return by_group ? op_group_caption(last_group, out, cap) : row_op_caption(last_op, out, cap);
+		}
 	};
 
+// where a resumable echelon stopped; a value initialized cursor starts over
+struct EchelonCursor {
+		std::uint8_t pivot_row = 0;
+		std::uint8_t pivot_col = 0;
+		std::uint8_t row = 0;   // next row to clear in pivot_col
+		std::uint8_t phase = 0; // 0: find and swap the pivot, 1: scale it, 2: clear the column
+		bool done = false;
+};
+
 // Applies row reduction in-place, optionally reporting row operations via `obs`.
 //
 // Note: `obs->target` is 1-based: stop after applying exactly `target` ops.
 ErrorCode echelon_apply(MatrixMutView m, EchelonKind kind, OpObserver* obs) noexcept;
 
+// echelon_apply of [left | right] held as two blocks: pivots come from left's
+// columns only, and every row operation is applied to both
+ErrorCode echelon_apply_split(MatrixMutView left, MatrixMutView right, EchelonKind kind, OpObserver* obs) noexcept;
+
+// echelon_apply_split from *cur on: returns Pending, with *cur saved, once
+// obs->budget runs out; the next call with the same cursor picks up from there
+ErrorCode echelon_resume(MatrixMutView left, MatrixMutView right, EchelonKind kind, EchelonCursor* cur, OpObserver* obs) noexcept;
+
 } // namespace matrix_core
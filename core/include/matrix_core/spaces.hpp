@@ -40,5 +40,58 @@ ErrorCode space_row_basis(In MatrixView rref, In std::uint8_t var_cols, In const
 // construct a basis for Null(A) from RREF(A)
 ErrorCode space_null_basis(In MatrixView rref, In std::uint8_t var_cols, In const SpaceInfo& info, InOut Arena& arena, Out MatrixMutView* out_basis) noexcept;
 
+// what one RREF of [A | I] leaves behind, E A = R with R = RREF(A)
+//
+// reduced is m x max(n, m): rows [0, rank) are the nonzero rows of R (n
+// wide), rows [rank, m) the matching rows of E (m wide), which span Null(A^T).
+// that is all the four bases need: Col(A) reads A's pivot columns, Row(A)
+// and Null(A) read R (var_cols = n), Null(A^T) reads E
+struct FundamentalSpaces {
+		SpaceInfo info{};
+		Dim a{};
+		std::size_t op_count = 0; // row operations of the RREF
+		MatrixView reduced{};
+};
+
+// reduced is allocated from arena, the [A | I] work space comes and goes
+// above it
+ErrorCode space_factor(In MatrixView a, InOut Arena& arena, Out FundamentalSpaces* out) noexcept;
+
+// basis for Null(A^T) as columns, or a single zero vector when rank == m
+ErrorCode space_left_null_basis(In const FundamentalSpaces& spaces, InOut Arena& arena, Out MatrixMutView* out_basis) noexcept;
+
+// small LRU of space_factor results keyed on matrix contents and confirmed
+// against a copy of the reduced matrix, like LuCache, so moving between the
+// four subspaces of one slot reduces it only once
+class SpacesCache {
+	  public:
+		ErrorCode init(InOut Arena& arena, In std::uint8_t capacity) noexcept;
+
+		// the pointer stays valid until the next get() miss; scratch holds the
+		// elimination on a miss
+		ErrorCode get(In MatrixView a, InOut Arena& scratch, Out const FundamentalSpaces** out) noexcept;
+
+		void clear() noexcept;
+
+		std::uint8_t capacity() const noexcept { return capacity_; }
+		std::size_t hits() const noexcept { return hits_; }
+		std::size_t misses() const noexcept { return misses_; }
+
+	  private:
+		struct Entry {
+				std::uint64_t hash = 0;
+				std::uint32_t stamp = 0; // 0 = empty
+				Rational* storage = nullptr;
+				Rational* input = nullptr; // the reduced matrix
+				FundamentalSpaces spaces;
+		};
+
+		Entry* entries_ = nullptr;
+		std::uint8_t capacity_ = 0;
+		std::uint32_t clock_ = 0;
+		std::size_t hits_ = 0;
+		std::size_t misses_ = 0;
+};
+
 } // namespace matrix_core
 
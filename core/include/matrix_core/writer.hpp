@@ -4,87 +4,206 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
 #include "matrix_core/error.hpp"
 #include "matrix_core/rational.hpp"
 
 namespace matrix_core {
 
+namespace detail {
+// "00" "01" ... "99", two digits per lookup
+inline constexpr char kDigitPairs[] = "00010203040506070809"
+                                      "10111213141516171819"
+                                      "20212223242526272829"
+                                      "30313233343536373839"
+                                      "40414243444546474849"
+                                      "50515253545556575859"
+                                      "60616263646566676869"
+                                      "70717273747576777879"
+                                      "80818283848586878889"
+                                      "90919293949596979899";
+
+// writes v in decimal so that it ends just before end; returns its first char.
+// 64 bit divisions only while v needs them, two digits per division
+inline char* format_u64_back(std::uint64_t v, char* end) noexcept {
+		char* p = end;
+		while (v > 0xFFFFFFFFu) {
+				const std::uint64_t q = v / 100u;
+				const std::size_t pair = static_cast<std::size_t>(v - q * 100u) * 2u;
+				*--p = kDigitPairs[pair + 1];
+				*--p = kDigitPairs[pair];
+				v = q;
+		}
+		std::uint32_t u = static_cast<std::uint32_t>(v);
+		while (u >= 100u) {
+				const std::uint32_t q = u / 100u;
+				const std::size_t pair = static_cast<std::size_t>(u - q * 100u) * 2u;
+				*--p = kDigitPairs[pair + 1];
+				*--p = kDigitPairs[pair];
+				u = q;
+		}
+		if (u >= 10u) {
+				*--p = kDigitPairs[u * 2u + 1u];
+				*--p = kDigitPairs[u * 2u];
+		} else {
+				*--p = static_cast<char>('0' + u);
+		}
+		return p;
+}
+
+// |v|, INT64_MIN included
+inline std::uint64_t magnitude(std::int64_t v) noexcept {
+		return (v < 0) ? (static_cast<std::uint64_t>(-(v + 1)) + 1u) : static_cast<std::uint64_t>(v);
+}
+
+// v in decimal ending just before end, with its sign
+inline char* format_i64_back(std::int64_t v, char* end) noexcept {
+		char* p = format_u64_back(magnitude(v), end);
+		if (v < 0)
+				*--p = '-';
+		return p;
+}
+} // namespace detail
+
+// where a Writer with a sink sends what it holds each time its buffer fills
+// up and on flush(), instead of failing with BufferTooSmall
+struct WriterSink {
+		void* ctx = nullptr;
+		ErrorCode (*write)(void* ctx, const char* data, std::size_t n) noexcept = nullptr;
+};
+
 // string builder helper that writes to a fixed capacity buffer
 // all operations are noexcept and return ErrorCode on overflow
+//
+// a counter() writes nothing and never overflows; len ends up the length a
+// real write would have (the terminator not included)
+//
+// with defer_terminator set, writes leave data unterminated (room for the
+// terminator is still kept) until terminate(); a writer doing many small
+// appends sets it and terminates once
+//
+// with a sink the buffer is only a chunk: whatever is left in it at the end
+// is the caller's to pass on (or flush())
 struct Writer {
 		char* data = nullptr;
 		std::size_t cap = 0;
 		std::size_t len = 0;
+		bool counting = false;
+		bool defer_terminator = false;
+		const WriterSink* sink = nullptr;
+
+		static Writer counter() noexcept {
+				Writer w;
+				w.counting = true;
+				return w;
+		}
 
 		ErrorCode put(char ch) noexcept {
-				if (!data || cap == 0)
-						return ErrorCode::BufferTooSmall;
-				if (len + 1 >= cap)
-						return ErrorCode::BufferTooSmall;
+				if (counting) {
+						len++;
+						return ErrorCode::Ok;
+				}
+				if (!data || len + 1 >= cap) {
+						if (!can_flush())
+								return ErrorCode::BufferTooSmall;
+						const ErrorCode ec = flush();
+						if (!is_ok(ec))
+								return ec;
+				}
 				data[len++] = ch;
-				data[len] = '\0';
+				if (!defer_terminator)
+						data[len] = '\0';
 				return ErrorCode::Ok;
 		}
 
-		ErrorCode append(const char* s) noexcept {
+		// the n bytes at s in one copy; nothing is written when they do not fit
+		ErrorCode append(const char* s, std::size_t n) noexcept {
 				if (!s)
 						return ErrorCode::Internal;
-				for (std::size_t i = 0; s[i] != '\0'; i++) {
-						ErrorCode ec = put(s[i]);
+				if (counting) {
+						len += n;
+						return ErrorCode::Ok;
+				}
+				if (n == 0)
+						return ErrorCode::Ok;
+				if (!data || len + n >= cap) {
+						if (!can_flush())
+								return ErrorCode::BufferTooSmall;
+						const ErrorCode ec = flush();
 						if (!is_ok(ec))
 								return ec;
+						// more than a chunk goes straight through
+						if (n >= cap)
+								return sink->write(sink->ctx, s, n);
 				}
+				std::memcpy(data + len, s, n);
+				len += n;
+				if (!defer_terminator)
+						data[len] = '\0';
 				return ErrorCode::Ok;
 		}
 
+		// literals fold to a constant length once inlined
+		ErrorCode append(const char* s) noexcept {
+				if (!s)
+						return ErrorCode::Internal;
+				return append(s, std::strlen(s));
+		}
+
+		// hands what the buffer holds to the sink; nothing to do without one
+		ErrorCode flush() noexcept {
+				if (!sink || counting || len == 0)
+						return ErrorCode::Ok;
+				const ErrorCode ec = sink->write(sink->ctx, data, len);
+				len = 0;
+				data[0] = '\0';
+				return ec;
+		}
+
+		bool can_flush() const noexcept { return sink && sink->write && data && cap >= 2; }
+
+		// ends what was written so far, see defer_terminator
+		void terminate() noexcept {
+				if (!counting && data && len < cap)
+						data[len] = '\0';
+		}
+
 		ErrorCode append_u64(std::uint64_t v) noexcept {
-				char buf[32];
-				std::size_t n = 0;
-				do {
-						buf[n++] = static_cast<char>('0' + (v % 10u));
-						v /= 10u;
-				} while (v != 0u);
-
-				for (std::size_t i = 0; i < n; i++) {
-						ErrorCode ec = put(buf[n - 1 - i]);
-						if (!is_ok(ec))
-								return ec;
-				}
-				return ErrorCode::Ok;
+				char buf[20];
+				char* end = buf + sizeof(buf);
+				const char* p = detail::format_u64_back(v, end);
+				return append(p, static_cast<std::size_t>(end - p));
 		}
 
 		ErrorCode append_i64(std::int64_t v) noexcept {
-				std::uint64_t mag = (v < 0) ? (static_cast<std::uint64_t>(-(v + 1)) + 1u) : static_cast<std::uint64_t>(v);
-				if (v < 0) {
-						ErrorCode ec = put('-');
-						if (!is_ok(ec))
-								return ec;
-				}
-				return append_u64(mag);
+				char buf[20];
+				char* end = buf + sizeof(buf);
+				const char* p = detail::format_i64_back(v, end);
+				return append(p, static_cast<std::size_t>(end - p));
 		}
 
 		// append a 1 based index (v+1) as decimal
 		ErrorCode append_index1(std::uint8_t v) noexcept { return append_u64(static_cast<std::uint64_t>(v) + 1u); }
 
-		// append a rational as LaTeX (either integer or \frac{num}{den})
+		// append a rational as LaTeX (either integer or \frac{num}{den}), built
+		// back to front in one buffer and appended at once
 		ErrorCode append_rational_latex(const Rational& r) noexcept {
 				if (r.den() == 1)
 						return append_i64(r.num());
 
-				ErrorCode ec = append("\\frac{");
-				if (!is_ok(ec))
-						return ec;
-				ec = append_i64(r.num());
-				if (!is_ok(ec))
-						return ec;
-				ec = append("}{");
-				if (!is_ok(ec))
-						return ec;
-				ec = append_i64(r.den());
-				if (!is_ok(ec))
-						return ec;
-				return append("}");
+				// \frac{ -9223372036854775808 }{ 9223372036854775807 }
+				char buf[48];
+				char* end = buf + sizeof(buf);
+				char* p = end;
+				*--p = '}';
+				p = detail::format_i64_back(r.den(), p);
+				*--p = '{';
+				*--p = '}';
+				p = detail::format_i64_back(r.num(), p);
+				p -= 6;
+				std::memcpy(p, "\\frac{", 6);
+				return append(p, static_cast<std::size_t>(end - p));
 		}
 };
 
@@ -95,6 +214,7 @@ struct CheckedWriter final {
 
 		void put(char ch) noexcept { check(w.put(ch)); }
 		void append(const char* s) noexcept { check(w.append(s)); }
+		void append(const char* s, std::size_t n) noexcept { check(w.append(s, n)); }
 		void append_u64(std::uint64_t v) noexcept { check(w.append_u64(v)); }
 		void append_i64(std::int64_t v) noexcept { check(w.append_i64(v)); }
 		void append_index1(std::uint8_t v) noexcept { check(w.append_index1(v)); }
@@ -0,0 +1,78 @@
+// host-side timing of op_cramer_solve on a dense 6x6 system
+//
+// usage: matrix_profile_cramer [iterations]
+
+#include "matrix_core/matrix_core.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using matrix_core::Arena;
+using matrix_core::ErrorCode;
+using matrix_core::MatrixMutView;
+using matrix_core::Rational;
+using matrix_core::Slab;
+
+int main(int argc, char** argv) {
+		const long iterations = (argc > 1) ? std::strtol(argv[1], nullptr, 10) : 2000;
+		if (iterations <= 0) {
+				std::fprintf(stderr, "iterations must be positive\n");
+				return 1;
+		}
+
+		Slab slab;
+		if (!matrix_core::is_ok(slab.init(64 * 1024)))
+				return 1;
+		Arena persist(slab.data(), slab.size() / 2);
+		Arena scratch(slab.data() + (slab.size() / 2), slab.size() - (slab.size() / 2));
+
+		// nonsymmetric, needs a row swap, x = (1, -1, 2, 0, 3, -2)
+		constexpr std::uint8_t n = 6;
+		const std::int64_t avals[n][n] = {
+		        {0, 2, -1, 3, 1, 4},
+		        {5, 1, 0, -2, 3, 1},
+		        {2, -3, 4, 1, 0, 2},
+		        {1, 0, 2, 5, -1, 3},
+		        {-2, 4, 1, 0, 6, -1},
+		        {3, 1, -2, 4, 2, 7},
+		};
+		const std::int64_t xvals[n] = {1, -1, 2, 0, 3, -2};
+
+		MatrixMutView a;
+		MatrixMutView b;
+		MatrixMutView x;
+		if (!matrix_core::is_ok(matrix_core::matrix_alloc(persist, n, n, &a)) ||
+		        !matrix_core::is_ok(matrix_core::matrix_alloc(persist, n, 1, &b)) ||
+		        !matrix_core::is_ok(matrix_core::matrix_alloc(persist, n, 1, &x)))
+				return 1;
+		for (std::uint8_t r = 0; r < n; r++) {
+				std::int64_t acc = 0;
+				for (std::uint8_t c = 0; c < n; c++) {
+						a.at_mut(r, c) = Rational::from_int(avals[r][c]);
+						acc += avals[r][c] * xvals[c];
+				}
+				b.at_mut(r, 0) = Rational::from_int(acc);
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		for (long i = 0; i < iterations; i++) {
+				const matrix_core::Error err = matrix_core::op_cramer_solve(a.view(), b.view(), scratch, x);
+				if (!matrix_core::is_ok(err)) {
+						std::fprintf(stderr, "op_cramer_solve failed ec=%u\n", static_cast<unsigned>(err.code));
+						return 1;
+				}
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+
+		for (std::uint8_t r = 0; r < n; r++) {
+				if (x.at(r, 0).num() != xvals[r] || x.at(r, 0).den() != 1) {
+						std::fprintf(stderr, "wrong x_%u\n", static_cast<unsigned>(r + 1));
+						return 1;
+				}
+		}
+
+		const double us = std::chrono::duration<double, std::micro>(elapsed).count();
+		std::printf("op_cramer_solve 6x6: %ld iterations, %.2f us/solve\n", iterations, us / static_cast<double>(iterations));
+		return 0;
+}
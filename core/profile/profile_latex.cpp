@@ -0,0 +1,68 @@
+// host-side throughput of the LaTeX writers on a 6x6 of fractions and the
+// row operation captions of its steps
+//
+// usage: matrix_profile_latex [iterations]
+
+#include "matrix_core/matrix_core.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using matrix_core::ErrorCode;
+using matrix_core::MatrixView;
+using matrix_core::Rational;
+using matrix_core::RowOp;
+using matrix_core::RowOpKind;
+
+int main(int argc, char** argv) {
+		const long iterations = (argc > 1) ? std::strtol(argv[1], nullptr, 10) : 20000;
+		if (iterations <= 0) {
+				std::fprintf(stderr, "iterations must be positive\n");
+				return 1;
+		}
+
+		// entries like an inverse mid elimination: mixed signs, 1 to 6 digit terms
+		constexpr std::uint8_t n = 6;
+		Rational entries[n * n];
+		for (std::uint8_t i = 0; i < n * n; i++) {
+				const std::int64_t num = (i % 3 == 0) ? -(1 + i * 7919) : 1 + i * 31;
+				const std::int64_t den = (i % 4 == 0) ? 1 : 2 + i * 13;
+				if (!matrix_core::is_ok(Rational::make(num, den, &entries[i])))
+						return 1;
+		}
+		const MatrixView m{n, n, n, entries};
+		const MatrixView left = m.columns(0, 3);
+		const MatrixView right = m.columns(3, 3);
+
+		RowOp ops[3];
+		ops[0] = RowOp{RowOpKind::Swap, 1, 4, Rational::from_int(0)};
+		ops[1] = RowOp{RowOpKind::Scale, 2, 2, entries[7]};
+		ops[2] = RowOp{RowOpKind::AddMul, 5, 0, entries[11]};
+
+		char latex[2048];
+		char caption[128];
+		std::size_t bytes = 0;
+
+		const auto start = std::chrono::steady_clock::now();
+		for (long i = 0; i < iterations; i++) {
+				ErrorCode ec =
+				        matrix_core::latex::write_matrix_display(m, matrix_core::latex::MatrixBrackets::BMatrix, {latex, sizeof(latex)});
+				if (matrix_core::is_ok(ec))
+						ec = matrix_core::latex::write_augmented_matrix_display(left, right, {latex, sizeof(latex)});
+				if (matrix_core::is_ok(ec))
+						ec = matrix_core::row_op_caption(ops[i % 3], caption, sizeof(caption));
+				if (!matrix_core::is_ok(ec)) {
+						std::fprintf(stderr, "write failed ec=%u\n", static_cast<unsigned>(ec));
+						return 1;
+				}
+				bytes += std::strlen(latex) * 2 + std::strlen(caption);
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+
+		const double us = std::chrono::duration<double, std::micro>(elapsed).count();
+		std::printf("latex 6x6 display + augmented + caption: %ld iterations, %.2f us/iteration, %.1f MB/s\n", iterations,
+		            us / static_cast<double>(iterations), static_cast<double>(bytes) / us);
+		return 0;
+}
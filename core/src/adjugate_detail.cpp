@@ -0,0 +1,279 @@
+#include "matrix_core/adjugate_detail.hpp"
+
+#include "matrix_core/lu.hpp"
+#include "matrix_core/parallel.hpp"
+#include "matrix_core/row_reduction.hpp"
+
+namespace matrix_core::detail {
+namespace {
+
+// m_ij = (m_kk m_ij - m_ik m_kj) / prev, the one Bareiss update
+ErrorCode bareiss_entry(const Rational& pivot, const Rational& mij, const Rational& mik, const Rational& mkj, const Rational& prev,
+                        Rational* out) noexcept {
+		Rational t;
+		ErrorCode ec = rational_mul(pivot, mij, &t);
+		if (!is_ok(ec))
+				return ec;
+		if (!mik.is_zero() && !mkj.is_zero()) {
+				Rational u;
+				ec = rational_mul(mik, mkj, &u);
+				if (!is_ok(ec))
+						return ec;
+				ec = rational_sub(t, u, &t);
+				if (!is_ok(ec))
+						return ec;
+		}
+		return rational_div(t, prev, out);
+}
+
+// Bareiss steps first.. on m, prev the pivot of step first - 1
+ErrorCode bareiss_from(MatrixMutView m, std::uint8_t first, Rational prev, bool negate, Rational* out) noexcept {
+		const std::uint8_t n = m.rows;
+		for (std::uint8_t k = first; k + 1 < n; k++) {
+				if (m.at(k, k).is_zero()) {
+						std::uint8_t pivot = k;
+						for (std::uint8_t row = static_cast<std::uint8_t>(k + 1); row < n; row++) {
+								if (!m.at(row, k).is_zero()) {
+										pivot = row;
+										break;
+								}
+						}
+						if (pivot == k) {
+								*out = Rational::from_int(0);
+								return ErrorCode::Ok;
+						}
+						apply_swap(m, k, pivot);
+						negate = !negate;
+				}
+
+				const Rational pivot_val = m.at(k, k);
+				for (std::uint8_t i = static_cast<std::uint8_t>(k + 1); i < n; i++) {
+						const Rational below = m.at(i, k);
+						for (std::uint8_t j = static_cast<std::uint8_t>(k + 1); j < n; j++) {
+								ErrorCode ec = bareiss_entry(pivot_val, m.at(i, j), below, m.at(k, j), prev, &m.at_mut(i, j));
+								if (!is_ok(ec))
+										return ec;
+						}
+				}
+				prev = pivot_val;
+		}
+
+		Rational det = m.at(n - 1, n - 1);
+		if (negate) {
+				ErrorCode ec = rational_neg(det, &det);
+				if (!is_ok(ec))
+						return ec;
+		}
+		*out = det;
+		return ErrorCode::Ok;
+}
+
+// bareiss_det of a minor without copying it first: step 0 reads the view
+// (a pivot swap only swaps its row map) and is the first write to work, so
+// row 0 and column 0 of work are never touched
+ErrorCode bareiss_minor_det(MinorView v, MatrixMutView work, Rational* out) noexcept {
+		const std::uint8_t n = v.rows;
+		if (n == 1) {
+				*out = v.at(0, 0);
+				return ErrorCode::Ok;
+		}
+
+		bool negate = false;
+		if (v.at(0, 0).is_zero()) {
+				std::uint8_t pivot = 0;
+				for (std::uint8_t row = 1; row < n; row++) {
+						if (!v.at(row, 0).is_zero()) {
+								pivot = row;
+								break;
+						}
+				}
+				if (pivot == 0) {
+						*out = Rational::from_int(0);
+						return ErrorCode::Ok;
+				}
+				const std::uint8_t t = v.row_map[0];
+				v.row_map[0] = v.row_map[pivot];
+				v.row_map[pivot] = t;
+				negate = true;
+		}
+
+		const Rational pivot_val = v.at(0, 0);
+		const Rational one = Rational::from_int(1);
+		for (std::uint8_t i = 1; i < n; i++) {
+				const Rational& below = v.at(i, 0);
+				for (std::uint8_t j = 1; j < n; j++) {
+						ErrorCode ec = bareiss_entry(pivot_val, v.at(i, j), below, v.at(0, j), one, &work.at_mut(i, j));
+						if (!is_ok(ec))
+								return ec;
+				}
+		}
+		return bareiss_from(work, 1, pivot_val, negate, out);
+}
+
+// (-1)^{i+j} M_ij, work the (n-1) x (n-1) elimination buffer
+ErrorCode signed_minor(MatrixView a, std::uint8_t i, std::uint8_t j, MatrixMutView work, Rational* out) noexcept {
+		MinorView v;
+		ErrorCode ec = minor_view(a, i, j, &v);
+		if (!is_ok(ec))
+				return ec;
+		ec = bareiss_minor_det(v, work, out);
+		if (!is_ok(ec))
+				return ec;
+		if (((i + j) & 1u) != 0u)
+				return rational_neg(*out, out);
+		return ErrorCode::Ok;
+}
+
+struct MinorGridTasks {
+		MatrixView a{};
+		MatrixMutView work[kMaxRows];
+		MatrixMutView out{};
+		ErrorCode ec[kMaxRows] = {};
+};
+
+// row i of the cofactor grid, i.e. column i of adj(A)
+void minor_grid_task(void* vctx, std::uint8_t i) noexcept {
+		auto* t = static_cast<MinorGridTasks*>(vctx);
+		for (std::uint8_t j = 0; j < t->a.cols; j++) {
+				t->ec[i] = signed_minor(t->a, i, j, t->work[i], &t->out.at_mut(j, i));
+				if (!is_ok(t->ec[i]))
+						return;
+		}
+}
+
+ErrorCode adjugate_from_minors(MatrixView a, Arena& scratch, MatrixMutView out) noexcept {
+		// each row of the grid gets its own work matrix so the rows are independent
+		const std::uint8_t m = static_cast<std::uint8_t>(a.rows - 1);
+		MinorGridTasks tasks;
+		tasks.a = a;
+		tasks.out = out;
+		for (std::uint8_t i = 0; i < a.rows; i++) {
+				ErrorCode ec = matrix_alloc(scratch, m, m, &tasks.work[i]);
+				if (!is_ok(ec))
+						return ec;
+		}
+		parallel_for(a.rows, &minor_grid_task, &tasks);
+
+		for (std::uint8_t i = 0; i < a.rows; i++) {
+				if (!is_ok(tasks.ec[i]))
+						return tasks.ec[i];
+		}
+		return ErrorCode::Ok;
+}
+
+// det(A) A^{-1}; Singular when the factor has no inverse
+ErrorCode adjugate_from_factor(MatrixView a, Arena& scratch, MatrixMutView out) noexcept {
+		LuFactor f;
+		ErrorCode ec = lu_factor(a, scratch, &f);
+		if (!is_ok(ec))
+				return ec;
+		if (f.singular)
+				return ErrorCode::Singular;
+
+		Rational det;
+		ec = lu_det(f, &det);
+		if (!is_ok(ec))
+				return ec;
+		ec = lu_inverse(f, out);
+		if (!is_ok(ec))
+				return ec;
+		for (std::uint8_t r = 0; r < out.rows; r++) {
+				for (std::uint8_t c = 0; c < out.cols; c++) {
+						ec = rational_mul(out.at(r, c), det, &out.at_mut(r, c));
+						if (!is_ok(ec))
+								return ec;
+				}
+		}
+		return ErrorCode::Ok;
+}
+
+} // namespace
+
+ErrorCode bareiss_det(MatrixMutView m, Rational* out) noexcept {
+		if (!out || !m.data)
+				return ErrorCode::Internal;
+		if (m.rows != m.cols)
+				return ErrorCode::NotSquare;
+
+		if (m.rows == 0) {
+				*out = Rational::from_int(1);
+				return ErrorCode::Ok;
+		}
+		return bareiss_from(m, 0, Rational::from_int(1), false, out);
+}
+
+ErrorCode adjugate(MatrixView a, Arena& scratch, MatrixMutView out) noexcept {
+		if (!a.data || !out.data)
+				return ErrorCode::Internal;
+		if (a.rows != a.cols)
+				return ErrorCode::NotSquare;
+		if (out.rows != a.rows || out.cols != a.cols)
+				return ErrorCode::DimensionMismatch;
+		if (a.rows == 0)
+				return ErrorCode::InvalidDimension;
+
+		if (a.rows == 1) {
+				out.at_mut(0, 0) = Rational::from_int(1);
+				return ErrorCode::Ok;
+		}
+
+		ErrorCode ec;
+		{
+				ArenaScope factor_scope(scratch);
+				ec = adjugate_from_factor(a, scratch, out);
+		}
+		if (ec != ErrorCode::Singular && ec != ErrorCode::Overflow)
+				return ec;
+
+		ArenaScope grid_scope(scratch);
+		return adjugate_from_minors(a, scratch, out);
+}
+
+ErrorCode cofactor(MatrixView a, std::uint8_t i, std::uint8_t j, Arena& scratch, Rational* out) noexcept {
+		if (!a.data || !out)
+				return ErrorCode::Internal;
+		if (a.rows != a.cols)
+				return ErrorCode::NotSquare;
+		if (i >= a.rows || j >= a.cols)
+				return ErrorCode::IndexOutOfRange;
+
+		if (a.rows == 1) {
+				*out = Rational::from_int(1);
+				return ErrorCode::Ok;
+		}
+
+		ArenaScope scratch_scope(scratch);
+		LuFactor f;
+		ErrorCode ec = lu_factor(a, scratch, &f);
+		if (is_ok(ec) && !f.singular) {
+				// C_ij = det(A) (A^{-1})_ji, column i of A^{-1} from one solve
+				MatrixMutView e;
+				MatrixMutView x;
+				ec = matrix_alloc(scratch, a.rows, 1, &e);
+				if (is_ok(ec))
+						ec = matrix_alloc(scratch, a.rows, 1, &x);
+				if (!is_ok(ec))
+						return ec;
+				for (std::uint8_t r = 0; r < a.rows; r++)
+						e.at_mut(r, 0) = Rational::from_int(r == i ? 1 : 0);
+
+				Rational det;
+				ec = lu_det(f, &det);
+				if (is_ok(ec))
+						ec = lu_solve(f, e.view(), x);
+				if (is_ok(ec))
+						ec = rational_mul(det, x.at(j, 0), out);
+				if (ec != ErrorCode::Overflow)
+						return ec;
+		} else if (!is_ok(ec) && ec != ErrorCode::Overflow) {
+				return ec;
+		}
+
+		MatrixMutView work;
+		ec = matrix_alloc(scratch, static_cast<std::uint8_t>(a.rows - 1), static_cast<std::uint8_t>(a.cols - 1), &work);
+		if (!is_ok(ec))
+				return ec;
+		return signed_minor(a, i, j, work, out);
+}
+
+} // namespace matrix_core::detail
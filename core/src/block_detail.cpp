@@ -0,0 +1,95 @@
+#include "matrix_core/block_detail.hpp"
+
+namespace matrix_core::detail {
+namespace {
+std::uint8_t find_root(std::uint8_t* parent, std::uint8_t i) noexcept {
+		while (parent[i] != i) {
+				parent[i] = parent[parent[i]];
+				i = parent[i];
+		}
+		return i;
+}
+} // namespace
+
+void block_partition(MatrixView a, BlockPartition* out) noexcept {
+		if (!out)
+				return;
+		*out = BlockPartition{};
+		if (!a.data || a.rows != a.cols || a.rows > kMaxRows)
+				return;
+
+		const std::uint8_t n = a.rows;
+		std::uint8_t parent[kMaxRows];
+		for (std::uint8_t i = 0; i < n; i++)
+				parent[i] = i;
+
+		for (std::uint8_t row = 0; row < n; row++) {
+				for (std::uint8_t col = static_cast<std::uint8_t>(row + 1); col < n; col++) {
+						if (a.at(row, col).is_zero() && a.at(col, row).is_zero())
+								continue;
+						const std::uint8_t r1 = find_root(parent, row);
+						const std::uint8_t r2 = find_root(parent, col);
+						if (r1 != r2)
+								parent[r1 < r2 ? r2 : r1] = r1 < r2 ? r1 : r2;
+				}
+		}
+
+		// roots are the smallest index of their component, so walking i in
+		// order visits blocks (and their members) in ascending order
+		out->n = n;
+		std::uint8_t pos = 0;
+		for (std::uint8_t root = 0; root < n; root++) {
+				if (find_root(parent, root) != root)
+						continue;
+				out->start[out->count++] = pos;
+				for (std::uint8_t i = root; i < n; i++) {
+						if (find_root(parent, i) == root)
+								out->perm[pos++] = i;
+				}
+		}
+		out->start[out->count] = pos;
+}
+
+ErrorCode block_gather(Arena& arena, MatrixView a, const BlockPartition& p, std::uint8_t b, MatrixMutView* out) noexcept {
+		if (!out || !a.data || b >= p.count)
+				return ErrorCode::Internal;
+		const std::uint8_t k = p.size(b);
+		const std::uint8_t* idx = p.perm + p.start[b];
+
+		MatrixMutView blk;
+		ErrorCode ec = matrix_alloc(arena, k, k, &blk);
+		if (!is_ok(ec))
+				return ec;
+		for (std::uint8_t row = 0; row < k; row++) {
+				for (std::uint8_t col = 0; col < k; col++)
+						blk.at_mut(row, col) = a.at(idx[row], idx[col]);
+		}
+		*out = blk;
+		return ErrorCode::Ok;
+}
+
+void block_scatter(MatrixView blk, const BlockPartition& p, std::uint8_t b, MatrixMutView dst) noexcept {
+		const std::uint8_t* idx = p.perm + p.start[b];
+		for (std::uint8_t row = 0; row < blk.rows; row++) {
+				for (std::uint8_t col = 0; col < blk.cols; col++)
+						dst.at_mut(idx[row], idx[col]) = blk.at(row, col);
+		}
+}
+
+ErrorCode block_permuted(Arena& arena, MatrixView a, const BlockPartition& p, MatrixMutView* out) noexcept {
+		if (!out || !a.data)
+				return ErrorCode::Internal;
+
+		MatrixMutView m;
+		ErrorCode ec = matrix_alloc(arena, p.n, p.n, &m);
+		if (!is_ok(ec))
+				return ec;
+		for (std::uint8_t row = 0; row < p.n; row++) {
+				for (std::uint8_t col = 0; col < p.n; col++)
+						m.at_mut(row, col) = a.at(p.perm[row], p.perm[col]);
+		}
+		*out = m;
+		return ErrorCode::Ok;
+}
+
+} // namespace matrix_core::detail
@@ -3,8 +3,11 @@
 #include "matrix_core/row_reduction.hpp"
 
 namespace matrix_core::detail {
-
-ErrorCode det_elim(MatrixMutView m, Rational* det_out, std::size_t* op_count, std::size_t stop_after, RowOp* last_op) noexcept {
+namespace {
+// det_elim to the end or until obs asks to stop, ops reported through obs
+// (which may be null); *done tells which, and det_out is set only when done
+ErrorCode det_elim_run(MatrixMutView m, OpObserver* obs, Rational* det_out, bool* done) noexcept {
+		*done = false;
 		if (!det_out || !m.data)
 				return ErrorCode::Internal;
 		if (m.rows != m.cols)
@@ -12,10 +15,6 @@ ErrorCode det_elim(MatrixMutView m, Rational* det_out, std::size_t* op_count, st
 
 		const std::uint8_t n = m.rows;
 		std::int32_t sign = 1;
-		std::size_t ops = 0;
-		RowOp last{};
-		bool have_last = false;
-
 		for (std::uint8_t col = 0; col < n; col++) {
 				// find pivot row
 				std::uint8_t pivot = col;
@@ -28,9 +27,8 @@ ErrorCode det_elim(MatrixMutView m, Rational* det_out, std::size_t* op_count, st
 						}
 				}
 				if (!found) {
+						*done = true;
 						*det_out = Rational::from_int(0);
-						if (op_count)
-								*op_count = ops;
 						return ErrorCode::Ok;
 				}
 
@@ -38,18 +36,17 @@ ErrorCode det_elim(MatrixMutView m, Rational* det_out, std::size_t* op_count, st
 						apply_swap(m, col, pivot);
 						sign = -sign;
 
-						ops++;
-						last.kind = RowOpKind::Swap;
-						last.target_row = col;
-						last.source_row = pivot;
-						have_last = true;
-						if (ops == stop_after)
-								break;
+						RowOp op;
+						op.kind = RowOpKind::Swap;
+						op.target_row = col;
+						op.source_row = pivot;
+						if (obs && !obs->on_op(op))
+								return ErrorCode::Ok;
 				}
 
-				Rational pivot_val = m.at(col, col);
+				const Rational pivot_val = m.at(col, col);
 				for (std::uint8_t row = col + 1; row < n; row++) {
-						Rational below = m.at(row, col);
+						const Rational below = m.at(row, col);
 						if (below.is_zero())
 								continue;
 
@@ -65,29 +62,18 @@ ErrorCode det_elim(MatrixMutView m, Rational* det_out, std::size_t* op_count, st
 						if (!is_ok(ec))
 								return ec;
 
-						ops++;
-						last.kind = RowOpKind::AddMul;
-						last.target_row = row;
-						last.source_row = col;
-						last.scalar = factor;
-						have_last = true;
-						if (ops == stop_after)
-								break;
+						RowOp op;
+						op.kind = RowOpKind::AddMul;
+						op.target_row = row;
+						op.source_row = col;
+						op.scalar = factor;
+						if (obs && !obs->on_op(op))
+								return ErrorCode::Ok;
 				}
-				if (ops == stop_after)
-						break;
-		}
-
-		if (op_count)
-				*op_count = ops;
-		if (last_op && have_last)
-				*last_op = last;
-
-		// if we stopped early, det isnt requested/meaningful
-		if (ops == stop_after) {
-				*det_out = Rational::from_int(0);
-				return ErrorCode::Ok;
+				if (obs && !obs->on_group(col, col))
+						return ErrorCode::Ok;
 		}
+		*done = true;
 
 		Rational det = Rational::from_int(sign);
 		for (std::uint8_t i = 0; i < n; i++) {
@@ -100,5 +86,47 @@ ErrorCode det_elim(MatrixMutView m, Rational* det_out, std::size_t* op_count, st
 		*det_out = det;
 		return ErrorCode::Ok;
 }
+} // namespace
+
+ErrorCode det_elim(MatrixMutView m, Rational* det_out, std::size_t* op_count, std::size_t stop_after, RowOp* last_op) noexcept {
+		OpObserver obs;
+		obs.target = stop_after;
+		bool done = false;
+		const ErrorCode ec = det_elim_run(m, &obs, det_out, &done);
+		if (!is_ok(ec))
+				return ec;
+
+		if (op_count)
+				*op_count = obs.count;
+		if (last_op && obs.has_last)
+				*last_op = obs.last_op;
+		// if we stopped early, det isnt requested/meaningful
+		if (!done)
+				*det_out = Rational::from_int(0);
+		return ErrorCode::Ok;
+}
+
+ErrorCode det_elim_observed(MatrixMutView m, Rational* det_out, OpObserver* obs) noexcept {
+		bool done = false;
+		const ErrorCode ec = det_elim_run(m, obs, det_out, &done);
+		if (is_ok(ec) && !done)
+				*det_out = Rational::from_int(0);
+		return ec;
+}
+
+ErrorCode det_elim_step(MatrixMutView m, std::size_t step, bool by_group, char* caption, std::size_t caption_cap) noexcept {
+		OpObserver obs;
+		obs.stop_after_step(step, by_group);
+		Rational ignored;
+		bool done = false;
+		ErrorCode ec = det_elim_run(m, &obs, &ignored, &done);
+		if (!is_ok(ec))
+				return ec;
+		if (obs.steps(by_group) < step)
+				return ErrorCode::StepOutOfRange;
+		if (caption)
+				return obs.step_caption(by_group, caption, caption_cap);
+		return ErrorCode::Ok;
+}
 
 } // namespace matrix_core::detail
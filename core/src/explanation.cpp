@@ -1,11 +1,49 @@
 #include "matrix_core/explanation.hpp"
 
+#include <cstring>
+#include <new>
 #include <utility>
 
 namespace matrix_core {
+namespace {
+struct LazyCtx {
+		ExplanationBuilder build = nullptr;
+		const void* recipe = nullptr;
+		std::size_t build_bytes = 0;
+};
+
+// nothing to show until Explanation::build makes the real explanation
+std::size_t lazy_step_count(const void*) noexcept {
+		return 0;
+}
+
+ErrorCode lazy_render_step(const void*, std::size_t, const StepRenderBuffers&) noexcept {
+		return ErrorCode::Internal;
+}
+
+constexpr ExplanationVTable kLazyVTable = {
+        .step_count = &lazy_step_count,
+        .render_step = &lazy_render_step,
+        .destroy = nullptr,
+};
+
+// the last id Explanation::make handed out
+std::uint32_t next_id = 0;
+
+// step_latex_size's chunk buffer, on the stack
+constexpr std::size_t kSizeChunkBytes = 32;
+
+ErrorCode count_chunk(void* ctx, const char*, std::size_t n) noexcept {
+		*static_cast<std::size_t*>(ctx) += n;
+		return ErrorCode::Ok;
+}
+} // namespace
+
 Explanation::Explanation(Explanation&& other) noexcept {
 		ctx_ = other.ctx_;
 		vtable_ = other.vtable_;
+		id_ = other.id_;
+		owned_ = other.owned_;
 		other.ctx_ = nullptr;
 		other.vtable_ = nullptr;
 }
@@ -13,17 +51,19 @@ Explanation::Explanation(Explanation&& other) noexcept {
 Explanation& Explanation::operator=(Explanation&& other) noexcept {
 		if (this == &other)
 				return *this;
-		if (vtable_ && ctx_ && vtable_->destroy)
+		if (owned_ && vtable_ && ctx_ && vtable_->destroy)
 				vtable_->destroy(ctx_);
 		ctx_ = other.ctx_;
 		vtable_ = other.vtable_;
+		id_ = other.id_;
+		owned_ = other.owned_;
 		other.ctx_ = nullptr;
 		other.vtable_ = nullptr;
 		return *this;
 }
 
 Explanation::~Explanation() {
-		if (vtable_ && ctx_ && vtable_->destroy)
+		if (owned_ && vtable_ && ctx_ && vtable_->destroy)
 				vtable_->destroy(ctx_);
 		ctx_ = nullptr;
 		vtable_ = nullptr;
@@ -38,18 +78,239 @@ std::size_t Explanation::step_count() const noexcept {
 ErrorCode Explanation::render_step(std::size_t index, const StepRenderBuffers& out) const noexcept {
 		if (!available())
 				return ErrorCode::Internal;
+		if (out.cache && out.cache->find(id_, index, out))
+				return ErrorCode::Ok;
+		return render_uncached(index, out);
+}
+
+ErrorCode Explanation::render_uncached(std::size_t index, const StepRenderBuffers& out) const noexcept {
+		ErrorCode ec;
 		if (out.scratch) {
 				ArenaScratchScope scope(*out.scratch);
-				return vtable_->render_step(ctx_, index, out);
+				ec = vtable_->render_step(ctx_, index, out);
+		} else {
+				ec = vtable_->render_step(ctx_, index, out);
 		}
-		return vtable_->render_step(ctx_, index, out);
+		if (is_ok(ec) && out.cache)
+				out.cache->keep(id_, index, out);
+		return ec;
+}
+
+ErrorCode Explanation::render_document(std::size_t index, const StepRenderBuffers& out, StepDocument* doc) const noexcept {
+		if (!doc || !doc->data || doc->caption_cap == 0)
+				return ErrorCode::Internal;
+		doc->text = nullptr;
+		if (doc->cap <= doc->caption_cap + 1)
+				return ErrorCode::BufferTooSmall;
+
+		StepRenderBuffers in_place = out;
+		in_place.caption = doc->data;
+		in_place.caption_cap = doc->caption_cap;
+		in_place.latex = doc->data + doc->caption_cap + 1;
+		in_place.latex_cap = doc->cap - doc->caption_cap - 1;
+		in_place.caption[0] = '\0';
+		in_place.latex[0] = '\0';
+		if (!available())
+				return ErrorCode::Internal;
+		if (!out.cache || !out.cache->find(id_, index, in_place)) {
+				std::size_t latex_bytes = 0;
+				ErrorCode ec = step_latex_size(index, in_place, &latex_bytes);
+				if (is_ok(ec) && latex_bytes > in_place.latex_cap)
+						ec = ErrorCode::BufferTooSmall;
+				if (is_ok(ec))
+						ec = render_uncached(index, in_place);
+				if (!is_ok(ec)) {
+						in_place.caption[0] = '\0';
+						in_place.latex[0] = '\0';
+						return ec;
+				}
+		}
+
+		const std::size_t caption_len = std::strlen(in_place.caption);
+		if (caption_len == 0) {
+				doc->text = in_place.latex;
+				return ErrorCode::Ok;
+		}
+		// caption_len < caption_cap, so this stays inside the caption area
+		in_place.latex[-1] = '\n';
+		doc->text = in_place.latex - 1 - caption_len;
+		std::memmove(doc->text, in_place.caption, caption_len);
+		return ErrorCode::Ok;
+}
+
+ErrorCode Explanation::stream_step(std::size_t index, const StepRenderBuffers& out, const WriterSink& sink) const noexcept {
+		if (!sink.write || !out.latex || out.latex_cap < 2)
+				return ErrorCode::Internal;
+
+		StepRenderBuffers chunked = out;
+		chunked.cache = nullptr;
+		chunked.rows = nullptr;
+		chunked.sink = &sink;
+		const ErrorCode ec = render_step(index, chunked);
+		if (!is_ok(ec))
+				return ec;
+		// the last chunk is still in the buffer
+		const std::size_t tail = std::strlen(out.latex);
+		if (tail == 0)
+				return ErrorCode::Ok;
+		return sink.write(sink.ctx, out.latex, tail);
+}
+
+ErrorCode Explanation::step_latex_size(std::size_t index, const StepRenderBuffers& out, std::size_t* bytes) const noexcept {
+		if (!bytes)
+				return ErrorCode::Internal;
+		*bytes = 0;
+		std::size_t len = 0;
+		const WriterSink counter{&len, &count_chunk};
+		char chunk[kSizeChunkBytes];
+		StepRenderBuffers counted = out;
+		counted.latex = chunk;
+		counted.latex_cap = sizeof(chunk);
+		const ErrorCode ec = stream_step(index, counted, counter);
+		if (!is_ok(ec))
+				return ec;
+		*bytes = len + 1;
+		return ErrorCode::Ok;
 }
 
 Explanation Explanation::make(void* ctx, const ExplanationVTable* vtable) noexcept {
 		Explanation e;
 		e.ctx_ = ctx;
 		e.vtable_ = vtable;
+		// 0 is never handed out, it wraps after 2^32 explanations
+		if (++next_id == 0)
+				++next_id;
+		e.id_ = next_id;
 		return e;
 }
 
+ErrorCode Explanation::make_lazy(
+        Arena& persist, const void* recipe, ExplanationBuilder build, std::size_t build_bytes, Explanation* out) noexcept {
+		if (!recipe || !build || !out)
+				return ErrorCode::Internal;
+		void* mem = persist.allocate(sizeof(LazyCtx), alignof(LazyCtx));
+		if (!mem)
+				return ErrorCode::Overflow;
+		auto* ctx = new (mem) LazyCtx{};
+		ctx->build = build;
+		ctx->recipe = recipe;
+		ctx->build_bytes = build_bytes;
+		*out = make(ctx, &kLazyVTable);
+		return ErrorCode::Ok;
+}
+
+bool Explanation::lazy() const noexcept {
+		return available() && vtable_ == &kLazyVTable;
+}
+
+std::size_t Explanation::build_bytes() const noexcept {
+		return lazy() ? static_cast<const LazyCtx*>(ctx_)->build_bytes : 0;
+}
+
+ErrorCode Explanation::build(Arena& persist, Arena& scratch, Explanation* out) const noexcept {
+		if (!out)
+				return ErrorCode::Internal;
+		if (!lazy()) {
+				*out = borrow();
+				return ErrorCode::Ok;
+		}
+		const auto* ctx = static_cast<const LazyCtx*>(ctx_);
+		ArenaScope tx(persist);
+		ArenaScratchScope scratch_scope(scratch);
+		Explanation built;
+		const ErrorCode ec = ctx->build(ctx->recipe, persist, scratch, &built);
+		if (!is_ok(ec))
+				return ec;
+		tx.commit();
+		*out = std::move(built);
+		return ErrorCode::Ok;
+}
+
+Explanation Explanation::borrow() const noexcept {
+		Explanation e;
+		e.ctx_ = ctx_;
+		e.vtable_ = vtable_;
+		e.id_ = id_;
+		e.owned_ = false;
+		return e;
+}
+
+ErrorCode StepCache::init(Arena& arena, std::uint8_t capacity, std::size_t caption_cap, std::size_t latex_cap) noexcept {
+		entries_ = nullptr;
+		capacity_ = 0;
+		caption_cap_ = caption_cap;
+		latex_cap_ = latex_cap;
+		clock_ = 0;
+		hits_ = 0;
+		misses_ = 0;
+		if (capacity == 0)
+				return ErrorCode::Ok;
+		if (caption_cap == 0 || latex_cap == 0)
+				return ErrorCode::Internal;
+
+		void* mem = arena.allocate(sizeof(Entry) * capacity, alignof(Entry));
+		if (!mem)
+				return ErrorCode::Overflow;
+		auto* entries = static_cast<Entry*>(mem);
+		for (std::uint8_t i = 0; i < capacity; i++) {
+				auto* e = new (&entries[i]) Entry{};
+				e->caption = static_cast<char*>(arena.allocate(caption_cap, 1));
+				e->latex = static_cast<char*>(arena.allocate(latex_cap, 1));
+				if (!e->caption || !e->latex)
+						return ErrorCode::Overflow;
+		}
+		entries_ = entries;
+		capacity_ = capacity;
+		return ErrorCode::Ok;
+}
+
+void StepCache::clear() noexcept {
+		for (std::uint8_t i = 0; i < capacity_; i++)
+				entries_[i].stamp = 0;
+}
+
+// only whole renders are cached: both buffers given, both texts fitting,
+// and no sink taking the LaTeX away in chunks
+bool StepCache::find(std::uint32_t id, std::size_t index, const StepRenderBuffers& out) noexcept {
+		if (!out.caption || !out.latex || out.sink)
+				return false;
+		for (std::uint8_t i = 0; i < capacity_; i++) {
+				Entry& e = entries_[i];
+				if (e.stamp == 0 || e.id != id || e.index != index || e.style != out.style)
+						continue;
+				const std::size_t caption_len = std::strlen(e.caption);
+				const std::size_t latex_len = std::strlen(e.latex);
+				if (caption_len >= out.caption_cap || latex_len >= out.latex_cap)
+						break;
+				std::memcpy(out.caption, e.caption, caption_len + 1);
+				std::memcpy(out.latex, e.latex, latex_len + 1);
+				e.stamp = ++clock_;
+				hits_++;
+				return true;
+		}
+		misses_++;
+		return false;
+}
+
+void StepCache::keep(std::uint32_t id, std::size_t index, const StepRenderBuffers& out) noexcept {
+		if (capacity_ == 0 || !out.caption || !out.latex || out.sink)
+				return;
+		const std::size_t caption_len = std::strlen(out.caption);
+		const std::size_t latex_len = std::strlen(out.latex);
+		if (caption_len >= caption_cap_ || latex_len >= latex_cap_)
+				return;
+
+		Entry* victim = &entries_[0];
+		for (std::uint8_t i = 1; i < capacity_; i++) {
+				if (entries_[i].stamp < victim->stamp)
+						victim = &entries_[i];
+		}
+		victim->id = id;
+		victim->index = index;
+		victim->style = out.style;
+		std::memcpy(victim->caption, out.caption, caption_len + 1);
+		std::memcpy(victim->latex, out.latex, latex_len + 1);
+		victim->stamp = ++clock_;
+}
+
 } // namespace matrix_core
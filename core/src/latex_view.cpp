@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <limits>
 
 namespace matrix_core::latex {
 namespace {
@@ -47,6 +48,49 @@ const char* end_env(MatrixBrackets b) noexcept {
 		return nullptr;
 }
 
+// the entries of row of [left | right] joined by " & "; right may have no
+// columns
+ErrorCode write_row_entries(MatrixView left, MatrixView right, std::uint8_t row, Writer& w) noexcept {
+		const std::uint8_t total_cols = static_cast<std::uint8_t>(left.cols + right.cols);
+		for (std::uint8_t col = 0; col < total_cols; col++) {
+				if (col != 0) {
+						ErrorCode ec = w.append(" & ");
+						if (!is_ok(ec))
+								return ec;
+				}
+
+				ErrorCode ec;
+				if (col < left.cols)
+						ec = write_rational_inner(left.at(row, col), w);
+				else
+						ec = write_rational_inner(right.at(row, static_cast<std::uint8_t>(col - left.cols)), w);
+				if (!is_ok(ec))
+						return ec;
+		}
+		return ErrorCode::Ok;
+}
+
+// \left[\begin{array}{rr|rr}
+ErrorCode write_augmented_begin(std::uint8_t left_cols, std::uint8_t right_cols, Writer& w) noexcept {
+		ErrorCode ec = w.append("\\left[\\begin{array}{");
+		if (!is_ok(ec))
+				return ec;
+		for (std::uint8_t i = 0; i < left_cols; i++) {
+				ec = w.put('r');
+				if (!is_ok(ec))
+						return ec;
+		}
+		ec = w.put('|');
+		if (!is_ok(ec))
+				return ec;
+		for (std::uint8_t i = 0; i < right_cols; i++) {
+				ec = w.put('r');
+				if (!is_ok(ec))
+						return ec;
+		}
+		return w.append("}");
+}
+
 ErrorCode write_matrix_inner(MatrixView m, MatrixBrackets brackets, Writer& w) noexcept {
 		if (!m.data)
 				return ErrorCode::Internal;
@@ -61,23 +105,19 @@ ErrorCode write_matrix_inner(MatrixView m, MatrixBrackets brackets, Writer& w) n
 				return ec;
 
 		for (std::uint8_t row = 0; row < m.rows; row++) {
-				for (std::uint8_t col = 0; col < m.cols; col++) {
-						if (col != 0) {
-								ec = w.append(" & ");
-								if (!is_ok(ec))
-										return ec;
-						}
-
-						ec = write_rational_inner(m.at(row, col), w);
-						if (!is_ok(ec))
-								return ec;
-				}
+				ec = write_row_entries(m, MatrixView{}, row, w);
+				if (!is_ok(ec))
+						return ec;
 
 				if (row + 1 < m.rows) {
 						ec = w.append(" \\\\ ");
 						if (!is_ok(ec))
 								return ec;
 				}
+				// a streamed write hands each row over as it is done
+				ec = w.flush();
+				if (!is_ok(ec))
+						return ec;
 		}
 
 		ec = w.append(end);
@@ -105,62 +145,157 @@ ErrorCode write_augmented_matrix_inner(MatrixView left, MatrixView right, Writer
 		if (left.cols == 0 || right.cols == 0)
 				return ErrorCode::InvalidDimension;
 
-		ErrorCode ec = w.append("\\left[\\begin{array}{");
+		ErrorCode ec = write_augmented_begin(left.cols, right.cols, w);
 		if (!is_ok(ec))
 				return ec;
-		for (std::uint8_t i = 0; i < left.cols; i++) {
-				ec = w.put('r');
+
+		for (std::uint8_t row = 0; row < left.rows; row++) {
+				ec = write_row_entries(left, right, row, w);
 				if (!is_ok(ec))
 						return ec;
-		}
-		ec = w.put('|');
-		if (!is_ok(ec))
-				return ec;
-		for (std::uint8_t i = 0; i < right.cols; i++) {
-				ec = w.put('r');
+
+				if (row + 1 < left.rows) {
+						ec = w.append(" \\\\ ");
+						if (!is_ok(ec))
+								return ec;
+				}
+				// a streamed write hands each row over as it is done
+				ec = w.flush();
 				if (!is_ok(ec))
 						return ec;
 		}
-		ec = w.append("}");
+
+		ec = w.append("\\end{array}\\right]");
 		if (!is_ok(ec))
 				return ec;
 
-		const std::uint8_t total_cols = static_cast<std::uint8_t>(left.cols + right.cols);
-		for (std::uint8_t row = 0; row < left.rows; row++) {
-				for (std::uint8_t col = 0; col < total_cols; col++) {
+		return ErrorCode::Ok;
+}
+
+ErrorCode write_augmented_matrix_display_inner(MatrixView left, MatrixView right, Writer& w) noexcept {
+		ErrorCode ec = w.append("$$");
+		if (!is_ok(ec))
+				return ec;
+		ec = write_augmented_matrix_inner(left, right, w);
+		if (!is_ok(ec))
+				return ec;
+		return w.append("$$");
+}
+
+std::uint64_t gcd_u64(std::uint64_t a, std::uint64_t b) noexcept {
+		while (b != 0u) {
+				const std::uint64_t t = a % b;
+				a = b;
+				b = t;
+		}
+		return a;
+}
+
+// num * k, false when it does not fit; k > 0
+bool scale_fits(std::int64_t num, std::int64_t k, std::int64_t* out) noexcept {
+		const std::int64_t limit = std::numeric_limits<std::int64_t>::max() / k;
+		if (num > limit || num < -limit)
+				return false;
+		*out = num * k;
+		return true;
+}
+
+// \frac{1}{d}\begin{bmatrix} ... \end{bmatrix}, every entry times d; the
+// caller has checked that they all fit
+ErrorCode write_factored_inner(MatrixView m, MatrixBrackets brackets, std::int64_t d, Writer& w) noexcept {
+		ErrorCode ec = w.append("$$\\frac{1}{");
+		if (is_ok(ec))
+				ec = w.append_i64(d);
+		if (is_ok(ec))
+				ec = w.put('}');
+		if (is_ok(ec))
+				ec = w.append(begin_env(brackets));
+		if (!is_ok(ec))
+				return ec;
+		for (std::uint8_t row = 0; row < m.rows; row++) {
+				for (std::uint8_t col = 0; col < m.cols; col++) {
 						if (col != 0) {
 								ec = w.append(" & ");
 								if (!is_ok(ec))
 										return ec;
 						}
-
-						if (col < left.cols)
-								ec = write_rational_inner(left.at(row, col), w);
-						else
-								ec = write_rational_inner(right.at(row, static_cast<std::uint8_t>(col - left.cols)), w);
+						const Rational& v = m.at(row, col);
+						std::int64_t scaled = 0;
+						if (!scale_fits(v.num(), d / v.den(), &scaled))
+								return ErrorCode::Overflow;
+						ec = w.append_i64(scaled);
 						if (!is_ok(ec))
 								return ec;
 				}
-
-				if (row + 1 < left.rows) {
+				if (row + 1 < m.rows) {
 						ec = w.append(" \\\\ ");
 						if (!is_ok(ec))
 								return ec;
 				}
+				// a streamed write hands each row over as it is done
+				ec = w.flush();
+				if (!is_ok(ec))
+						return ec;
 		}
-
-		ec = w.append("\\end{array}\\right]");
+		ec = w.append(end_env(brackets));
 		if (!is_ok(ec))
 				return ec;
+		return w.append("$$");
+}
 
-		return ErrorCode::Ok;
+// the d write_matrix_display factors out of m in style, 1 when it writes m
+// Plain: factored only when every entry fits and it comes out shorter
+std::int64_t factor_for(MatrixView m, MatrixBrackets brackets, MatrixStyle style) noexcept {
+		if (style == MatrixStyle::Plain || brackets == MatrixBrackets::VMatrix || !m.data)
+				return 1;
+		std::int64_t d = 1;
+		if (!is_ok(common_denominator(m, &d)) || d == 1)
+				return 1;
+		Writer factored = Writer::counter();
+		if (!is_ok(write_factored_inner(m, brackets, d, factored)))
+				return 1;
+		Writer plain = Writer::counter();
+		if (!is_ok(write_matrix_display_inner(m, brackets, plain)) || factored.len >= plain.len)
+				return 1;
+		return d;
 }
 
-ErrorCode write_augmented_matrix_display_inner(MatrixView left, MatrixView right, Writer& w) noexcept {
+// a writer over out that terminates once, at terminate()
+Writer deferred(Buffer out) noexcept {
+		Writer w{out.data, out.cap, 0};
+		w.defer_terminator = true;
+		w.sink = out.sink;
+		return w;
+}
+
+// the size a counter() found, with room for the terminator
+ErrorCode measured(ErrorCode ec, const Writer& w, std::size_t* bytes) noexcept {
+		*bytes = is_ok(ec) ? w.len + 1 : 0;
+		return ec;
+}
+
+// the display form of [left | right] around its already written rows
+ErrorCode write_rows_from(MatrixView left, MatrixView right, char* const* rows, Writer& w) noexcept {
 		ErrorCode ec = w.append("$$");
 		if (!is_ok(ec))
 				return ec;
-		ec = write_augmented_matrix_inner(left, right, w);
+		ec = (right.cols == 0) ? w.append(begin_env(MatrixBrackets::BMatrix)) : write_augmented_begin(left.cols, right.cols, w);
+		if (!is_ok(ec))
+				return ec;
+		for (std::uint8_t row = 0; row < left.rows; row++) {
+				if (row != 0) {
+						ec = w.append(" \\\\ ");
+						if (!is_ok(ec))
+								return ec;
+				}
+				ec = w.append(rows[row]);
+				if (!is_ok(ec))
+						return ec;
+				ec = w.flush();
+				if (!is_ok(ec))
+						return ec;
+		}
+		ec = w.append((right.cols == 0) ? end_env(MatrixBrackets::BMatrix) : "\\end{array}\\right]");
 		if (!is_ok(ec))
 				return ec;
 		return w.append("$$");
@@ -168,47 +303,210 @@ ErrorCode write_augmented_matrix_display_inner(MatrixView left, MatrixView right
 
 } // namespace
 
+ErrorCode write_rational_size(const Rational& r, std::size_t* bytes) noexcept {
+		if (!bytes)
+				return ErrorCode::Internal;
+		Writer w = Writer::counter();
+		return measured(write_rational_inner(r, w), w, bytes);
+}
+
+ErrorCode write_rational_display_size(const Rational& r, std::size_t* bytes) noexcept {
+		if (!bytes)
+				return ErrorCode::Internal;
+		Writer w = Writer::counter();
+		return measured(write_rational_display_inner(r, w), w, bytes);
+}
+
+ErrorCode write_matrix_size(MatrixView m, MatrixBrackets brackets, std::size_t* bytes) noexcept {
+		if (!bytes)
+				return ErrorCode::Internal;
+		Writer w = Writer::counter();
+		return measured(write_matrix_inner(m, brackets, w), w, bytes);
+}
+
+ErrorCode write_matrix_display_size(MatrixView m, MatrixBrackets brackets, std::size_t* bytes) noexcept {
+		if (!bytes)
+				return ErrorCode::Internal;
+		Writer w = Writer::counter();
+		return measured(write_matrix_display_inner(m, brackets, w), w, bytes);
+}
+
+ErrorCode write_augmented_matrix_size(MatrixView left, MatrixView right, std::size_t* bytes) noexcept {
+		if (!bytes)
+				return ErrorCode::Internal;
+		Writer w = Writer::counter();
+		return measured(write_augmented_matrix_inner(left, right, w), w, bytes);
+}
+
+ErrorCode write_augmented_matrix_display_size(MatrixView left, MatrixView right, std::size_t* bytes) noexcept {
+		if (!bytes)
+				return ErrorCode::Internal;
+		Writer w = Writer::counter();
+		return measured(write_augmented_matrix_display_inner(left, right, w), w, bytes);
+}
+
+ErrorCode RowFragments::init(Arena& arena, std::size_t row_cap) noexcept {
+		data_ = nullptr;
+		row_cap_ = 0;
+		clear();
+		rows_written_ = 0;
+		if (row_cap == 0)
+				return ErrorCode::Internal;
+		void* mem = arena.allocate(row_cap * kMaxRows, 1);
+		if (!mem)
+				return ErrorCode::Overflow;
+		data_ = static_cast<char*>(mem);
+		row_cap_ = row_cap;
+		return ErrorCode::Ok;
+}
+
+void RowFragments::clear() noexcept {
+		owner_ = nullptr;
+		index_ = 0;
+		rows_ = 0;
+		left_cols_ = 0;
+		right_cols_ = 0;
+}
+
+ErrorCode write_rows_display(MatrixView left, MatrixView right, const RowStep& step, RowFragments& frags, Buffer out) noexcept {
+		if (!left.data || (right.cols != 0 && !right.data))
+				return ErrorCode::Internal;
+		if (right.cols != 0 && left.rows != right.rows)
+				return ErrorCode::DimensionMismatch;
+		if (left.rows > kMaxRows || !frags.data_ || !step.owner) {
+				if (right.cols == 0)
+						return write_matrix_display(left, MatrixBrackets::BMatrix, out);
+				return write_augmented_matrix_display(left, right, out);
+		}
+
+		const bool same_shape = frags.owner_ == step.owner && frags.rows_ == left.rows && frags.left_cols_ == left.cols &&
+		                        frags.right_cols_ == right.cols;
+		std::uint32_t stale = kAllRows;
+		if (same_shape && frags.index_ == step.index)
+				stale = 0;
+		else if (same_shape && step.index > 0 && frags.index_ == step.index - 1)
+				stale = step.changed;
+
+		// until every row is written again the fragments match no step
+		frags.clear();
+		char* rows[kMaxRows];
+		for (std::uint8_t row = 0; row < left.rows; row++) {
+				rows[row] = frags.row(row);
+				if ((stale & (1u << row)) == 0u)
+						continue;
+				Writer rw = deferred({rows[row], frags.row_cap_});
+				const ErrorCode ec = write_row_entries(left, right, row, rw);
+				rw.terminate();
+				if (ec == ErrorCode::BufferTooSmall) {
+						if (right.cols == 0)
+								return write_matrix_display(left, MatrixBrackets::BMatrix, out);
+						return write_augmented_matrix_display(left, right, out);
+				}
+				if (!is_ok(ec))
+						return ec;
+				frags.rows_written_++;
+		}
+		frags.owner_ = step.owner;
+		frags.index_ = step.index;
+		frags.rows_ = left.rows;
+		frags.left_cols_ = left.cols;
+		frags.right_cols_ = right.cols;
+
+		Writer w = deferred(out);
+		const ErrorCode ec = write_rows_from(left, right, rows, w);
+		w.terminate();
+		return ec;
+}
+
+// the fragments only save formatting; the text is the full write's
+ErrorCode write_rows_display_size(MatrixView left, MatrixView right, std::size_t* bytes) noexcept {
+		if (!bytes)
+				return ErrorCode::Internal;
+		if (!left.data || (right.cols != 0 && !right.data))
+				return ErrorCode::Internal;
+		if (right.cols == 0)
+				return write_matrix_display_size(left, MatrixBrackets::BMatrix, bytes);
+		return write_augmented_matrix_display_size(left, right, bytes);
+}
+
 ErrorCode write_rational(const Rational& r, Buffer out) noexcept {
-		Writer w{out.data, out.cap, 0};
-		if (w.data && w.cap)
-				w.data[0] = '\0';
-		return write_rational_inner(r, w);
+		Writer w = deferred(out);
+		const ErrorCode ec = write_rational_inner(r, w);
+		w.terminate();
+		return ec;
 }
 
 ErrorCode write_rational_display(const Rational& r, Buffer out) noexcept {
-		Writer w{out.data, out.cap, 0};
-		if (w.data && w.cap)
-				w.data[0] = '\0';
-		return write_rational_display_inner(r, w);
+		Writer w = deferred(out);
+		const ErrorCode ec = write_rational_display_inner(r, w);
+		w.terminate();
+		return ec;
 }
 
 ErrorCode write_matrix(MatrixView m, MatrixBrackets brackets, Buffer out) noexcept {
-		Writer w{out.data, out.cap, 0};
-		if (w.data && w.cap)
-				w.data[0] = '\0';
-
-		return write_matrix_inner(m, brackets, w);
+		Writer w = deferred(out);
+		const ErrorCode ec = write_matrix_inner(m, brackets, w);
+		w.terminate();
+		return ec;
 }
 
 ErrorCode write_matrix_display(MatrixView m, MatrixBrackets brackets, Buffer out) noexcept {
-		Writer w{out.data, out.cap, 0};
-		if (w.data && w.cap)
-				w.data[0] = '\0';
-		return write_matrix_display_inner(m, brackets, w);
+		Writer w = deferred(out);
+		const ErrorCode ec = write_matrix_display_inner(m, brackets, w);
+		w.terminate();
+		return ec;
+}
+
+ErrorCode common_denominator(MatrixView m, std::int64_t* d) noexcept {
+		if (!d || (!m.data && m.rows != 0 && m.cols != 0))
+				return ErrorCode::Internal;
+		std::int64_t lcm = 1;
+		for (std::uint8_t row = 0; row < m.rows; row++) {
+				for (std::uint8_t col = 0; col < m.cols; col++) {
+						const std::int64_t den = m.at(row, col).den();
+						const std::int64_t g =
+						        static_cast<std::int64_t>(gcd_u64(static_cast<std::uint64_t>(lcm), static_cast<std::uint64_t>(den)));
+						if (!scale_fits(lcm / g, den, &lcm))
+								return ErrorCode::Overflow;
+				}
+		}
+		*d = lcm;
+		return ErrorCode::Ok;
+}
+
+ErrorCode write_matrix_display(MatrixView m, MatrixBrackets brackets, MatrixStyle style, Buffer out) noexcept {
+		const std::int64_t d = factor_for(m, brackets, style);
+		if (d == 1)
+				return write_matrix_display(m, brackets, out);
+
+		Writer w = deferred(out);
+		const ErrorCode ec = write_factored_inner(m, brackets, d, w);
+		w.terminate();
+		return ec;
+}
+
+ErrorCode write_matrix_display_size(MatrixView m, MatrixBrackets brackets, MatrixStyle style, std::size_t* bytes) noexcept {
+		if (!bytes)
+				return ErrorCode::Internal;
+		const std::int64_t d = factor_for(m, brackets, style);
+		if (d == 1)
+				return write_matrix_display_size(m, brackets, bytes);
+		Writer w = Writer::counter();
+		return measured(write_factored_inner(m, brackets, d, w), w, bytes);
 }
 
 ErrorCode write_augmented_matrix(MatrixView left, MatrixView right, Buffer out) noexcept {
-		Writer w{out.data, out.cap, 0};
-		if (w.data && w.cap)
-				w.data[0] = '\0';
-		return write_augmented_matrix_inner(left, right, w);
+		Writer w = deferred(out);
+		const ErrorCode ec = write_augmented_matrix_inner(left, right, w);
+		w.terminate();
+		return ec;
 }
 
 ErrorCode write_augmented_matrix_display(MatrixView left, MatrixView right, Buffer out) noexcept {
-		Writer w{out.data, out.cap, 0};
-		if (w.data && w.cap)
-				w.data[0] = '\0';
-		return write_augmented_matrix_display_inner(left, right, w);
+		Writer w = deferred(out);
+		const ErrorCode ec = write_augmented_matrix_display_inner(left, right, w);
+		w.terminate();
+		return ec;
 }
 
 } // namespace matrix_core::latex
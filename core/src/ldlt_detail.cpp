@@ -0,0 +1,194 @@
+#include "matrix_core/ldlt_detail.hpp"
+
+namespace matrix_core::detail {
+
+ErrorCode ldlt_elim(MatrixMutView m, std::size_t* op_count, std::size_t stop_after, RowOp* last_op) noexcept {
+		if (!m.data)
+				return ErrorCode::Internal;
+		if (m.rows != m.cols)
+				return ErrorCode::NotSquare;
+
+		const std::uint8_t n = m.rows;
+		std::size_t ops = 0;
+		RowOp last{};
+		bool have_last = false;
+
+		for (std::uint8_t k = 0; k < n && ops != stop_after; k++) {
+				const Rational pivot_val = m.at(k, k);
+				if (pivot_val.is_zero()) {
+						for (std::uint8_t i = static_cast<std::uint8_t>(k + 1); i < n; i++) {
+								if (!m.at(i, k).is_zero())
+										return ErrorCode::DivisionByZero;
+								m.at_mut(k, i) = Rational::from_int(0);
+						}
+						continue;
+				}
+
+				for (std::uint8_t i = static_cast<std::uint8_t>(k + 1); i < n; i++) {
+						const Rational below = m.at(i, k);
+						if (below.is_zero()) {
+								m.at_mut(k, i) = Rational::from_int(0);
+								continue;
+						}
+
+						Rational l;
+						ErrorCode ec = rational_div(below, pivot_val, &l);
+						if (!is_ok(ec))
+								return ec;
+
+						// row op then column op; every a_jk with k < j < i is
+						// already zero, so only a_ii and column i below it move
+						Rational delta;
+						ec = rational_mul(l, below, &delta);
+						if (!is_ok(ec))
+								return ec;
+						ec = rational_sub(m.at(i, i), delta, &m.at_mut(i, i));
+						if (!is_ok(ec))
+								return ec;
+						for (std::uint8_t j = static_cast<std::uint8_t>(i + 1); j < n; j++) {
+								const Rational& ajk = m.at(j, k);
+								if (ajk.is_zero())
+										continue;
+								ec = rational_mul(l, ajk, &delta);
+								if (!is_ok(ec))
+										return ec;
+								ec = rational_sub(m.at(j, i), delta, &m.at_mut(j, i));
+								if (!is_ok(ec))
+										return ec;
+						}
+						m.at_mut(i, k) = Rational::from_int(0);
+						m.at_mut(k, i) = l;
+
+						ops++;
+						last.kind = RowOpKind::AddMul;
+						last.target_row = i;
+						last.source_row = k;
+						ec = rational_neg(l, &last.scalar);
+						if (!is_ok(ec))
+								return ec;
+						have_last = true;
+						if (ops == stop_after)
+								break;
+				}
+		}
+
+		if (op_count)
+				*op_count = ops;
+		if (last_op && have_last)
+				*last_op = last;
+		return ErrorCode::Ok;
+}
+
+ErrorCode ldlt_det(MatrixView f, Rational* det_out) noexcept {
+		if (!det_out || !f.data)
+				return ErrorCode::Internal;
+
+		Rational det = Rational::from_int(1);
+		for (std::uint8_t i = 0; i < f.rows; i++) {
+				Rational next;
+				ErrorCode ec = rational_mul(det, f.at(i, i), &next);
+				if (!is_ok(ec))
+						return ec;
+				det = next;
+		}
+		*det_out = det;
+		return ErrorCode::Ok;
+}
+
+std::size_t ldlt_inverse_op_count(MatrixView f) noexcept {
+		std::size_t ops = 0;
+		for (std::uint8_t i = 0; i < f.rows; i++) {
+				const Rational& d = f.at(i, i);
+				if (d.num() != 1 || d.den() != 1)
+						ops++;
+				for (std::uint8_t j = static_cast<std::uint8_t>(i + 1); j < f.cols; j++) {
+						if (!f.at(i, j).is_zero())
+								ops += 2;
+				}
+		}
+		return ops;
+}
+
+std::size_t ldlt_inverse_group_count(MatrixView f) noexcept {
+		// l_ji sits at f(i, j): down clears column i of L (row i of f's upper
+		// triangle), up clears column j of L^T (column j of it)
+		std::size_t groups = 0;
+		bool scales = false;
+		for (std::uint8_t i = 0; i < f.rows; i++) {
+				const Rational& d = f.at(i, i);
+				scales = scales || d.num() != 1 || d.den() != 1;
+				bool down = false;
+				bool up = false;
+				for (std::uint8_t j = 0; j < f.cols; j++) {
+						down = down || (j > i && !f.at(i, j).is_zero());
+						up = up || (j < i && !f.at(j, i).is_zero());
+				}
+				groups += (down ? 1u : 0u) + (up ? 1u : 0u);
+		}
+		return groups + (scales ? 1u : 0u);
+}
+
+ErrorCode ldlt_solve(MatrixView f, MatrixView b, MatrixMutView x) noexcept {
+		if (!f.data || !b.data || !x.data)
+				return ErrorCode::Internal;
+		if (f.rows != f.cols)
+				return ErrorCode::NotSquare;
+		const std::uint8_t n = f.rows;
+		if (b.rows != n || b.cols != 1 || x.rows != n || x.cols != 1)
+				return ErrorCode::DimensionMismatch;
+
+		// L y = b
+		for (std::uint8_t i = 0; i < n; i++) {
+				Rational acc = b.at(i, 0);
+				for (std::uint8_t k = 0; k < i; k++) {
+						const Rational& l = f.at(k, i);
+						if (l.is_zero())
+								continue;
+						Rational t;
+						ErrorCode ec = rational_mul(l, x.at(k, 0), &t);
+						if (!is_ok(ec))
+								return ec;
+						ec = rational_sub(acc, t, &acc);
+						if (!is_ok(ec))
+								return ec;
+				}
+				x.at_mut(i, 0) = acc;
+		}
+
+		// D z = y
+		for (std::uint8_t i = 0; i < n; i++) {
+				if (f.at(i, i).is_zero())
+						return ErrorCode::Singular;
+				ErrorCode ec = rational_div(x.at(i, 0), f.at(i, i), &x.at_mut(i, 0));
+				if (!is_ok(ec))
+						return ec;
+		}
+
+		// L^T x = z
+		for (std::uint8_t i = n; i-- > 0;) {
+				Rational acc = x.at(i, 0);
+				for (std::uint8_t j = static_cast<std::uint8_t>(i + 1); j < n; j++) {
+						const Rational& l = f.at(i, j);
+						if (l.is_zero())
+								continue;
+						Rational t;
+						ErrorCode ec = rational_mul(l, x.at(j, 0), &t);
+						if (!is_ok(ec))
+								return ec;
+						ec = rational_sub(acc, t, &acc);
+						if (!is_ok(ec))
+								return ec;
+				}
+				x.at_mut(i, 0) = acc;
+		}
+		return ErrorCode::Ok;
+}
+
+void ldlt_mirror_lower(MatrixMutView m) noexcept {
+		for (std::uint8_t row = 0; row < m.rows; row++) {
+				for (std::uint8_t col = static_cast<std::uint8_t>(row + 1); col < m.cols; col++)
+						m.at_mut(row, col) = m.at(col, row);
+		}
+}
+
+} // namespace matrix_core::detail
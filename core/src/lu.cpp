@@ -0,0 +1,470 @@
+#include "matrix_core/lu.hpp"
+
+#include "matrix_core/ops.hpp"
+#include "matrix_core/row_reduction.hpp"
+
+#include <new>
+
+namespace matrix_core {
+namespace {
+
+constexpr bool is_one(const Rational& r) noexcept {
+		return r.num() == 1 && r.den() == 1;
+}
+
+// column c of x holds P b on entry, the solution on return
+ErrorCode lu_substitute(const LuFactor& f, MatrixMutView x, std::uint8_t c) noexcept {
+		const MatrixView lu = f.lu.view();
+		const std::uint8_t n = lu.rows;
+
+		// L y = P b
+		for (std::uint8_t i = 1; i < n; i++) {
+				Rational acc = x.at(i, c);
+				for (std::uint8_t k = 0; k < i; k++) {
+						const Rational& l = lu.at(i, k);
+						if (l.is_zero() || x.at(k, c).is_zero())
+								continue;
+						Rational t;
+						ErrorCode ec = rational_mul(l, x.at(k, c), &t);
+						if (!is_ok(ec))
+								return ec;
+						ec = rational_sub(acc, t, &acc);
+						if (!is_ok(ec))
+								return ec;
+				}
+				x.at_mut(i, c) = acc;
+		}
+
+		// U x = y
+		for (std::uint8_t i = n; i-- > 0;) {
+				Rational acc = x.at(i, c);
+				for (std::uint8_t j = static_cast<std::uint8_t>(i + 1); j < n; j++) {
+						const Rational& u = lu.at(i, j);
+						if (u.is_zero() || x.at(j, c).is_zero())
+								continue;
+						Rational t;
+						ErrorCode ec = rational_mul(u, x.at(j, c), &t);
+						if (!is_ok(ec))
+								return ec;
+						ec = rational_sub(acc, t, &acc);
+						if (!is_ok(ec))
+								return ec;
+				}
+				ErrorCode ec = rational_div(acc, lu.at(i, i), &x.at_mut(i, c));
+				if (!is_ok(ec))
+						return ec;
+		}
+		return ErrorCode::Ok;
+}
+
+} // namespace
+
+ErrorCode lu_factor_in_place(MatrixMutView m, LuFactor* out, std::size_t stop_after, RowOp* last_op) noexcept {
+		if (!out || !m.data)
+				return ErrorCode::Internal;
+		if (m.rows != m.cols)
+				return ErrorCode::NotSquare;
+
+		const std::uint8_t n = m.rows;
+		LuFactor f;
+		f.lu = m;
+		for (std::uint8_t i = 0; i < n; i++)
+				f.perm[i] = i;
+
+		std::size_t ops = 0;
+		std::size_t groups = 0;
+		RowOp last{};
+		bool have_last = false;
+
+		for (std::uint8_t col = 0; col < n && ops != stop_after; col++) {
+				const std::size_t col_start = ops;
+				std::uint8_t pivot = col;
+				bool found = false;
+				for (std::uint8_t row = col; row < n; row++) {
+						if (!m.at(row, col).is_zero()) {
+								pivot = row;
+								found = true;
+								break;
+						}
+				}
+				if (!found) {
+						if (!f.singular) {
+								f.det_ops = ops;
+								f.det_groups = groups;
+						}
+						f.singular = true;
+						continue;
+				}
+
+				if (pivot != col) {
+						// whole rows move, stored multipliers included
+						apply_swap(m, col, pivot);
+						const std::uint8_t t = f.perm[col];
+						f.perm[col] = f.perm[pivot];
+						f.perm[pivot] = t;
+						f.sign = static_cast<std::int8_t>(-f.sign);
+
+						ops++;
+						last.kind = RowOpKind::Swap;
+						last.target_row = col;
+						last.source_row = pivot;
+						have_last = true;
+						if (ops == stop_after)
+								break;
+				}
+
+				const Rational pivot_val = m.at(col, col);
+				for (std::uint8_t row = static_cast<std::uint8_t>(col + 1); row < n; row++) {
+						const Rational below = m.at(row, col);
+						if (below.is_zero())
+								continue;
+
+						Rational l;
+						ErrorCode ec = rational_div(below, pivot_val, &l);
+						if (!is_ok(ec))
+								return ec;
+						for (std::uint8_t c = static_cast<std::uint8_t>(col + 1); c < n; c++) {
+								const Rational& u = m.at(col, c);
+								if (u.is_zero())
+										continue;
+								Rational t;
+								ec = rational_mul(l, u, &t);
+								if (!is_ok(ec))
+										return ec;
+								ec = rational_sub(m.at(row, c), t, &m.at_mut(row, c));
+								if (!is_ok(ec))
+										return ec;
+						}
+						m.at_mut(row, col) = l;
+
+						ops++;
+						last.kind = RowOpKind::AddMul;
+						last.target_row = row;
+						last.source_row = col;
+						ec = rational_neg(l, &last.scalar);
+						if (!is_ok(ec))
+								return ec;
+						have_last = true;
+						if (ops == stop_after)
+								break;
+				}
+				if (ops != col_start)
+						groups++;
+		}
+
+		if (!f.singular) {
+				f.det_ops = ops;
+				f.det_groups = groups;
+		}
+		f.op_count = ops;
+		f.groups = groups;
+		*out = f;
+		if (last_op && have_last)
+				*last_op = last;
+		return ErrorCode::Ok;
+}
+
+ErrorCode lu_factor(MatrixView a, Arena& arena, LuFactor* out) noexcept {
+		MatrixMutView m;
+		ErrorCode ec = matrix_clone(arena, a, &m);
+		if (!is_ok(ec))
+				return ec;
+		return lu_factor_in_place(m, out, static_cast<std::size_t>(-1), nullptr);
+}
+
+ErrorCode lu_det(const LuFactor& f, Rational* out) noexcept {
+		if (!out || !f.lu.data)
+				return ErrorCode::Internal;
+		if (f.singular) {
+				*out = Rational::from_int(0);
+				return ErrorCode::Ok;
+		}
+
+		Rational det = Rational::from_int(f.sign);
+		for (std::uint8_t i = 0; i < f.lu.rows; i++) {
+				ErrorCode ec = rational_mul(det, f.lu.at(i, i), &det);
+				if (!is_ok(ec))
+						return ec;
+		}
+		*out = det;
+		return ErrorCode::Ok;
+}
+
+ErrorCode lu_solve(const LuFactor& f, MatrixView b, MatrixMutView x) noexcept {
+		if (!f.lu.data || !b.data || !x.data)
+				return ErrorCode::Internal;
+		const std::uint8_t n = f.lu.rows;
+		if (b.rows != n || x.rows != n || x.cols != b.cols)
+				return ErrorCode::DimensionMismatch;
+		if (f.singular)
+				return ErrorCode::Singular;
+
+		for (std::uint8_t c = 0; c < b.cols; c++) {
+				for (std::uint8_t i = 0; i < n; i++)
+						x.at_mut(i, c) = b.at(f.perm[i], c);
+				ErrorCode ec = lu_substitute(f, x, c);
+				if (!is_ok(ec))
+						return ec;
+		}
+		return ErrorCode::Ok;
+}
+
+ErrorCode lu_inverse(const LuFactor& f, MatrixMutView out) noexcept {
+		if (!f.lu.data || !out.data)
+				return ErrorCode::Internal;
+		const std::uint8_t n = f.lu.rows;
+		if (out.rows != n || out.cols != n)
+				return ErrorCode::DimensionMismatch;
+		if (f.singular)
+				return ErrorCode::Singular;
+
+		for (std::uint8_t c = 0; c < n; c++) {
+				// P e_c
+				for (std::uint8_t i = 0; i < n; i++)
+						out.at_mut(i, c) = Rational::from_int(f.perm[i] == c ? 1 : 0);
+				ErrorCode ec = lu_substitute(f, out, c);
+				if (!is_ok(ec))
+						return ec;
+		}
+		return ErrorCode::Ok;
+}
+
+std::size_t lu_inverse_op_count(const LuFactor& f) noexcept {
+		std::size_t ops = f.op_count;
+		const std::uint8_t n = f.lu.rows;
+		for (std::uint8_t i = 0; i < n; i++) {
+				if (!is_one(f.lu.at(i, i)))
+						ops++;
+				for (std::uint8_t j = static_cast<std::uint8_t>(i + 1); j < n; j++) {
+						if (!f.lu.at(i, j).is_zero())
+								ops++;
+				}
+		}
+		return ops;
+}
+
+std::size_t lu_inverse_group_count(const LuFactor& f) noexcept {
+		std::size_t groups = f.groups;
+		const std::uint8_t n = f.lu.rows;
+		bool scales = false;
+		for (std::uint8_t j = 0; j < n; j++) {
+				scales = scales || !is_one(f.lu.at(j, j));
+				for (std::uint8_t i = 0; i < j; i++) {
+						if (!f.lu.at(i, j).is_zero()) {
+								groups++;
+								break;
+						}
+				}
+		}
+		return groups + (scales ? 1 : 0);
+}
+
+void lu_unpack(const LuFactor& f, MatrixMutView l, MatrixMutView u, MatrixMutView p) noexcept {
+		const std::uint8_t n = f.lu.rows;
+		const Rational zero = Rational::from_int(0);
+		for (std::uint8_t r = 0; r < n; r++) {
+				for (std::uint8_t c = 0; c < n; c++) {
+						const Rational& v = f.lu.at(r, c);
+						if (l.data)
+								l.at_mut(r, c) = (r > c) ? v : Rational::from_int(r == c ? 1 : 0);
+						if (u.data)
+								u.at_mut(r, c) = (r <= c) ? v : zero;
+						if (p.data)
+								p.at_mut(r, c) = Rational::from_int(f.perm[r] == c ? 1 : 0);
+				}
+		}
+}
+
+ErrorCode LuCache::init(Arena& arena, std::uint8_t capacity) noexcept {
+		entries_ = nullptr;
+		capacity_ = 0;
+		clock_ = 0;
+		hits_ = 0;
+		misses_ = 0;
+		if (capacity == 0)
+				return ErrorCode::Ok;
+
+		void* mem = arena.allocate(sizeof(Entry) * capacity, alignof(Entry));
+		if (!mem)
+				return ErrorCode::Overflow;
+		auto* entries = static_cast<Entry*>(mem);
+		for (std::uint8_t i = 0; i < capacity; i++) {
+				auto* e = new (&entries[i]) Entry{};
+				void* data = arena.allocate(sizeof(Rational) * kMaxRows * kMaxRows, alignof(Rational));
+				void* input = arena.allocate(sizeof(Rational) * kMaxRows * kMaxRows, alignof(Rational));
+				if (!data || !input)
+						return ErrorCode::Overflow;
+				e->storage = static_cast<Rational*>(data);
+				e->input = static_cast<Rational*>(input);
+		}
+		entries_ = entries;
+		capacity_ = capacity;
+		return ErrorCode::Ok;
+}
+
+ErrorCode LuCache::get(MatrixView a, const LuFactor** out) noexcept {
+		if (!out || !a.data)
+				return ErrorCode::Internal;
+		if (a.rows != a.cols)
+				return ErrorCode::NotSquare;
+		if (!entries_)
+				return ErrorCode::Internal;
+
+		const std::uint64_t h = content_hash(a);
+		Entry* victim = &entries_[0];
+		for (std::uint8_t i = 0; i < capacity_; i++) {
+				Entry& e = entries_[i];
+				if (e.stamp != 0 && e.hash == h && matrix_equal(MatrixView{a.rows, a.cols, kMaxRows, e.input}, a)) {
+						e.stamp = ++clock_;
+						hits_++;
+						*out = &e.factor;
+						return ErrorCode::Ok;
+				}
+				if (e.stamp < victim->stamp)
+						victim = &e;
+		}
+
+		misses_++;
+		victim->stamp = 0;
+		MatrixMutView m{a.rows, a.cols, kMaxRows, victim->storage};
+		ErrorCode ec = matrix_copy(a, m);
+		if (is_ok(ec))
+				ec = matrix_copy(a, MatrixMutView{a.rows, a.cols, kMaxRows, victim->input});
+		if (!is_ok(ec))
+				return ec;
+		ec = lu_factor_in_place(m, &victim->factor, static_cast<std::size_t>(-1), nullptr);
+		if (!is_ok(ec))
+				return ec;
+		victim->hash = h;
+		victim->stamp = ++clock_;
+		*out = &victim->factor;
+		return ErrorCode::Ok;
+}
+
+void LuCache::clear() noexcept {
+		for (std::uint8_t i = 0; i < capacity_; i++)
+				entries_[i].stamp = 0;
+}
+
+ErrorCode EditTracker::init(Arena& arena) noexcept {
+		void* data = arena.allocate(sizeof(Rational) * kMaxRows * kMaxRows, alignof(Rational));
+		if (!data)
+				return ErrorCode::Overflow;
+		storage_ = static_cast<Rational*>(data);
+		known_ = false;
+		refactors_ = 0;
+		return ErrorCode::Ok;
+}
+
+ErrorCode EditTracker::reset(MatrixView a, Arena& scratch) noexcept {
+		if (!storage_ || !a.data)
+				return ErrorCode::Internal;
+
+		refactors_++;
+		known_ = false;
+		square_ = (a.rows == a.cols);
+		det_ = Rational::from_int(0);
+		inv_ = MatrixMutView{a.rows, a.rows, kMaxRows, storage_};
+
+		ArenaScope scratch_scope(scratch);
+		if (square_) {
+				LuFactor f;
+				ErrorCode ec = lu_factor(a, scratch, &f);
+				if (is_ok(ec))
+						ec = lu_det(f, &det_);
+				if (is_ok(ec) && !f.singular)
+						ec = lu_inverse(f, inv_);
+				if (!is_ok(ec))
+						return ec;
+				if (!f.singular) {
+						rank_ = a.rows;
+						known_ = true;
+						return ErrorCode::Ok;
+				}
+		}
+
+		// rank from the nonzero rows of an echelon form
+		MatrixMutView work;
+		ErrorCode ec = matrix_clone(scratch, a, &work);
+		if (is_ok(ec))
+				ec = echelon_apply(work, EchelonKind::Ref, nullptr);
+		if (!is_ok(ec))
+				return ec;
+		rank_ = 0;
+		for (std::uint8_t r = 0; r < work.rows; r++) {
+				for (std::uint8_t c = 0; c < work.cols; c++) {
+						if (!work.at(r, c).is_zero()) {
+								rank_++;
+								break;
+						}
+				}
+		}
+		known_ = true;
+		return ErrorCode::Ok;
+}
+
+ErrorCode EditTracker::sherman_morrison(std::uint8_t r, std::uint8_t c, const Rational& delta) noexcept {
+		const std::uint8_t n = inv_.rows;
+		Rational g;
+		ErrorCode ec = rational_mul(delta, inv_.at(c, r), &g);
+		if (is_ok(ec))
+				ec = rational_add(g, Rational::from_int(1), &g);
+		if (!is_ok(ec))
+				return ec;
+		if (g.is_zero())
+				return ErrorCode::Singular;
+
+		// A^{-1} e_r and e_c^T A^{-1}, scaled by d / g once
+		Rational col[kMaxRows];
+		Rational row[kMaxRows];
+		Rational k;
+		ec = rational_div(delta, g, &k);
+		for (std::uint8_t i = 0; is_ok(ec) && i < n; i++) {
+				ec = rational_mul(k, inv_.at(i, r), &col[i]);
+				row[i] = inv_.at(c, i);
+		}
+		Rational det;
+		if (is_ok(ec))
+				ec = rational_mul(det_, g, &det);
+		if (!is_ok(ec))
+				return ec;
+
+		for (std::uint8_t i = 0; i < n; i++) {
+				if (col[i].is_zero())
+						continue;
+				for (std::uint8_t j = 0; j < n; j++) {
+						if (row[j].is_zero())
+								continue;
+						Rational t;
+						ec = rational_mul(col[i], row[j], &t);
+						if (is_ok(ec))
+								ec = rational_sub(inv_.at(i, j), t, &inv_.at_mut(i, j));
+						if (!is_ok(ec))
+								return ec;
+				}
+		}
+		det_ = det;
+		return ErrorCode::Ok;
+}
+
+ErrorCode EditTracker::update(MatrixView a, std::uint8_t r, std::uint8_t c, const Rational& old_value, Arena& scratch) noexcept {
+		if (!a.data)
+				return ErrorCode::Internal;
+		if (r >= a.rows || c >= a.cols)
+				return ErrorCode::IndexOutOfRange;
+		if (!has_inverse() || inv_.rows != a.rows || a.rows != a.cols)
+				return reset(a, scratch);
+
+		Rational delta;
+		ErrorCode ec = rational_sub(a.at(r, c), old_value, &delta);
+		if (is_ok(ec) && delta.is_zero())
+				return ErrorCode::Ok;
+		if (is_ok(ec))
+				ec = sherman_morrison(r, c, delta);
+		// a singular result or an overflow half way leaves inv_ stale
+		if (!is_ok(ec))
+				return reset(a, scratch);
+		return ErrorCode::Ok;
+}
+
+} // namespace matrix_core
@@ -25,6 +25,7 @@ ErrorCode matrix_alloc(Arena& arena, std::uint8_t rows, std::uint8_t cols, Matri
 		out->rows = rows;
 		out->cols = cols;
 		out->stride = cols;
+		out->col_stride = 1;
 		out->data = data;
 		return ErrorCode::Ok;
 }
@@ -56,6 +57,123 @@ ErrorCode matrix_copy(MatrixView src, MatrixMutView dst) noexcept {
 		return ErrorCode::Ok;
 }
 
+ErrorCode minor_view(MatrixView a, std::uint8_t del_r, std::uint8_t del_c, MinorView* out) noexcept {
+		if (!out || !a.data)
+				return ErrorCode::Internal;
+		if (a.rows <= 1 || a.cols <= 1)
+				return ErrorCode::InvalidDimension;
+		if (del_r >= a.rows || del_c >= a.cols)
+				return ErrorCode::IndexOutOfRange;
+
+		MinorView v;
+		v.base = a;
+		v.rows = static_cast<std::uint8_t>(a.rows - 1);
+		v.cols = static_cast<std::uint8_t>(a.cols - 1);
+		for (std::uint8_t r = 0; r < v.rows; r++)
+				v.row_map[r] = static_cast<std::uint8_t>(r < del_r ? r : r + 1);
+		for (std::uint8_t c = 0; c < v.cols; c++)
+				v.col_map[c] = static_cast<std::uint8_t>(c < del_c ? c : c + 1);
+		*out = v;
+		return ErrorCode::Ok;
+}
+
+ErrorCode matrix_copy(const MinorView& src, MatrixMutView dst) noexcept {
+		if (!src.base.data || !dst.data)
+				return ErrorCode::Internal;
+		if (src.rows != dst.rows || src.cols != dst.cols)
+				return ErrorCode::DimensionMismatch;
+
+		for (std::uint8_t row = 0; row < src.rows; row++) {
+				for (std::uint8_t col = 0; col < src.cols; col++)
+						dst.at_mut(row, col) = src.at(row, col);
+		}
+		return ErrorCode::Ok;
+}
+
+ErrorCode matrix_clone(Arena& arena, const MinorView& src, MatrixMutView* out) noexcept {
+		if (!out)
+				return ErrorCode::Internal;
+		MatrixMutView dst;
+		ErrorCode ec = matrix_alloc(arena, src.rows, src.cols, &dst);
+		if (!is_ok(ec))
+				return ec;
+		ec = matrix_copy(src, dst);
+		if (!is_ok(ec))
+				return ec;
+		*out = dst;
+		return ErrorCode::Ok;
+}
+
+ErrorCode augmented_view(MatrixView left, MatrixView right, AugmentedView* out) noexcept {
+		if (!out || !left.data || !right.data)
+				return ErrorCode::Internal;
+		if (left.rows != right.rows)
+				return ErrorCode::DimensionMismatch;
+		if (left.cols + right.cols > kMaxCols)
+				return ErrorCode::InvalidDimension;
+		*out = AugmentedView{left, right};
+		return ErrorCode::Ok;
+}
+
+ErrorCode matrix_copy(const AugmentedView& src, MatrixMutView dst) noexcept {
+		if (!src.left.data || !dst.data)
+				return ErrorCode::Internal;
+		if (src.rows() != dst.rows || src.cols() != dst.cols)
+				return ErrorCode::DimensionMismatch;
+
+		ErrorCode ec = matrix_copy(src.left, dst.columns(0, src.left.cols));
+		if (!is_ok(ec) || src.right.cols == 0)
+				return ec;
+		return matrix_copy(src.right, dst.columns(src.left.cols, src.right.cols));
+}
+
+namespace {
+// splitmix64 finalizer
+std::uint64_t mix64(std::uint64_t x) noexcept {
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ull;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebull;
+		x ^= x >> 31;
+		return x;
+}
+
+std::uint64_t entry_word(std::uint8_t r, std::uint8_t c, const Rational& v) noexcept {
+		// the position goes through its own mix: added into the value, moving
+		// 2^48 between two cells would leave the sum unchanged
+		const std::uint64_t pos = (static_cast<std::uint64_t>(r) << 8) | c;
+		return mix64(mix64(static_cast<std::uint64_t>(v.num()) ^ mix64(pos)) ^ static_cast<std::uint64_t>(v.den()));
+}
+} // namespace
+
+std::uint64_t content_hash(MatrixView a) noexcept {
+		std::uint64_t h = mix64((static_cast<std::uint64_t>(a.rows) << 8) | a.cols);
+		for (std::uint8_t r = 0; r < a.rows; r++) {
+				for (std::uint8_t c = 0; c < a.cols; c++)
+						h += entry_word(r, c, a.at(r, c));
+		}
+		return h;
+}
+
+std::uint64_t content_hash_update(
+        std::uint64_t h, std::uint8_t r, std::uint8_t c, const Rational& old_value, const Rational& new_value) noexcept {
+		return h - entry_word(r, c, old_value) + entry_word(r, c, new_value);
+}
+
+bool matrix_equal(MatrixView a, MatrixView b) noexcept {
+		if (a.rows != b.rows || a.cols != b.cols)
+				return false;
+		for (std::uint8_t r = 0; r < a.rows; r++) {
+				for (std::uint8_t c = 0; c < a.cols; c++) {
+						const Rational& x = a.at(r, c);
+						const Rational& y = b.at(r, c);
+						if (x.num() != y.num() || x.den() != y.den())
+								return false;
+				}
+		}
+		return true;
+}
+
 void matrix_fill_zero(MatrixMutView m) noexcept {
 		if (!m.data)
 				return;
@@ -65,6 +183,20 @@ void matrix_fill_zero(MatrixMutView m) noexcept {
 		}
 }
 
+bool matrix_is_symmetric(MatrixView m) noexcept {
+		if (!m.data || m.rows != m.cols)
+				return false;
+		for (std::uint8_t row = 1; row < m.rows; row++) {
+				for (std::uint8_t col = 0; col < row; col++) {
+						const Rational& lo = m.at(row, col);
+						const Rational& hi = m.at(col, row);
+						if (lo.num() != hi.num() || lo.den() != hi.den())
+								return false;
+				}
+		}
+		return true;
+}
+
 ErrorCode matrix_add(MatrixView a, MatrixView b, MatrixMutView out) noexcept {
 		if (a.rows != b.rows || a.cols != b.cols)
 				return ErrorCode::DimensionMismatch;
@@ -30,7 +30,7 @@ ErrorCode binary_render_step(const void* vctx, std::size_t index, const StepRend
 				out.latex[0] = '\0';
 
 		if (index == 0) {
-				Writer w{out.latex, out.latex_cap, 0};
+				Writer w = out.latex_writer();
 				ErrorCode ec = w.append("$$C = A");
 				if (!is_ok(ec))
 						return ec;
@@ -55,7 +55,7 @@ ErrorCode binary_render_step(const void* vctx, std::size_t index, const StepRend
 				return ErrorCode::Ok;
 		}
 
-		return latex::write_matrix_display(ctx->result, latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+		return latex::write_matrix_display(ctx->result, latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
 }
 
 constexpr ExplanationVTable kBinaryVTable = {
@@ -85,8 +85,8 @@ ErrorCode unary_render_step(const void* vctx, std::size_t index, const StepRende
 				out.latex[0] = '\0';
 
 		if (index == 0)
-				return latex::write_matrix_display(ctx->a, latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
-		return latex::write_matrix_display(ctx->result, latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+				return latex::write_matrix_display(ctx->a, latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
+		return latex::write_matrix_display(ctx->result, latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
 }
 
 constexpr ExplanationVTable kUnaryVTable = {
@@ -103,6 +103,25 @@ template <typename Ctx> ErrorCode ctx_alloc(Arena& arena, Ctx** out) noexcept {
 		return ErrorCode::Ok;
 }
 
+Error transpose_result(MatrixView a, MatrixView result, Explanation* expl, const ExplainOptions& opts) noexcept {
+		if (opts.enable) {
+				if (!opts.persist || !expl)
+						return {ErrorCode::Internal};
+
+				ArenaScope tx(*opts.persist);
+				UnaryCtx* ctx = nullptr;
+				ErrorCode ec = ctx_alloc(*opts.persist, &ctx);
+				if (!is_ok(ec))
+						return {ec};
+				ctx->a = a;
+				ctx->result = result;
+				*expl = Explanation::make(ctx, &kUnaryVTable);
+				tx.commit();
+		}
+
+		return {};
+}
+
 } // namespace
 
 Error op_add(MatrixView a, MatrixView b, MatrixMutView out, Explanation* expl, const ExplainOptions& opts) noexcept {
@@ -203,23 +222,20 @@ Error op_transpose(MatrixView a, MatrixMutView out, Explanation* expl, const Exp
 				err.a = a.dim();
 				return err;
 		}
+		return transpose_result(a, out.view(), expl, opts);
+}
 
-		if (opts.enable) {
-				if (!opts.persist || !expl)
-						return {ErrorCode::Internal};
-
-				ArenaScope tx(*opts.persist);
-				UnaryCtx* ctx = nullptr;
-				ec = ctx_alloc(*opts.persist, &ctx);
-				if (!is_ok(ec))
-						return {ec};
-				ctx->a = a;
-				ctx->result = out.view();
-				*expl = Explanation::make(ctx, &kUnaryVTable);
-				tx.commit();
+Error op_transpose_view(MatrixView a, MatrixView* out, Explanation* expl, const ExplainOptions& opts) noexcept {
+		if (!out)
+				return {ErrorCode::Internal};
+		if (!a.data) {
+				Error err;
+				err.code = ErrorCode::Internal;
+				err.a = a.dim();
+				return err;
 		}
-
-		return err;
+		*out = a.transposed();
+		return transpose_result(a, *out, expl, opts);
 }
 
 } // namespace matrix_core
@@ -5,50 +5,21 @@
 #include "matrix_core/row_ops.hpp"
 #include "matrix_core/writer.hpp"
 
+#include "matrix_core/adjugate_detail.hpp"
 #include "matrix_core/det_detail.hpp"
 
 #include <new>
 
 namespace matrix_core {
 namespace {
-ErrorCode build_submatrix(MatrixView a, std::uint8_t del_r, std::uint8_t del_c, Arena& arena, MatrixMutView* out) noexcept {
-		if (a.rows != a.cols)
-				return ErrorCode::NotSquare;
-		if (a.rows <= 1)
-				return ErrorCode::InvalidDimension;
-		if (del_r >= a.rows || del_c >= a.cols)
-				return ErrorCode::IndexOutOfRange;
-
-		MatrixMutView sub;
-		ErrorCode ec = matrix_alloc(arena, static_cast<std::uint8_t>(a.rows - 1), static_cast<std::uint8_t>(a.cols - 1), &sub);
-		if (!is_ok(ec))
-				return ec;
-
-		std::uint8_t dest_row = 0;
-		for (std::uint8_t row = 0; row < a.rows; row++) {
-				if (row == del_r)
-						continue;
-				std::uint8_t dest_col = 0;
-				for (std::uint8_t col = 0; col < a.cols; col++) {
-						if (col == del_c)
-								continue;
-						sub.at_mut(dest_row, dest_col) = a.at(row, col);
-						dest_col++;
-				}
-				dest_row++;
-		}
-
-		*out = sub;
-		return ErrorCode::Ok;
-}
-
 struct CofactorElementCtx {
 		MatrixView a;
 		std::uint8_t target_row = 0;
 		std::uint8_t target_col = 0;
 		Rational minor = Rational::from_int(0);
 		Rational cofactor = Rational::from_int(0);
-		std::size_t op_count = 0;
+		std::size_t step_count = 0; // row ops, or OpGroups when compact
+		bool compact = false;
 };
 
 std::size_t cofactor_step_count(const void* vctx) noexcept {
@@ -56,16 +27,12 @@ std::size_t cofactor_step_count(const void* vctx) noexcept {
 		const std::uint8_t n = ctx->a.rows;
 
 		const std::size_t base = (n <= 1) ? 1 : 2;
-		return base + ctx->op_count + 1;
+		return base + ctx->step_count + 1;
 }
 
-ErrorCode write_cofactor_latex(const CofactorElementCtx& ctx, char* out, std::size_t cap) noexcept {
-		if (!out || cap == 0)
-				return ErrorCode::BufferTooSmall;
-
+ErrorCode write_cofactor_latex(const CofactorElementCtx& ctx, Writer w) noexcept {
 		const std::uint32_t exp = static_cast<std::uint32_t>(ctx.target_row + 1u) + static_cast<std::uint32_t>(ctx.target_col + 1u);
 
-		Writer w{out, cap, 0};
 		ErrorCode ec = w.append("$$C_{");
 		if (!is_ok(ec))
 				return ec;
@@ -119,19 +86,23 @@ ErrorCode cofactor_render_step(const void* vctx, std::size_t index, const StepRe
 
 		const std::uint8_t n = ctx->a.rows;
 		const std::size_t base = (n <= 1) ? 1 : 2;
-		const std::size_t total = base + ctx->op_count + 1;
+		const std::size_t total = base + ctx->step_count + 1;
 		if (index >= total)
 				return ErrorCode::StepOutOfRange;
 
 		if (index == 0)
-				return latex::write_matrix_display(ctx->a, latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+				return latex::write_matrix_display(ctx->a, latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
 
 		if (n <= 1) {
-				return write_cofactor_latex(*ctx, out.latex, out.latex_cap);
+				return write_cofactor_latex(*ctx, out.latex_writer());
 		}
 
+		// det_elim replays on the minor in place, so this one is materialized
+		MinorView sub_view;
 		MatrixMutView sub;
-		ErrorCode ec = build_submatrix(ctx->a, ctx->target_row, ctx->target_col, *out.scratch, &sub);
+		ErrorCode ec = minor_view(ctx->a, ctx->target_row, ctx->target_col, &sub_view);
+		if (is_ok(ec))
+				ec = matrix_clone(*out.scratch, sub_view, &sub);
 		if (!is_ok(ec))
 				return ec;
 
@@ -152,32 +123,20 @@ ErrorCode cofactor_render_step(const void* vctx, std::size_t index, const StepRe
 								return ec2;
 				}
 
-				return latex::write_matrix_display(sub.view(), latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+				return latex::write_matrix_display(sub.view(), latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
 		}
 
-		if (index < 1 + ctx->op_count + 1) {
-				// index 2 -> after 1 op, index 3 -> after 2 ops, ...
-				const std::size_t stop_after = index - 1;
-				Rational ignored;
-				RowOp last{};
-				std::size_t ops = 0;
-				ec = detail::det_elim(sub, &ignored, &ops, stop_after, &last);
+		if (index < 1 + ctx->step_count + 1) {
+				// index 2 -> after 1 op (or OpGroup), index 3 -> after 2, ...
+				ec = detail::det_elim_step(sub, index - 1, ctx->compact, out.caption, out.caption_cap);
 				if (!is_ok(ec))
 						return ec;
-				if (ops < stop_after)
-						return ErrorCode::StepOutOfRange;
-
-				if (out.caption) {
-						ec = row_op_caption(last, out.caption, out.caption_cap);
-						if (!is_ok(ec))
-								return ec;
-				}
-				return latex::write_matrix_display(sub.view(), latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+				return latex::write_matrix_display(sub.view(), latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
 		}
 
-		const std::size_t formula_index = index - (base + ctx->op_count);
+		const std::size_t formula_index = index - (base + ctx->step_count);
 		(void)formula_index;
-		return write_cofactor_latex(*ctx, out.latex, out.latex_cap);
+		return write_cofactor_latex(*ctx, out.latex_writer());
 }
 
 constexpr ExplanationVTable kCofactorElementVTable = {
@@ -210,22 +169,34 @@ Error op_cofactor_element(MatrixView a,
 
 		ArenaScratchScope scratch_scope(scratch);
 
+		if (!opts.enable) {
+				// no elimination to replay, take the value from the factor
+				ErrorCode ec = detail::cofactor(a, i, j, scratch, out);
+				if (!is_ok(ec)) {
+						err.code = ec;
+						err.a = a.dim();
+				}
+				return err;
+		}
+
 		Rational minor = Rational::from_int(0);
-		std::size_t op_count = 0;
+		OpObserver obs;
 
 		if (a.rows == 1) {
 				minor = Rational::from_int(1);
-				op_count = 0;
 		} else {
+				MinorView view;
 				MatrixMutView sub;
-				ErrorCode ec = build_submatrix(a, i, j, scratch, &sub);
+				ErrorCode ec = minor_view(a, i, j, &view);
+				if (is_ok(ec))
+						ec = matrix_clone(scratch, view, &sub);
 				if (!is_ok(ec)) {
 						err.code = ec;
 						err.a = a.dim();
 						return err;
 				}
 
-				ec = detail::det_elim(sub, &minor, &op_count, static_cast<std::size_t>(-1), nullptr);
+				ec = detail::det_elim_observed(sub, &minor, &obs);
 				if (!is_ok(ec)) {
 						err.code = ec;
 						err.a = a.dim();
@@ -245,23 +216,23 @@ Error op_cofactor_element(MatrixView a,
 
 		*out = cofactor;
 
-		if (opts.enable) {
-				if (!opts.persist || !expl)
-						return {ErrorCode::Internal};
-				ArenaScope tx(*opts.persist);
-				void* mem = opts.persist->allocate(sizeof(CofactorElementCtx), alignof(CofactorElementCtx));
-				if (!mem)
-						return err_overflow();
-				auto* ctx = new (mem) CofactorElementCtx{};
-				ctx->a = a;
-				ctx->target_row = i;
-				ctx->target_col = j;
-				ctx->minor = minor;
-				ctx->cofactor = cofactor;
-				ctx->op_count = op_count;
-				*expl = Explanation::make(ctx, &kCofactorElementVTable);
-				tx.commit();
-		}
+		// the explanation replays the minor's elimination, so the value comes from it too
+		if (!opts.persist || !expl)
+				return {ErrorCode::Internal};
+		ArenaScope tx(*opts.persist);
+		void* mem = opts.persist->allocate(sizeof(CofactorElementCtx), alignof(CofactorElementCtx));
+		if (!mem)
+				return err_overflow();
+		auto* ctx = new (mem) CofactorElementCtx{};
+		ctx->a = a;
+		ctx->target_row = i;
+		ctx->target_col = j;
+		ctx->minor = minor;
+		ctx->cofactor = cofactor;
+		ctx->compact = (opts.detail == ExplainDetail::Compact);
+		ctx->step_count = obs.steps(ctx->compact);
+		*expl = Explanation::make(ctx, &kCofactorElementVTable);
+		tx.commit();
 
 		return err;
 }
@@ -1,91 +1,112 @@
 #include "matrix_core/ops.hpp"
 
 #if MATRIX_CORE_ENABLE_CRAMER
-#include "matrix_core/det_detail.hpp"
+#include "matrix_core/ldlt_detail.hpp"
+#include "matrix_core/lu.hpp"
 
 namespace matrix_core {
 namespace {
-Error det_of(MatrixView a, Arena& scratch, Rational* out_det) noexcept {
-		if (!out_det)
-				return {ErrorCode::Internal};
-
+// symmetric A: one LDL^T gives both det(A) and x, no per-column dets.
+// returns DivisionByZero when the factorization needs a pivot swap
+ErrorCode symmetric_solve(MatrixView a, MatrixView b, Arena& scratch, MatrixMutView x_out) noexcept {
 		ArenaScratchScope scratch_scope(scratch);
-		MatrixMutView work;
-		ErrorCode ec = matrix_clone(scratch, a, &work);
+		MatrixMutView f;
+		ErrorCode ec = matrix_clone(scratch, a, &f);
 		if (!is_ok(ec))
-				return {ec};
-
-		Rational det;
-		ec = detail::det_elim(work, &det, nullptr, static_cast<std::size_t>(-1), nullptr);
+				return ec;
+		ec = detail::ldlt_elim(f, nullptr, static_cast<std::size_t>(-1), nullptr);
 		if (!is_ok(ec))
-				return {ec};
-
-		*out_det = det;
-		return {};
-}
-
-Error det_replace_col_of(MatrixView a, MatrixView b, std::uint8_t col, Arena& scratch, Rational* out_det) noexcept {
-		if (!out_det)
-				return {ErrorCode::Internal};
+				return ec;
 
-		ArenaScratchScope scratch_scope(scratch);
-		MatrixMutView work;
-		ErrorCode ec = matrix_clone(scratch, a, &work);
-		if (!is_ok(ec))
-				return {ec};
-
-		for (std::uint8_t row = 0; row < a.rows; row++)
-				work.at_mut(row, col) = b.at(row, 0);
-
-		Rational det;
-		ec = detail::det_elim(work, &det, nullptr, static_cast<std::size_t>(-1), nullptr);
+		Rational delta;
+		ec = detail::ldlt_det(f.view(), &delta);
 		if (!is_ok(ec))
-				return {ec};
+				return ec;
+		if (delta.is_zero())
+				return ErrorCode::Singular;
+		return detail::ldlt_solve(f.view(), b, x_out);
+}
 
-		*out_det = det;
+// x from a PLU factor of A. x_i = Δ_i / Δ, so with Δ = det(A) != 0 this is
+// exactly Cramer's rule without forming the n matrices A_i (Δ_i = Δ x_i)
+Error factored_solve(MatrixView a, const LuFactor& f, MatrixView b, MatrixMutView x_out) noexcept {
+		ErrorCode ec = lu_solve(f, b, x_out);
+		if (ec == ErrorCode::Singular)
+				return err_singular(a.dim());
+		if (!is_ok(ec)) {
+				Error err;
+				err.code = ec;
+				err.a = a.dim();
+				return err;
+		}
 		return {};
 }
 
-} // namespace
-
-Error op_cramer_solve(MatrixView a, MatrixView b, Arena& scratch, MatrixMutView x_out) noexcept {
-		Error err;
+Error check_args(MatrixView a, MatrixView b, MatrixMutView x_out) noexcept {
 		if (a.rows != a.cols)
 				return err_not_square(a.dim());
 		if (b.rows != a.rows || b.cols != 1)
 				return err_dim_mismatch(a.dim(), b.dim());
 		if (x_out.rows != a.rows || x_out.cols != 1)
 				return err_dim_mismatch(a.dim(), x_out.dim());
+		return {};
+}
 
-		Rational delta;
-		err = det_of(a, scratch, &delta);
-		if (!is_ok(err)) {
+// ok when solved, otherwise DivisionByZero means "use the general path"
+Error try_symmetric(MatrixView a, MatrixView b, Arena& scratch, MatrixMutView x_out) noexcept {
+		Error err;
+		ErrorCode ec = symmetric_solve(a, b, scratch, x_out);
+		if (ec == ErrorCode::Singular)
+				return err_singular(a.dim());
+		err.code = ec;
+		if (!is_ok(ec))
 				err.a = a.dim();
+		return err;
+}
+
+} // namespace
+
+Error op_cramer_solve(MatrixView a, MatrixView b, Arena& scratch, MatrixMutView x_out) noexcept {
+		Error err = check_args(a, b, x_out);
+		if (!is_ok(err))
 				return err;
-		}
-		if (delta.is_zero())
-				return err_singular(a.dim());
 
-		for (std::uint8_t col = 0; col < a.cols; col++) {
-				Rational delta_i;
-				err = det_replace_col_of(a, b, col, scratch, &delta_i);
-				if (!is_ok(err)) {
-						err.a = a.dim();
+		if (matrix_is_symmetric(a)) {
+				err = try_symmetric(a, b, scratch, x_out);
+				if (err.code != ErrorCode::DivisionByZero)
 						return err;
-				}
+		}
 
-				Rational x_i;
-				ErrorCode ec = rational_div(delta_i, delta, &x_i);
-				if (!is_ok(ec)) {
-						err.code = ec;
-						err.a = a.dim();
-						return err;
-				}
+		ArenaScratchScope scratch_scope(scratch);
+		LuFactor f;
+		ErrorCode ec = lu_factor(a, scratch, &f);
+		if (!is_ok(ec)) {
+				err.code = ec;
+				err.a = a.dim();
+				return err;
+		}
+		return factored_solve(a, f, b, x_out);
+}
 
-				x_out.at_mut(col, 0) = x_i;
+Error op_cramer_solve_cached(MatrixView a, MatrixView b, LuCache& cache, Arena& scratch, MatrixMutView x_out) noexcept {
+		Error err = check_args(a, b, x_out);
+		if (!is_ok(err))
+				return err;
+
+		if (matrix_is_symmetric(a)) {
+				err = try_symmetric(a, b, scratch, x_out);
+				if (err.code != ErrorCode::DivisionByZero)
+						return err;
 		}
 
-		return err;
+		const LuFactor* f = nullptr;
+		ErrorCode ec = cache.get(a, &f);
+		if (!is_ok(ec)) {
+				err.code = ec;
+				err.a = a.dim();
+				return err;
+		}
+		return factored_solve(a, *f, b, x_out);
 }
 
 } // namespace matrix_core
@@ -99,6 +120,15 @@ Error op_cramer_solve(MatrixView a, MatrixView b, Arena& scratch, MatrixMutView
 		(void)x_out;
 		return err_feature_disabled();
 }
+
+Error op_cramer_solve_cached(MatrixView a, MatrixView b, LuCache& cache, Arena& scratch, MatrixMutView x_out) noexcept {
+		(void)a;
+		(void)b;
+		(void)cache;
+		(void)scratch;
+		(void)x_out;
+		return err_feature_disabled();
+}
 } // namespace matrix_core
 
 #endif
@@ -1,11 +1,16 @@
 #include "matrix_core/ops.hpp"
 
 #include "matrix_core/latex.hpp"
+#include "matrix_core/lu.hpp"
 #include "matrix_core/row_ops.hpp"
 #include "matrix_core/writer.hpp"
 
+#include "matrix_core/block_detail.hpp"
 #include "matrix_core/det_detail.hpp"
+#include "matrix_core/ldlt_detail.hpp"
+#include "matrix_core/parallel.hpp"
 
+#include <cstddef>
 #include <new>
 
 namespace matrix_core {
@@ -14,12 +19,15 @@ struct DetCtx {
 		MatrixView input;
 		Rational det = Rational::from_int(0);
 		std::size_t op_count = 0;
+		std::size_t group_count = 0;
+		bool symmetric = false; // steps are LDL^T congruences instead of det_elim row ops
+		bool compact = false;   // one step per OpGroup (never symmetric)
 };
 
 std::size_t det_step_count(const void* vctx) noexcept {
 		const auto* ctx = static_cast<const DetCtx*>(vctx);
-		// 0: start matrix, 1..op_count: after each row op, last: det value
-		return ctx->op_count + 2;
+		// 0: start matrix, 1..: after each row op (or OpGroup), last: det value
+		return (ctx->compact ? ctx->group_count : ctx->op_count) + 2;
 }
 
 ErrorCode det_render_step(const void* vctx, std::size_t index, const StepRenderBuffers& out) noexcept {
@@ -34,15 +42,15 @@ ErrorCode det_render_step(const void* vctx, std::size_t index, const StepRenderB
 		if (out.latex && out.latex_cap)
 				out.latex[0] = '\0';
 
-		const std::size_t total = ctx->op_count + 2;
+		const std::size_t total = det_step_count(ctx);
 		if (index >= total)
 				return ErrorCode::StepOutOfRange;
 
 		if (index == 0)
-				return latex::write_matrix_display(ctx->input, latex::MatrixBrackets::VMatrix, {out.latex, out.latex_cap});
+				return latex::write_matrix_display(ctx->input, latex::MatrixBrackets::VMatrix, out.latex_buffer());
 
 		if (index == total - 1) {
-				Writer w{out.latex, out.latex_cap, 0};
+				Writer w = out.latex_writer();
 				ErrorCode ec = w.append("$$\\det(A) = ");
 				if (!is_ok(ec))
 						return ec;
@@ -57,54 +65,251 @@ ErrorCode det_render_step(const void* vctx, std::size_t index, const StepRenderB
 		if (!is_ok(ec))
 				return ec;
 
-		Rational ignored;
-		RowOp last{};
-		std::size_t ops = 0;
-		ec = detail::det_elim(work, &ignored, &ops, index, &last);
+		if (ctx->symmetric) {
+				RowOp last{};
+				std::size_t ops = 0;
+				ec = detail::ldlt_elim(work, &ops, index, &last);
+				if (!is_ok(ec))
+						return ec;
+				detail::ldlt_mirror_lower(work);
+				if (ops < index)
+						return ErrorCode::StepOutOfRange;
+				if (out.caption) {
+						ec = congruence_op_caption(last, out.caption, out.caption_cap);
+						if (!is_ok(ec))
+								return ec;
+				}
+		} else {
+				ec = detail::det_elim_step(work, index, ctx->compact, out.caption, out.caption_cap);
+				if (!is_ok(ec))
+						return ec;
+		}
+
+		return latex::write_matrix_display(work.view(), latex::MatrixBrackets::VMatrix, out.latex_buffer());
+}
+
+constexpr ExplanationVTable kDetVTable = {
+        .step_count = &det_step_count,
+        .render_step = &det_render_step,
+        .destroy = nullptr,
+};
+
+// block-diagonal (up to permutation) inputs: det(A) = prod det(B_b)
+struct BlockDetCtx {
+		MatrixView input;
+		detail::BlockPartition part;
+		Rational block_det[kMaxRows];
+		std::size_t block_steps[kMaxRows] = {}; // row ops, or OpGroups when compact
+		Rational det = Rational::from_int(0);
+		bool compact = false;
+};
+
+// 1x1 blocks get no steps of their own, their entry shows up in the product
+std::size_t block_det_steps(const BlockDetCtx& ctx, std::uint8_t b) noexcept {
+		return ctx.part.size(b) > 1 ? ctx.block_steps[b] + 2 : 0;
+}
+
+std::size_t block_det_step_count(const void* vctx) noexcept {
+		const auto* ctx = static_cast<const BlockDetCtx*>(vctx);
+		// 0: A, [P A P^T], per block: B_b, row ops, det(B_b), last: product
+		std::size_t total = ctx->part.is_identity() ? 2 : 3;
+		for (std::uint8_t b = 0; b < ctx->part.count; b++)
+				total += block_det_steps(*ctx, b);
+		return total;
+}
+
+ErrorCode block_det_caption(std::uint8_t b, const StepRenderBuffers& out) noexcept {
+		if (!out.caption)
+				return ErrorCode::Ok;
+		Writer w{out.caption, out.caption_cap, 0};
+		ErrorCode ec = w.append("$B_{");
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append_index1(b);
 		if (!is_ok(ec))
 				return ec;
-		if (ops < index)
+		return w.append("}$");
+}
+
+ErrorCode block_det_render_step(const void* vctx, std::size_t index, const StepRenderBuffers& out) noexcept {
+		const auto* ctx = static_cast<const BlockDetCtx*>(vctx);
+		if (!ctx->input.data)
+				return ErrorCode::Internal;
+		if (!out.scratch)
+				return ErrorCode::Internal;
+
+		if (out.caption && out.caption_cap)
+				out.caption[0] = '\0';
+		if (out.latex && out.latex_cap)
+				out.latex[0] = '\0';
+
+		const std::size_t total = block_det_step_count(ctx);
+		if (index >= total)
 				return ErrorCode::StepOutOfRange;
 
-		if (out.caption) {
-				ec = row_op_caption(last, out.caption, out.caption_cap);
+		if (index == 0)
+				return latex::write_matrix_display(ctx->input, latex::MatrixBrackets::VMatrix, out.latex_buffer());
+
+		if (index == total - 1) {
+				Writer w = out.latex_writer();
+				ErrorCode ec = w.append("$$\\det(A) = ");
 				if (!is_ok(ec))
 						return ec;
+				for (std::uint8_t b = 0; b < ctx->part.count; b++) {
+						ec = w.put('(');
+						if (!is_ok(ec))
+								return ec;
+						ec = w.append_rational_latex(ctx->block_det[b]);
+						if (!is_ok(ec))
+								return ec;
+						ec = w.put(')');
+						if (!is_ok(ec))
+								return ec;
+				}
+				ec = w.append(" = ");
+				if (!is_ok(ec))
+						return ec;
+				ec = w.append_rational_latex(ctx->det);
+				if (!is_ok(ec))
+						return ec;
+				return w.append("$$");
 		}
 
-		return latex::write_matrix_display(work.view(), latex::MatrixBrackets::VMatrix, {out.latex, out.latex_cap});
+		std::size_t local = index - 1;
+		if (!ctx->part.is_identity()) {
+				if (local == 0) {
+						MatrixMutView pm;
+						ErrorCode ec = detail::block_permuted(*out.scratch, ctx->input, ctx->part, &pm);
+						if (!is_ok(ec))
+								return ec;
+						if (out.caption) {
+								ec = Writer{out.caption, out.caption_cap, 0}.append("$P A P^{T}$");
+								if (!is_ok(ec))
+										return ec;
+						}
+						return latex::write_matrix_display(pm.view(), latex::MatrixBrackets::VMatrix, out.latex_buffer());
+				}
+				local--;
+		}
+
+		std::uint8_t b = 0;
+		for (; b < ctx->part.count; b++) {
+				const std::size_t steps = block_det_steps(*ctx, b);
+				if (local < steps)
+						break;
+				local -= steps;
+		}
+		if (b >= ctx->part.count)
+				return ErrorCode::Internal;
+
+		if (local == ctx->block_steps[b] + 1) {
+				ErrorCode ec = block_det_caption(b, out);
+				if (!is_ok(ec))
+						return ec;
+				Writer w = out.latex_writer();
+				ec = w.append("$$\\det(B_{");
+				if (!is_ok(ec))
+						return ec;
+				ec = w.append_index1(b);
+				if (!is_ok(ec))
+						return ec;
+				ec = w.append("}) = ");
+				if (!is_ok(ec))
+						return ec;
+				ec = w.append_rational_latex(ctx->block_det[b]);
+				if (!is_ok(ec))
+						return ec;
+				return w.append("$$");
+		}
+
+		MatrixMutView blk;
+		ErrorCode ec = detail::block_gather(*out.scratch, ctx->input, ctx->part, b, &blk);
+		if (!is_ok(ec))
+				return ec;
+
+		if (local == 0) {
+				ec = block_det_caption(b, out);
+				if (!is_ok(ec))
+						return ec;
+				return latex::write_matrix_display(blk.view(), latex::MatrixBrackets::VMatrix, out.latex_buffer());
+		}
+
+		ec = detail::det_elim_step(blk, local, ctx->compact, out.caption, out.caption_cap);
+		if (!is_ok(ec))
+				return ec;
+		return latex::write_matrix_display(blk.view(), latex::MatrixBrackets::VMatrix, out.latex_buffer());
 }
 
-constexpr ExplanationVTable kDetVTable = {
-        .step_count = &det_step_count,
-        .render_step = &det_render_step,
+constexpr ExplanationVTable kBlockDetVTable = {
+        .step_count = &block_det_step_count,
+        .render_step = &block_det_render_step,
         .destroy = nullptr,
 };
 
-} // namespace
+struct BlockDetTasks {
+		MatrixMutView blocks[kMaxRows];
+		Rational det[kMaxRows];
+		OpObserver obs[kMaxRows];
+		ErrorCode ec[kMaxRows] = {};
+};
 
-Error op_det(MatrixView a, Arena& scratch, Rational* out, Explanation* expl, const ExplainOptions& opts) noexcept {
+void block_det_task(void* vctx, std::uint8_t b) noexcept {
+		auto* t = static_cast<BlockDetTasks*>(vctx);
+		t->ec[b] = detail::det_elim_observed(t->blocks[b], &t->det[b], &t->obs[b]);
+}
+
+Error block_det(MatrixView a, const detail::BlockPartition& part, Arena& scratch, Rational* out, Explanation* expl,
+                const ExplainOptions& opts) noexcept {
 		Error err;
-		if (!out)
-				return {ErrorCode::Internal};
-		if (a.rows != a.cols)
-				return err_not_square(a.dim());
+		// each block gets its own copy so the eliminations are independent
+		BlockDetTasks tasks;
+		for (std::uint8_t b = 0; b < part.count; b++) {
+				ErrorCode ec = detail::block_gather(scratch, a, part, b, &tasks.blocks[b]);
+				if (!is_ok(ec))
+						return {ec};
+		}
+		detail::parallel_for(part.count, &block_det_task, &tasks);
 
-		ArenaScratchScope scratch_scope(scratch);
-		MatrixMutView work;
-		ErrorCode ec = matrix_clone(scratch, a, &work);
-		if (!is_ok(ec))
-				return {ec};
+		Rational det = Rational::from_int(1);
+		for (std::uint8_t b = 0; b < part.count; b++) {
+				ErrorCode ec = tasks.ec[b];
+				if (is_ok(ec))
+						ec = rational_mul(det, tasks.det[b], &det);
+				if (!is_ok(ec)) {
+						err.code = ec;
+						err.a = a.dim();
+						return err;
+				}
+		}
 
-		Rational det;
-		std::size_t op_count = 0;
-		ec = detail::det_elim(work, &det, &op_count, static_cast<std::size_t>(-1), nullptr);
-		if (!is_ok(ec)) {
-				err.code = ec;
-				err.a = a.dim();
-				return err;
+		*out = det;
+
+		if (opts.enable) {
+				if (!opts.persist || !expl)
+						return {ErrorCode::Internal};
+
+				ArenaScope tx(*opts.persist);
+				void* mem = opts.persist->allocate(sizeof(BlockDetCtx), alignof(BlockDetCtx));
+				if (!mem)
+						return {ErrorCode::Overflow};
+				auto* ctx = new (mem) BlockDetCtx{};
+				ctx->input = a;
+				ctx->part = part;
+				ctx->compact = (opts.detail == ExplainDetail::Compact);
+				for (std::uint8_t b = 0; b < part.count; b++) {
+						ctx->block_det[b] = tasks.det[b];
+						ctx->block_steps[b] = tasks.obs[b].steps(ctx->compact);
+				}
+				ctx->det = det;
+				*expl = Explanation::make(ctx, &kBlockDetVTable);
+				tx.commit();
 		}
 
+		return err;
+}
+
+Error det_result(MatrixView a, const Rational& det, std::size_t op_count, std::size_t group_count, bool symmetric, Rational* out,
+                 Explanation* expl, const ExplainOptions& opts) noexcept {
 		*out = det;
 
 		if (opts.enable) {
@@ -119,11 +324,134 @@ Error op_det(MatrixView a, Arena& scratch, Rational* out, Explanation* expl, con
 				ctx->input = a;
 				ctx->det = det;
 				ctx->op_count = op_count;
+				ctx->group_count = group_count;
+				ctx->symmetric = symmetric;
+				ctx->compact = !symmetric && opts.detail == ExplainDetail::Compact;
 				*expl = Explanation::make(ctx, &kDetVTable);
 				tx.commit();
 		}
 
-		return err;
+		return {};
+}
+
+// ExplainOptions::lazy: all det_build needs to rerun the op with steps
+struct DetRecipe {
+		MatrixView input;
+		ExplainOptions opts;
+};
+
+// the op allocates one of the two contexts
+constexpr std::size_t kDetBuildBytes = (sizeof(BlockDetCtx) > sizeof(DetCtx) ? sizeof(BlockDetCtx) : sizeof(DetCtx)) +
+                                       alignof(std::max_align_t);
+
+ErrorCode det_build(const void* vrecipe, Arena& persist, Arena& scratch, Explanation* out) noexcept {
+		const auto* r = static_cast<const DetRecipe*>(vrecipe);
+		ExplainOptions opts = r->opts;
+		opts.persist = &persist;
+		Rational ignored;
+		return op_det(r->input, scratch, &ignored, out, opts).code;
+}
+
+Error det_lazy(MatrixView a, Explanation* expl, const ExplainOptions& opts) noexcept {
+		if (!opts.persist || !expl)
+				return {ErrorCode::Internal};
+
+		ArenaScope tx(*opts.persist);
+		void* mem = opts.persist->allocate(sizeof(DetRecipe), alignof(DetRecipe));
+		if (!mem)
+				return err_overflow();
+		auto* r = new (mem) DetRecipe{a, opts};
+		r->opts.lazy = false;
+		if (!is_ok(Explanation::make_lazy(*opts.persist, r, &det_build, kDetBuildBytes, expl)))
+				return err_overflow();
+		tx.commit();
+		return {};
+}
+
+} // namespace
+
+Error op_det(MatrixView a, Arena& scratch, Rational* out, Explanation* expl, const ExplainOptions& opts) noexcept {
+		Error err;
+		if (!out)
+				return {ErrorCode::Internal};
+		if (a.rows != a.cols)
+				return err_not_square(a.dim());
+
+		if (opts.enable && opts.lazy) {
+				err = op_det(a, scratch, out, nullptr, ExplainOptions{});
+				if (!is_ok(err))
+						return err;
+				return det_lazy(a, expl, opts);
+		}
+
+		ArenaScratchScope scratch_scope(scratch);
+		detail::BlockPartition part;
+		detail::block_partition(a, &part);
+		if (part.count > 1)
+				return block_det(a, part, scratch, out, expl, opts);
+
+		Rational det;
+		std::size_t op_count = 0;
+		ErrorCode ec = ErrorCode::Ok;
+		// compact steps group det_elim's pivot columns, which LDL^T does not replay
+		if (opts.detail == ExplainDetail::Full && matrix_is_symmetric(a)) {
+				// symmetric input: LDL^T touches only the lower triangle
+				MatrixMutView work;
+				ec = matrix_clone(scratch, a, &work);
+				if (is_ok(ec))
+						ec = detail::ldlt_elim(work, &op_count, static_cast<std::size_t>(-1), nullptr);
+				if (is_ok(ec))
+						ec = detail::ldlt_det(work.view(), &det);
+				if (is_ok(ec))
+						return det_result(a, det, op_count, 0, true, out, expl, opts);
+				// DivisionByZero: needs a pivot swap, use the general path
+				if (ec != ErrorCode::DivisionByZero) {
+						err.code = ec;
+						err.a = a.dim();
+						return err;
+				}
+		}
+
+		LuFactor f;
+		ec = lu_factor(a, scratch, &f);
+		if (is_ok(ec))
+				ec = lu_det(f, &det);
+		if (!is_ok(ec)) {
+				err.code = ec;
+				err.a = a.dim();
+				return err;
+		}
+		return det_result(a, det, f.det_ops, f.det_groups, false, out, expl, opts);
+}
+
+Error op_det_cached(MatrixView a, LuCache& cache, Arena& scratch, Rational* out, Explanation* expl, const ExplainOptions& opts) noexcept {
+		Error err;
+		if (!out)
+				return {ErrorCode::Internal};
+		if (a.rows != a.cols)
+				return err_not_square(a.dim());
+
+		// block and symmetric inputs have cheaper dedicated paths
+		detail::BlockPartition part;
+		detail::block_partition(a, &part);
+		if (part.count > 1 || (opts.detail == ExplainDetail::Full && matrix_is_symmetric(a)))
+				return op_det(a, scratch, out, expl, opts);
+
+		const LuFactor* f = nullptr;
+		Rational det;
+		ErrorCode ec = cache.get(a, &f);
+		if (is_ok(ec))
+				ec = lu_det(*f, &det);
+		if (!is_ok(ec)) {
+				err.code = ec;
+				err.a = a.dim();
+				return err;
+		}
+		if (opts.enable && opts.lazy) {
+				*out = det;
+				return det_lazy(a, expl, opts);
+		}
+		return det_result(a, det, f->det_ops, f->det_groups, false, out, expl, opts);
 }
 
 } // namespace matrix_core
@@ -16,12 +16,13 @@ struct DetReplaceColCtx {
 		MatrixView b;
 		std::uint8_t col = 0;
 		Rational det = Rational::from_int(0);
-		std::size_t op_count = 0;
+		std::size_t step_count = 0; // row ops, or OpGroups when compact
+		bool compact = false;
 };
 
 std::size_t det_replace_step_count(const void* vctx) noexcept {
 		const auto* ctx = static_cast<const DetReplaceColCtx*>(vctx);
-		return ctx->op_count + 2;
+		return ctx->step_count + 2;
 }
 
 ErrorCode build_matrix(MatrixView a, MatrixView b, std::uint8_t col, Arena& arena, MatrixMutView* out) noexcept {
@@ -49,7 +50,7 @@ ErrorCode det_replace_render_step(const void* vctx, std::size_t index, const Ste
 		if (out.latex && out.latex_cap)
 				out.latex[0] = '\0';
 
-		const std::size_t total = ctx->op_count + 2;
+		const std::size_t total = ctx->step_count + 2;
 		if (index >= total)
 				return ErrorCode::StepOutOfRange;
 
@@ -59,10 +60,10 @@ ErrorCode det_replace_render_step(const void* vctx, std::size_t index, const Ste
 				return ec;
 
 		if (index == 0)
-				return latex::write_matrix_display(work.view(), latex::MatrixBrackets::VMatrix, {out.latex, out.latex_cap});
+				return latex::write_matrix_display(work.view(), latex::MatrixBrackets::VMatrix, out.latex_buffer());
 
 		if (index == total - 1) {
-				Writer w{out.latex, out.latex_cap, 0};
+				Writer w = out.latex_writer();
 				ErrorCode ec2 = w.append("$$\\det(A_{");
 				if (!is_ok(ec2))
 						return ec2;
@@ -78,22 +79,11 @@ ErrorCode det_replace_render_step(const void* vctx, std::size_t index, const Ste
 				return w.append("$$");
 		}
 
-		Rational ignored;
-		RowOp last{};
-		std::size_t ops = 0;
-		ec = detail::det_elim(work, &ignored, &ops, index, &last);
+		ec = detail::det_elim_step(work, index, ctx->compact, out.caption, out.caption_cap);
 		if (!is_ok(ec))
 				return ec;
-		if (ops < index)
-				return ErrorCode::StepOutOfRange;
-
-		if (out.caption) {
-				ec = row_op_caption(last, out.caption, out.caption_cap);
-				if (!is_ok(ec))
-						return ec;
-		}
 
-		return latex::write_matrix_display(work.view(), latex::MatrixBrackets::VMatrix, {out.latex, out.latex_cap});
+		return latex::write_matrix_display(work.view(), latex::MatrixBrackets::VMatrix, out.latex_buffer());
 }
 
 constexpr ExplanationVTable kDetReplaceColVTable = {
@@ -132,8 +122,8 @@ Error op_det_replace_column(MatrixView a,
 				return {ec};
 
 		Rational det;
-		std::size_t op_count = 0;
-		ec = detail::det_elim(work, &det, &op_count, static_cast<std::size_t>(-1), nullptr);
+		OpObserver obs;
+		ec = detail::det_elim_observed(work, &det, &obs);
 		if (!is_ok(ec)) {
 				err.code = ec;
 				err.a = a.dim();
@@ -154,7 +144,8 @@ Error op_det_replace_column(MatrixView a,
 				ctx->b = b;
 				ctx->col = col;
 				ctx->det = det;
-				ctx->op_count = op_count;
+				ctx->compact = (opts.detail == ExplainDetail::Compact);
+				ctx->step_count = obs.steps(ctx->compact);
 				*expl = Explanation::make(ctx, &kDetReplaceColVTable);
 				tx.commit();
 		}
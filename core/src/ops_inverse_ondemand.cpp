@@ -1,10 +1,15 @@
 #include "matrix_core/ops.hpp"
 
+#include "matrix_core/block_detail.hpp"
 #include "matrix_core/latex.hpp"
+#include "matrix_core/ldlt_detail.hpp"
+#include "matrix_core/lu.hpp"
+#include "matrix_core/parallel.hpp"
 #include "matrix_core/row_ops.hpp"
 #include "matrix_core/row_reduction.hpp"
 #include "matrix_core/writer.hpp"
 
+#include <cstddef>
 #include <new>
 
 namespace matrix_core {
@@ -14,66 +19,118 @@ constexpr bool is_one(const Rational& r) noexcept {
 		return r.num() == 1 && r.den() == 1;
 }
 
-ErrorCode inverse_apply(MatrixMutView aug, std::uint8_t n, OpObserver* obs) noexcept {
-		// aug is n x (2n): [A | I] -> [I | A^{-1}]
-		if (!aug.data)
-				return ErrorCode::Internal;
-		if (aug.rows != n || aug.cols != static_cast<std::uint8_t>(2u * n))
-				return ErrorCode::Internal;
+// [A | I] -> [I | A^{-1}] runs on a single n x n matrix w: every entry of w
+// stands for either the left or the right half of the augmented matrix.
+// column c of w holds (part of) right-half column perm[c], so a row swap only
+// swaps rows of w and two perm entries. a row op that clears left entry
+// (i, k) stores the right entry it creates in the same place (the classic
+// in-place gauss-jordan inversion), so which half an entry belongs to only
+// depends on how far the elimination got
+struct AugmentedSplit {
+		std::uint8_t done = 0;   // columns < done: entries below the diagonal are right-half
+		bool done_above = false; // ... and so are the ones above it
+		std::uint8_t diag = 0;   // diagonal entries of columns < diag are right-half
+		// column being eliminated (kMaxRows = none): rows first..last are right-half
+		std::uint8_t active = kMaxRows;
+		std::uint8_t first = 0;
+		std::uint8_t last = 0;
+};
+
+bool split_is_right(const AugmentedSplit& s, std::uint8_t i, std::uint8_t c) noexcept {
+		if (i == c)
+				return c < s.diag;
+		if (c < s.done)
+				return i > c || s.done_above;
+		if (c == s.active)
+				return i >= s.first && i <= s.last;
+		return false;
+}
+
+void in_place_swap(MatrixMutView w, std::uint8_t* perm, std::uint8_t r1, std::uint8_t r2) noexcept {
+		apply_swap(w, r1, r2);
+		const std::uint8_t t = perm[r1];
+		perm[r1] = perm[r2];
+		perm[r2] = t;
+}
+
+// row k *= s; the diagonal turns right-half, where it was 1 before the scale
+ErrorCode in_place_scale(MatrixMutView w, std::uint8_t k, const Rational& s) noexcept {
+		w.at_mut(k, k) = Rational::from_int(1);
+		return apply_scale(w, k, s);
+}
 
+// row i += f row k, clearing left entry (i, k); r_kk is the right-half entry
+// of row k in w's column k (1 until the row is scaled)
+ErrorCode in_place_addmul(MatrixMutView w, std::uint8_t i, std::uint8_t k, const Rational& f, const Rational& r_kk) noexcept {
+		for (std::uint8_t c = 0; c < w.cols; c++) {
+				if (c == k || w.at(k, c).is_zero())
+						continue;
+				Rational t;
+				ErrorCode ec = rational_mul(w.at(k, c), f, &t);
+				if (!is_ok(ec))
+						return ec;
+				ec = rational_add(w.at(i, c), t, &w.at_mut(i, c));
+				if (!is_ok(ec))
+						return ec;
+		}
+		return rational_mul(f, r_kk, &w.at_mut(i, k));
+}
+
+bool find_pivot(MatrixView w, std::uint8_t col, std::uint8_t* out) noexcept {
+		for (std::uint8_t row = col; row < w.rows; row++) {
+				if (!w.at(row, col).is_zero()) {
+						*out = row;
+						return true;
+				}
+		}
+		return false;
+}
+
+bool report(OpObserver* obs, RowOpKind kind, std::uint8_t target, std::uint8_t source, const Rational& scalar) noexcept {
+		if (!obs)
+				return true;
+		RowOp op;
+		op.kind = kind;
+		op.target_row = target;
+		op.source_row = source;
+		op.scalar = scalar;
+		return obs->on_op(op);
+}
+
+// gauss-jordan: per pivot column swap, scale, then clear every other row.
+// on completion w holds A^{-1} with its columns permuted (see
+// unscramble_columns)
+ErrorCode gauss_jordan_in_place(MatrixMutView w, std::uint8_t* perm, OpObserver* obs) noexcept {
+		const std::uint8_t n = w.rows;
 		for (std::uint8_t pivot = 0; pivot < n; pivot++) {
-				// find pivot row
 				std::uint8_t best_row = pivot;
-				bool found = false;
-				for (std::uint8_t row = pivot; row < n; row++) {
-						if (!aug.at(row, pivot).is_zero()) {
-								best_row = row;
-								found = true;
-								break;
-						}
-				}
-				if (!found)
+				if (!find_pivot(w.view(), pivot, &best_row))
 						return ErrorCode::Singular;
 
-				// swap pivot row into place.
 				if (best_row != pivot) {
-						apply_swap(aug, pivot, best_row);
-						if (obs) {
-								RowOp op;
-								op.kind = RowOpKind::Swap;
-								op.target_row = pivot;
-								op.source_row = best_row;
-								if (!obs->on_op(op))
-										return ErrorCode::Ok;
-						}
+						in_place_swap(w, perm, pivot, best_row);
+						if (!report(obs, RowOpKind::Swap, pivot, best_row, Rational{}))
+								return ErrorCode::Ok;
 				}
 
-				// scale pivot row to make pivot = 1.
-				const Rational pivot_val = aug.at(pivot, pivot);
+				const Rational pivot_val = w.at(pivot, pivot);
 				if (!is_one(pivot_val)) {
 						Rational inv;
 						ErrorCode ec = rational_div(Rational::from_int(1), pivot_val, &inv);
 						if (!is_ok(ec))
 								return ec;
-						ec = apply_scale(aug, pivot, inv);
+						ec = in_place_scale(w, pivot, inv);
 						if (!is_ok(ec))
 								return ec;
-						if (obs) {
-								RowOp op;
-								op.kind = RowOpKind::Scale;
-								op.target_row = pivot;
-								op.scalar = inv;
-								if (!obs->on_op(op))
-										return ErrorCode::Ok;
-						}
+						if (!report(obs, RowOpKind::Scale, pivot, pivot, inv))
+								return ErrorCode::Ok;
 				}
 
-				// eliminate this column for all other rows.
+				const Rational r_kk = w.at(pivot, pivot);
 				for (std::uint8_t row = 0; row < n; row++) {
 						if (row == pivot)
 								continue;
-
-						const Rational entry = aug.at(row, pivot);
+						const Rational entry = w.at(row, pivot);
 						if (entry.is_zero())
 								continue;
 
@@ -81,69 +138,249 @@ ErrorCode inverse_apply(MatrixMutView aug, std::uint8_t n, OpObserver* obs) noex
 						ErrorCode ec = rational_neg(entry, &factor);
 						if (!is_ok(ec))
 								return ec;
+						ec = in_place_addmul(w, row, pivot, factor, r_kk);
+						if (!is_ok(ec))
+								return ec;
+						if (!report(obs, RowOpKind::AddMul, row, pivot, factor))
+								return ErrorCode::Ok;
+				}
+				if (obs && !obs->on_group(pivot, pivot))
+						return ErrorCode::Ok;
+		}
+		return ErrorCode::Ok;
+}
 
-						ec = apply_addmul(aug, row, pivot, factor);
+// split after gauss_jordan_in_place stopped right after op
+AugmentedSplit gauss_jordan_split(const RowOp& op) noexcept {
+		AugmentedSplit s;
+		s.done_above = true;
+		if (op.kind == RowOpKind::AddMul) {
+				s.done = op.source_row;
+				s.diag = static_cast<std::uint8_t>(op.source_row + 1);
+				s.active = op.source_row;
+				s.first = 0;
+				s.last = op.target_row;
+				return s;
+		}
+		s.done = op.target_row;
+		s.diag = static_cast<std::uint8_t>(op.kind == RowOpKind::Scale ? op.target_row + 1 : op.target_row);
+		return s;
+}
+
+// the forward and scale phases of [A | I] -> [U | L^{-1} P] ->
+// [D^{-1} U | D^{-1} L^{-1} P] -> [I | A^{-1}], the row-op side of P A = L U
+// (so the op count follows from the factor; for symmetric inputs without
+// swaps these are the LDL^T ops). the back phase does not fit in place, see
+// factored_back
+ErrorCode factored_forward_in_place(MatrixMutView w, std::uint8_t* perm, OpObserver* obs) noexcept {
+		const std::uint8_t n = w.rows;
+		const Rational one = Rational::from_int(1);
+		for (std::uint8_t pivot = 0; pivot < n; pivot++) {
+				std::uint8_t best_row = pivot;
+				if (!find_pivot(w.view(), pivot, &best_row))
+						return ErrorCode::Singular;
+
+				if (best_row != pivot) {
+						in_place_swap(w, perm, pivot, best_row);
+						if (!report(obs, RowOpKind::Swap, pivot, best_row, Rational{}))
+								return ErrorCode::Ok;
+				}
+
+				const Rational pivot_val = w.at(pivot, pivot);
+				for (std::uint8_t row = static_cast<std::uint8_t>(pivot + 1); row < n; row++) {
+						const Rational entry = w.at(row, pivot);
+						if (entry.is_zero())
+								continue;
+
+						Rational factor;
+						ErrorCode ec = rational_div(entry, pivot_val, &factor);
+						if (!is_ok(ec))
+								return ec;
+						ec = rational_neg(factor, &factor);
 						if (!is_ok(ec))
 								return ec;
+						ec = in_place_addmul(w, row, pivot, factor, one);
+						if (!is_ok(ec))
+								return ec;
+						if (!report(obs, RowOpKind::AddMul, row, pivot, factor))
+								return ErrorCode::Ok;
+				}
+				if (obs && !obs->on_group(pivot, pivot))
+						return ErrorCode::Ok;
+		}
+
+		for (std::uint8_t pivot = 0; pivot < n; pivot++) {
+				const Rational pivot_val = w.at(pivot, pivot);
+				if (is_one(pivot_val))
+						continue;
+				Rational inv;
+				ErrorCode ec = rational_div(one, pivot_val, &inv);
+				if (!is_ok(ec))
+						return ec;
+				ec = in_place_scale(w, pivot, inv);
+				if (!is_ok(ec))
+						return ec;
+				if (!report(obs, RowOpKind::Scale, pivot, pivot, inv))
+						return ErrorCode::Ok;
+		}
+		if (obs)
+				obs->on_group(0, kScaleGroup);
+		return ErrorCode::Ok;
+}
+
+// split after factored_forward_in_place stopped right after op (or ran to
+// the end, op == nullptr)
+AugmentedSplit factored_split(std::uint8_t n, const RowOp* op) noexcept {
+		AugmentedSplit s;
+		if (!op || op->kind == RowOpKind::Scale) {
+				s.done = n;
+				s.diag = op ? static_cast<std::uint8_t>(op->target_row + 1) : n;
+				return s;
+		}
+		if (op->kind == RowOpKind::Swap) {
+				s.done = op->target_row;
+				return s;
+		}
+		s.done = op->source_row;
+		s.active = op->source_row;
+		s.first = static_cast<std::uint8_t>(op->source_row + 1);
+		s.last = op->target_row;
+		return s;
+}
 
-						if (obs) {
-								RowOp op;
-								op.kind = RowOpKind::AddMul;
-								op.target_row = row;
-								op.source_row = pivot;
-								op.scalar = factor;
-								if (!obs->on_op(op))
-										return ErrorCode::Ok;
+// expands w into the two halves of the augmented matrix: w becomes the left
+// half, right (n x n) receives the right half
+void split_augmented(MatrixMutView w, const std::uint8_t* perm, const AugmentedSplit& s, MatrixMutView right) noexcept {
+		const std::uint8_t n = w.rows;
+		for (std::uint8_t c = 0; c < n; c++) {
+				for (std::uint8_t i = 0; i < n; i++) {
+						const Rational unit = Rational::from_int(i == c ? 1 : 0);
+						if (split_is_right(s, i, c)) {
+								right.at_mut(i, perm[c]) = w.at(i, c);
+								w.at_mut(i, c) = unit;
+						} else {
+								right.at_mut(i, perm[c]) = unit;
 						}
 				}
 		}
+}
+
+// back phase on the expanded halves [D^{-1} U | D^{-1} L^{-1} P]: row k's
+// left half is e_k by the time it is used, so each op only clears left (i, k)
+ErrorCode factored_back(MatrixMutView left, MatrixMutView right, OpObserver* obs) noexcept {
+		for (std::uint8_t pivot = left.rows; pivot-- > 1;) {
+				for (std::uint8_t row = 0; row < pivot; row++) {
+						const Rational entry = left.at(row, pivot);
+						if (entry.is_zero())
+								continue;
 
+						Rational factor;
+						ErrorCode ec = rational_neg(entry, &factor);
+						if (!is_ok(ec))
+								return ec;
+						ec = apply_addmul(right, row, pivot, factor);
+						if (!is_ok(ec))
+								return ec;
+						left.at_mut(row, pivot) = Rational::from_int(0);
+						if (!report(obs, RowOpKind::AddMul, row, pivot, factor))
+								return ErrorCode::Ok;
+				}
+				if (obs && !obs->on_group(pivot, pivot))
+						return ErrorCode::Ok;
+		}
 		return ErrorCode::Ok;
 }
 
-ErrorCode build_augmented(MatrixView a, Arena& arena, MatrixMutView* out_aug) noexcept {
-		if (!out_aug)
-				return ErrorCode::Internal;
-		if (!a.data)
-				return ErrorCode::Internal;
-		if (a.rows != a.cols)
-				return ErrorCode::NotSquare;
+// moves column c of w to column perm[c], turning the finished in-place
+// inverse into A^{-1}
+void unscramble_columns(MatrixMutView w, const std::uint8_t* perm) noexcept {
+		std::uint8_t p[kMaxRows];
+		for (std::uint8_t c = 0; c < w.cols; c++)
+				p[c] = perm[c];
+		for (std::uint8_t c = 0; c < w.cols; c++) {
+				while (p[c] != c) {
+						const std::uint8_t t = p[c];
+						for (std::uint8_t r = 0; r < w.rows; r++) {
+								const Rational v = w.at(r, c);
+								w.at_mut(r, c) = w.at(r, t);
+								w.at_mut(r, t) = v;
+						}
+						p[c] = p[t];
+						p[t] = t;
+				}
+		}
+}
 
-		const std::uint8_t n = a.rows;
-		const std::uint8_t cols = static_cast<std::uint8_t>(2u * n);
-		const std::size_t count = static_cast<std::size_t>(n) * static_cast<std::size_t>(cols);
-		void* mem = arena.allocate(sizeof(Rational) * count, alignof(Rational));
-		if (!mem)
-				return ErrorCode::Overflow;
+void identity_perm(std::uint8_t n, std::uint8_t* perm) noexcept {
+		for (std::uint8_t i = 0; i < n; i++)
+				perm[i] = i;
+}
 
-		auto* data = static_cast<Rational*>(mem);
-		for (std::size_t i = 0; i < count; i++)
-				data[i] = Rational::from_int(0);
+// [A | I] for step 0, kept in the host's row fragments for the steps of owner
+// when it has some
+ErrorCode write_initial_augmented(MatrixView a, const void* owner, Arena& scratch, const StepRenderBuffers& out) noexcept {
+		MatrixMutView id;
+		ErrorCode ec = matrix_alloc(scratch, a.rows, a.cols, &id);
+		if (!is_ok(ec))
+				return ec;
+		matrix_fill_zero(id);
+		for (std::uint8_t i = 0; i < a.rows; i++)
+				id.at_mut(i, i) = Rational::from_int(1);
+		if (out.rows)
+				return latex::write_rows_display(
+				        a, id.view(), latex::RowStep{owner, 0, latex::kAllRows}, *out.rows, out.latex_buffer());
+		return latex::write_augmented_matrix_display(a, id.view(), out.latex_buffer());
+}
 
-		MatrixMutView aug;
-		aug.rows = n;
-		aug.cols = cols;
-		aug.stride = cols;
-		aug.data = data;
+ErrorCode symmetric_inverse(MatrixView a, Arena& scratch, MatrixMutView out, std::size_t* op_count, std::size_t* group_count) noexcept {
+		// lower-triangle LDL^T, then n solves against e_col
+		MatrixMutView f;
+		ErrorCode ec = matrix_clone(scratch, a, &f);
+		if (!is_ok(ec))
+				return ec;
+		ec = detail::ldlt_elim(f, nullptr, static_cast<std::size_t>(-1), nullptr);
+		if (!is_ok(ec))
+				return ec;
 
-		for (std::uint8_t row = 0; row < n; row++) {
-				for (std::uint8_t col = 0; col < n; col++)
-						aug.at_mut(row, col) = a.at(row, col);
-				aug.at_mut(row, static_cast<std::uint8_t>(n + row)) = Rational::from_int(1);
+		const std::uint8_t n = a.rows;
+		for (std::uint8_t i = 0; i < n; i++) {
+				if (f.at(i, i).is_zero())
+						return ErrorCode::Singular;
 		}
 
-		*out_aug = aug;
+		MatrixMutView e;
+		ec = matrix_alloc(scratch, n, 1, &e);
+		if (!is_ok(ec))
+				return ec;
+		MatrixMutView x;
+		ec = matrix_alloc(scratch, n, 1, &x);
+		if (!is_ok(ec))
+				return ec;
+
+		for (std::uint8_t col = 0; col < n; col++) {
+				matrix_fill_zero(e);
+				e.at_mut(col, 0) = Rational::from_int(1);
+				ec = detail::ldlt_solve(f.view(), e.view(), x);
+				if (!is_ok(ec))
+						return ec;
+				for (std::uint8_t row = 0; row < n; row++)
+						out.at_mut(row, col) = x.at(row, 0);
+		}
+
+		*op_count = detail::ldlt_inverse_op_count(f.view());
+		*group_count = detail::ldlt_inverse_group_count(f.view());
 		return ErrorCode::Ok;
 }
 
 struct InverseCtx {
 		MatrixView input;
-		std::size_t op_count = 0;
+		std::size_t step_count = 0; // ops, or OpGroups when compact
+		bool compact = false;
 };
 
 std::size_t inverse_step_count(const void* vctx) noexcept {
 		const auto* ctx = static_cast<const InverseCtx*>(vctx);
-		return ctx->op_count + 1;
+		return ctx->step_count + 1;
 }
 
 ErrorCode inverse_render_step(const void* vctx, std::size_t index, const StepRenderBuffers& out) noexcept {
@@ -158,37 +395,51 @@ ErrorCode inverse_render_step(const void* vctx, std::size_t index, const StepRen
 		if (out.latex && out.latex_cap)
 				out.latex[0] = '\0';
 
-		const std::size_t total = ctx->op_count + 1;
+		const std::size_t total = ctx->step_count + 1;
 		if (index >= total)
 				return ErrorCode::StepOutOfRange;
 
-		MatrixMutView aug;
-		ErrorCode ec = build_augmented(ctx->input, *out.scratch, &aug);
+		if (index == 0)
+				return write_initial_augmented(ctx->input, vctx, *out.scratch, out);
+
+		MatrixMutView w;
+		MatrixMutView right;
+		ErrorCode ec = matrix_clone(*out.scratch, ctx->input, &w);
+		if (is_ok(ec))
+				ec = matrix_alloc(*out.scratch, w.rows, w.cols, &right);
 		if (!is_ok(ec))
 				return ec;
 
-		const std::uint8_t n = ctx->input.rows;
-		const MatrixView left{n, n, aug.stride, aug.data};
-		const MatrixView right{n, n, aug.stride, aug.data + n};
-
-		if (index == 0)
-				return latex::write_augmented_matrix_display(left, right, {out.latex, out.latex_cap});
-
+		std::uint8_t perm[kMaxRows];
+		identity_perm(w.rows, perm);
 		OpObserver obs;
-		obs.target = index;
-		ec = inverse_apply(aug, n, &obs);
+		obs.stop_after_step(index, ctx->compact);
+		ec = factored_forward_in_place(w, perm, &obs);
 		if (!is_ok(ec))
 				return ec;
-		if (obs.count < index)
-				return ErrorCode::StepOutOfRange;
+		const bool stopped = obs.stopped();
+		split_augmented(w, perm, factored_split(w.rows, stopped ? &obs.last_op : nullptr), right);
+		if (!stopped) {
+				ec = factored_back(w, right, &obs);
+				if (!is_ok(ec))
+						return ec;
+				if (obs.steps(ctx->compact) < index)
+						return ErrorCode::StepOutOfRange;
+		}
 
 		if (out.caption) {
-				ec = row_op_caption(obs.last_op, out.caption, out.caption_cap);
+				ec = obs.step_caption(ctx->compact, out.caption, out.caption_cap);
 				if (!is_ok(ec))
 						return ec;
 		}
 
-		return latex::write_augmented_matrix_display(left, right, {out.latex, out.latex_cap});
+		if (out.rows) {
+				// a compact step is a whole pivot column's worth of ops
+				const std::uint32_t changed = ctx->compact ? latex::kAllRows : row_op_rows(obs.last_op);
+				return latex::write_rows_display(
+				        w.view(), right.view(), latex::RowStep{vctx, index, changed}, *out.rows, out.latex_buffer());
+		}
+		return latex::write_augmented_matrix_display(w.view(), right.view(), out.latex_buffer());
 }
 
 constexpr ExplanationVTable kInverseVTable = {
@@ -197,27 +448,177 @@ constexpr ExplanationVTable kInverseVTable = {
         .destroy = nullptr,
 };
 
-} // namespace
+// block-diagonal (up to permutation) inputs: A^{-1} = P^T diag(B_b^{-1}) P
+struct BlockInverseCtx {
+		MatrixView input;
+		detail::BlockPartition part;
+		std::size_t block_steps[kMaxRows] = {}; // row ops, or OpGroups when compact
+		bool compact = false;
+};
 
-Error op_inverse(MatrixView a, Arena& scratch, MatrixMutView out, Explanation* expl, const ExplainOptions& opts) noexcept {
-		Error err;
-		if (a.rows != a.cols)
-				return err_not_square(a.dim());
-		if (out.rows != a.rows || out.cols != a.cols)
-				return err_dim_mismatch(a.dim(), out.dim());
+// 1x1 blocks get no steps of their own, 1/a only shows up in the result
+std::size_t block_inverse_steps(const BlockInverseCtx& ctx, std::uint8_t b) noexcept {
+		return ctx.part.size(b) > 1 ? ctx.block_steps[b] + 1 : 0;
+}
 
-		ArenaScratchScope scratch_scope(scratch);
-		MatrixMutView aug;
-		ErrorCode ec = build_augmented(a, scratch, &aug);
-		if (!is_ok(ec)) {
-				err.code = ec;
-				err.a = a.dim();
-				return err;
+std::size_t block_inverse_step_count(const void* vctx) noexcept {
+		const auto* ctx = static_cast<const BlockInverseCtx*>(vctx);
+		// 0: (P A P^T), per block: [B_b | I] then its row ops, last: A^{-1}
+		std::size_t total = 2;
+		for (std::uint8_t b = 0; b < ctx->part.count; b++)
+				total += block_inverse_steps(*ctx, b);
+		return total;
+}
+
+struct BlockInverseTasks {
+		MatrixMutView w[kMaxRows];
+		std::uint8_t perm[kMaxRows][kMaxRows] = {};
+		OpObserver obs[kMaxRows];
+		ErrorCode ec[kMaxRows] = {};
+};
+
+void block_inverse_task(void* vctx, std::uint8_t b) noexcept {
+		auto* t = static_cast<BlockInverseTasks*>(vctx);
+		identity_perm(t->w[b].rows, t->perm[b]);
+		t->ec[b] = gauss_jordan_in_place(t->w[b], t->perm[b], &t->obs[b]);
+		if (is_ok(t->ec[b]))
+				unscramble_columns(t->w[b], t->perm[b]);
+}
+
+// inverts every block of a (each in place on its own copy, so the blocks can
+// run in parallel) and scatters the results into out
+ErrorCode block_inverse_all(MatrixView a, const detail::BlockPartition& part, Arena& scratch, MatrixMutView out,
+                            BlockInverseTasks* tasks) noexcept {
+		for (std::uint8_t b = 0; b < part.count; b++) {
+				ErrorCode ec = detail::block_gather(scratch, a, part, b, &tasks->w[b]);
+				if (!is_ok(ec))
+						return ec;
+		}
+		detail::parallel_for(part.count, &block_inverse_task, tasks);
+
+		for (std::uint8_t b = 0; b < part.count; b++) {
+				if (!is_ok(tasks->ec[b]))
+						return tasks->ec[b];
+				detail::block_scatter(tasks->w[b].view(), part, b, out);
 		}
+		return ErrorCode::Ok;
+}
 
+ErrorCode block_inverse_render_step(const void* vctx, std::size_t index, const StepRenderBuffers& out) noexcept {
+		const auto* ctx = static_cast<const BlockInverseCtx*>(vctx);
+		if (!ctx->input.data)
+				return ErrorCode::Internal;
+		if (!out.scratch)
+				return ErrorCode::Internal;
+
+		if (out.caption && out.caption_cap)
+				out.caption[0] = '\0';
+		if (out.latex && out.latex_cap)
+				out.latex[0] = '\0';
+
+		const std::size_t total = block_inverse_step_count(ctx);
+		if (index >= total)
+				return ErrorCode::StepOutOfRange;
+
+		if (index == 0) {
+				if (ctx->part.is_identity())
+						return latex::write_matrix_display(
+						        ctx->input, latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
+				MatrixMutView pm;
+				ErrorCode ec = detail::block_permuted(*out.scratch, ctx->input, ctx->part, &pm);
+				if (!is_ok(ec))
+						return ec;
+				if (out.caption) {
+						ec = Writer{out.caption, out.caption_cap, 0}.append("$P A P^{T}$");
+						if (!is_ok(ec))
+								return ec;
+				}
+				return latex::write_matrix_display(pm.view(), latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
+		}
+
+		if (index == total - 1) {
+				MatrixMutView inv;
+				ErrorCode ec = matrix_alloc(*out.scratch, ctx->input.rows, ctx->input.cols, &inv);
+				if (!is_ok(ec))
+						return ec;
+				BlockInverseTasks tasks;
+				ec = block_inverse_all(ctx->input, ctx->part, *out.scratch, inv, &tasks);
+				if (!is_ok(ec))
+						return ec;
+				if (out.caption) {
+						ec = Writer{out.caption, out.caption_cap, 0}.append("$A^{-1}$");
+						if (!is_ok(ec))
+								return ec;
+				}
+				return latex::write_matrix_display(inv.view(), latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
+		}
+
+		std::size_t local = index - 1;
+		std::uint8_t b = 0;
+		for (; b < ctx->part.count; b++) {
+				const std::size_t steps = block_inverse_steps(*ctx, b);
+				if (local < steps)
+						break;
+				local -= steps;
+		}
+		if (b >= ctx->part.count)
+				return ErrorCode::Internal;
+
+		MatrixMutView blk;
+		ErrorCode ec = detail::block_gather(*out.scratch, ctx->input, ctx->part, b, &blk);
+		if (!is_ok(ec))
+				return ec;
+		if (local == 0) {
+				if (out.caption) {
+						Writer w{out.caption, out.caption_cap, 0};
+						ec = w.append("$B_{");
+						if (!is_ok(ec))
+								return ec;
+						ec = w.append_index1(b);
+						if (!is_ok(ec))
+								return ec;
+						ec = w.append("}$");
+						if (!is_ok(ec))
+								return ec;
+				}
+				return write_initial_augmented(blk.view(), nullptr, *out.scratch, out);
+		}
+
+		std::uint8_t perm[kMaxRows];
+		identity_perm(blk.rows, perm);
 		OpObserver obs;
-		obs.target = static_cast<std::size_t>(-1);
-		ec = inverse_apply(aug, a.rows, &obs);
+		obs.stop_after_step(local, ctx->compact);
+		ec = gauss_jordan_in_place(blk, perm, &obs);
+		if (!is_ok(ec))
+				return ec;
+		if (obs.steps(ctx->compact) < local)
+				return ErrorCode::StepOutOfRange;
+
+		MatrixMutView right;
+		ec = matrix_alloc(*out.scratch, blk.rows, blk.cols, &right);
+		if (!is_ok(ec))
+				return ec;
+		split_augmented(blk, perm, gauss_jordan_split(obs.last_op), right);
+
+		if (out.caption) {
+				ec = obs.step_caption(ctx->compact, out.caption, out.caption_cap);
+				if (!is_ok(ec))
+						return ec;
+		}
+		return latex::write_augmented_matrix_display(blk.view(), right.view(), out.latex_buffer());
+}
+
+constexpr ExplanationVTable kBlockInverseVTable = {
+        .step_count = &block_inverse_step_count,
+        .render_step = &block_inverse_render_step,
+        .destroy = nullptr,
+};
+
+Error block_inverse(MatrixView a, const detail::BlockPartition& part, Arena& scratch, MatrixMutView out, Explanation* expl,
+                    const ExplainOptions& opts) noexcept {
+		Error err;
+		BlockInverseTasks tasks;
+		ErrorCode ec = block_inverse_all(a, part, scratch, out, &tasks);
 		if (!is_ok(ec)) {
 				if (ec == ErrorCode::Singular)
 						return err_singular(a.dim());
@@ -226,12 +627,28 @@ Error op_inverse(MatrixView a, Arena& scratch, MatrixMutView out, Explanation* e
 				return err;
 		}
 
-		const std::uint8_t n = a.rows;
-		for (std::uint8_t row = 0; row < n; row++) {
-				for (std::uint8_t col = 0; col < n; col++)
-						out.at_mut(row, col) = aug.at(row, static_cast<std::uint8_t>(n + col));
+		if (opts.enable) {
+				if (!opts.persist || !expl)
+						return {ErrorCode::Internal};
+
+				ArenaScope tx(*opts.persist);
+				void* mem = opts.persist->allocate(sizeof(BlockInverseCtx), alignof(BlockInverseCtx));
+				if (!mem)
+						return err_overflow();
+				auto* ctx = new (mem) BlockInverseCtx{};
+				ctx->input = a;
+				ctx->part = part;
+				ctx->compact = (opts.detail == ExplainDetail::Compact);
+				for (std::uint8_t b = 0; b < part.count; b++)
+						ctx->block_steps[b] = tasks.obs[b].steps(ctx->compact);
+				*expl = Explanation::make(ctx, &kBlockInverseVTable);
+				tx.commit();
 		}
 
+		return err;
+}
+
+Error inverse_result(MatrixView a, std::size_t op_count, std::size_t group_count, Explanation* expl, const ExplainOptions& opts) noexcept {
 		if (opts.enable) {
 				if (!opts.persist || !expl)
 						return {ErrorCode::Internal};
@@ -242,12 +659,129 @@ Error op_inverse(MatrixView a, Arena& scratch, MatrixMutView out, Explanation* e
 						return err_overflow();
 				auto* ctx = new (mem) InverseCtx{};
 				ctx->input = a;
-				ctx->op_count = obs.count;
+				ctx->compact = (opts.detail == ExplainDetail::Compact);
+				ctx->step_count = ctx->compact ? group_count : op_count;
 				*expl = Explanation::make(ctx, &kInverseVTable);
 				tx.commit();
 		}
 
+		return {};
+}
+
+Error inverse_error(MatrixView a, ErrorCode ec) noexcept {
+		if (ec == ErrorCode::Singular)
+				return err_singular(a.dim());
+		Error err;
+		err.code = ec;
+		err.a = a.dim();
 		return err;
 }
 
+// op_inverse past its argument checks; scratch is the caller's to clear
+Error inverse_compute(MatrixView a, Arena& scratch, MatrixMutView out, Explanation* expl, const ExplainOptions& opts) noexcept {
+		detail::BlockPartition part;
+		detail::block_partition(a, &part);
+		if (part.count > 1)
+				return block_inverse(a, part, scratch, out, expl, opts);
+
+		std::size_t op_count = 0;
+		std::size_t group_count = 0;
+		ErrorCode ec = ErrorCode::Ok;
+		if (matrix_is_symmetric(a)) {
+				ec = symmetric_inverse(a, scratch, out, &op_count, &group_count);
+				if (is_ok(ec))
+						return inverse_result(a, op_count, group_count, expl, opts);
+				// DivisionByZero: needs a pivot swap, use the general path
+				if (ec != ErrorCode::DivisionByZero)
+						return inverse_error(a, ec);
+		}
+
+		LuFactor f;
+		ec = lu_factor(a, scratch, &f);
+		if (is_ok(ec))
+				ec = lu_inverse(f, out);
+		if (!is_ok(ec))
+				return inverse_error(a, ec);
+		return inverse_result(a, lu_inverse_op_count(f), lu_inverse_group_count(f), expl, opts);
+}
+
+// ExplainOptions::lazy: all inverse_build needs to rerun the op with steps
+struct InverseRecipe {
+		MatrixView input;
+		ExplainOptions opts;
+};
+
+// the op allocates one of the two contexts
+constexpr std::size_t kInverseBuildBytes =
+        (sizeof(BlockInverseCtx) > sizeof(InverseCtx) ? sizeof(BlockInverseCtx) : sizeof(InverseCtx)) + alignof(std::max_align_t);
+
+ErrorCode inverse_build(const void* vrecipe, Arena& persist, Arena& scratch, Explanation* out) noexcept {
+		const auto* r = static_cast<const InverseRecipe*>(vrecipe);
+		ExplainOptions opts = r->opts;
+		opts.persist = &persist;
+		MatrixMutView inv;
+		ErrorCode ec = matrix_alloc(scratch, r->input.rows, r->input.cols, &inv);
+		if (!is_ok(ec))
+				return ec;
+		return inverse_compute(r->input, scratch, inv, out, opts).code;
+}
+
+Error inverse_lazy(MatrixView a, Explanation* expl, const ExplainOptions& opts) noexcept {
+		if (!opts.persist || !expl)
+				return {ErrorCode::Internal};
+
+		ArenaScope tx(*opts.persist);
+		void* mem = opts.persist->allocate(sizeof(InverseRecipe), alignof(InverseRecipe));
+		if (!mem)
+				return err_overflow();
+		auto* r = new (mem) InverseRecipe{a, opts};
+		r->opts.lazy = false;
+		if (!is_ok(Explanation::make_lazy(*opts.persist, r, &inverse_build, kInverseBuildBytes, expl)))
+				return err_overflow();
+		tx.commit();
+		return {};
+}
+
+} // namespace
+
+Error op_inverse(MatrixView a, Arena& scratch, MatrixMutView out, Explanation* expl, const ExplainOptions& opts) noexcept {
+		if (a.rows != a.cols)
+				return err_not_square(a.dim());
+		if (out.rows != a.rows || out.cols != a.cols)
+				return err_dim_mismatch(a.dim(), out.dim());
+
+		ArenaScratchScope scratch_scope(scratch);
+		if (opts.enable && opts.lazy) {
+				const Error err = inverse_compute(a, scratch, out, nullptr, ExplainOptions{});
+				if (!is_ok(err))
+						return err;
+				return inverse_lazy(a, expl, opts);
+		}
+		return inverse_compute(a, scratch, out, expl, opts);
+}
+
+Error op_inverse_cached(MatrixView a, LuCache& cache, Arena& scratch, MatrixMutView out, Explanation* expl,
+                        const ExplainOptions& opts) noexcept {
+		if (a.rows != a.cols)
+				return err_not_square(a.dim());
+		if (out.rows != a.rows || out.cols != a.cols)
+				return err_dim_mismatch(a.dim(), out.dim());
+
+		// block and symmetric inputs have cheaper dedicated paths
+		detail::BlockPartition part;
+		detail::block_partition(a, &part);
+		if (part.count > 1 || matrix_is_symmetric(a))
+				return op_inverse(a, scratch, out, expl, opts);
+
+		const LuFactor* f = nullptr;
+		ErrorCode ec = cache.get(a, &f);
+		if (is_ok(ec))
+				ec = lu_inverse(*f, out);
+		if (!is_ok(ec))
+				return inverse_error(a, ec);
+		if (opts.enable && opts.lazy)
+				return inverse_lazy(a, expl, opts);
+		return inverse_result(a, lu_inverse_op_count(*f), lu_inverse_group_count(*f), expl, opts);
+}
+
 } // namespace matrix_core
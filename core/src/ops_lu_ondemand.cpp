@@ -0,0 +1,155 @@
+#include "matrix_core/ops.hpp"
+
+#include "matrix_core/latex.hpp"
+#include "matrix_core/lu.hpp"
+#include "matrix_core/row_ops.hpp"
+#include "matrix_core/writer.hpp"
+
+#include <new>
+
+namespace matrix_core {
+namespace {
+struct LuCtx {
+		MatrixView input;
+		std::size_t op_count = 0;
+		bool swapped = false; // P != I, gets its own step
+};
+
+std::size_t lu_step_count(const void* vctx) noexcept {
+		const auto* ctx = static_cast<const LuCtx*>(vctx);
+		// 0: A, 1..op_count: U forming, then L, [P]
+		return ctx->op_count + (ctx->swapped ? 3 : 2);
+}
+
+// clears the multipliers a partial factor has stored below the diagonal, so
+// only the U being formed is left
+void lu_clear_multipliers(MatrixMutView m, const RowOp& last) noexcept {
+		const std::uint8_t col = (last.kind == RowOpKind::Swap) ? last.target_row : last.source_row;
+		for (std::uint8_t c = 0; c < col; c++) {
+				for (std::uint8_t r = static_cast<std::uint8_t>(c + 1); r < m.rows; r++)
+						m.at_mut(r, c) = Rational::from_int(0);
+		}
+		if (last.kind != RowOpKind::AddMul)
+				return;
+		for (std::uint8_t r = static_cast<std::uint8_t>(col + 1); r <= last.target_row; r++)
+				m.at_mut(r, col) = Rational::from_int(0);
+}
+
+ErrorCode lu_render_step(const void* vctx, std::size_t index, const StepRenderBuffers& out) noexcept {
+		const auto* ctx = static_cast<const LuCtx*>(vctx);
+		if (!ctx->input.data)
+				return ErrorCode::Internal;
+		if (!out.scratch)
+				return ErrorCode::Internal;
+
+		if (out.caption && out.caption_cap)
+				out.caption[0] = '\0';
+		if (out.latex && out.latex_cap)
+				out.latex[0] = '\0';
+
+		const std::size_t total = lu_step_count(ctx);
+		if (index >= total)
+				return ErrorCode::StepOutOfRange;
+
+		if (index == 0)
+				return latex::write_matrix_display(ctx->input, latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
+
+		MatrixMutView work;
+		ErrorCode ec = matrix_clone(*out.scratch, ctx->input, &work);
+		if (!is_ok(ec))
+				return ec;
+
+		if (index <= ctx->op_count) {
+				LuFactor f;
+				RowOp last{};
+				ec = lu_factor_in_place(work, &f, index, &last);
+				if (!is_ok(ec))
+						return ec;
+				if (f.op_count < index)
+						return ErrorCode::StepOutOfRange;
+				lu_clear_multipliers(work, last);
+
+				if (out.caption) {
+						ec = row_op_caption(last, out.caption, out.caption_cap);
+						if (!is_ok(ec))
+								return ec;
+				}
+				return latex::write_matrix_display(work.view(), latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
+		}
+
+		LuFactor f;
+		ec = lu_factor_in_place(work, &f, static_cast<std::size_t>(-1), nullptr);
+		if (!is_ok(ec))
+				return ec;
+		MatrixMutView shown;
+		ec = matrix_alloc(*out.scratch, work.rows, work.cols, &shown);
+		if (!is_ok(ec))
+				return ec;
+
+		const bool show_l = (index == ctx->op_count + 1);
+		if (show_l)
+				lu_unpack(f, shown, MatrixMutView{}, MatrixMutView{});
+		else
+				lu_unpack(f, MatrixMutView{}, MatrixMutView{}, shown);
+
+		if (out.caption) {
+				ec = Writer{out.caption, out.caption_cap, 0}.append(show_l ? "$L$" : "$P$");
+				if (!is_ok(ec))
+						return ec;
+		}
+		return latex::write_matrix_display(shown.view(), latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
+}
+
+constexpr ExplanationVTable kLuVTable = {
+        .step_count = &lu_step_count,
+        .render_step = &lu_render_step,
+        .destroy = nullptr,
+};
+
+} // namespace
+
+Error op_lu(MatrixView a, Arena& scratch, MatrixMutView l_out, MatrixMutView u_out, MatrixMutView p_out, Explanation* expl,
+            const ExplainOptions& opts) noexcept {
+		Error err;
+		if (a.rows != a.cols)
+				return err_not_square(a.dim());
+		if (l_out.rows != a.rows || l_out.cols != a.cols)
+				return err_dim_mismatch(a.dim(), l_out.dim());
+		if (u_out.rows != a.rows || u_out.cols != a.cols)
+				return err_dim_mismatch(a.dim(), u_out.dim());
+		if (p_out.rows != a.rows || p_out.cols != a.cols)
+				return err_dim_mismatch(a.dim(), p_out.dim());
+
+		ArenaScratchScope scratch_scope(scratch);
+		LuFactor f;
+		ErrorCode ec = lu_factor(a, scratch, &f);
+		if (!is_ok(ec)) {
+				err.code = ec;
+				err.a = a.dim();
+				return err;
+		}
+		lu_unpack(f, l_out, u_out, p_out);
+
+		if (opts.enable) {
+				if (!opts.persist || !expl)
+						return {ErrorCode::Internal};
+
+				ArenaScope tx(*opts.persist);
+				void* mem = opts.persist->allocate(sizeof(LuCtx), alignof(LuCtx));
+				if (!mem)
+						return err_overflow();
+				auto* ctx = new (mem) LuCtx{};
+				ctx->input = a;
+				ctx->op_count = f.op_count;
+				for (std::uint8_t i = 0; i < a.rows; i++) {
+						if (f.perm[i] != i)
+								ctx->swapped = true;
+				}
+				*expl = Explanation::make(ctx, &kLuVTable);
+				tx.commit();
+		}
+
+		return err;
+}
+
+} // namespace matrix_core
@@ -10,19 +10,42 @@ namespace matrix_core {
 namespace {
 
 struct EchelonCtx {
-		MatrixView input;
+		AugmentedView input; // right is empty for a plain matrix
 		EchelonKind kind = EchelonKind::Rref;
-		std::size_t op_count = 0;
+		std::size_t step_count = 0; // row ops, or OpGroups when compact
+		bool compact = false;
 };
 
 std::size_t echelon_step_count(const void* vctx) noexcept {
 		const auto* ctx = static_cast<const EchelonCtx*>(vctx);
-		return ctx->op_count + 1;
+		return ctx->step_count + 1;
+}
+
+// step index of the explanation at owner: left, or [left | right] when right
+// has columns. with host row fragments, only the rows in changed (those the
+// step's op wrote) are formatted again after step index - 1
+ErrorCode write_step_matrix(const void* owner, std::size_t index, std::uint32_t changed, MatrixView left, MatrixView right,
+                            const StepRenderBuffers& out) noexcept {
+		// a factored matrix can change every row with its denominator
+		if (out.rows && (right.cols != 0 || out.style == latex::MatrixStyle::Plain))
+				return latex::write_rows_display(left, right, latex::RowStep{owner, index, changed}, *out.rows, out.latex_buffer());
+		if (right.cols == 0)
+				return latex::write_matrix_display(left, latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
+		return latex::write_augmented_matrix_display(left, right, out.latex_buffer());
+}
+
+// shows m with the bar after the left block when the input was augmented
+ErrorCode write_echelon_matrix(const void* owner, std::size_t index, std::uint32_t changed, const AugmentedView& shape, MatrixView m,
+                               const StepRenderBuffers& out) noexcept {
+		if (shape.right.cols == 0)
+				return write_step_matrix(owner, index, changed, m, MatrixView{}, out);
+		return write_step_matrix(
+		        owner, index, changed, m.columns(0, shape.left.cols), m.columns(shape.left.cols, shape.right.cols), out);
 }
 
 ErrorCode echelon_render_step(const void* vctx, std::size_t index, const StepRenderBuffers& out) noexcept {
 		const auto* ctx = static_cast<const EchelonCtx*>(vctx);
-		if (!ctx->input.data)
+		if (!ctx->input.left.data)
 				return ErrorCode::Internal;
 		if (!out.scratch)
 				return ErrorCode::Internal;
@@ -33,28 +56,32 @@ ErrorCode echelon_render_step(const void* vctx, std::size_t index, const StepRen
 				out.latex[0] = '\0';
 
 		if (index == 0)
-				return latex::write_matrix_display(ctx->input, latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+				return write_step_matrix(vctx, 0, latex::kAllRows, ctx->input.left, ctx->input.right, out);
 
 		MatrixMutView work;
-		ErrorCode ec = matrix_clone(*out.scratch, ctx->input, &work);
+		ErrorCode ec = matrix_alloc(*out.scratch, ctx->input.rows(), ctx->input.cols(), &work);
+		if (is_ok(ec))
+				ec = matrix_copy(ctx->input, work);
 		if (!is_ok(ec))
 				return ec;
 
 		OpObserver obs;
-		obs.target = index; // stop after applying index ops
+		obs.stop_after_step(index, ctx->compact);
 		ec = echelon_apply(work, ctx->kind, &obs);
 		if (!is_ok(ec))
 				return ec;
-		if (obs.count < index)
+		if (obs.steps(ctx->compact) < index)
 				return ErrorCode::StepOutOfRange;
 
 		if (out.caption) {
-				ec = row_op_caption(obs.last_op, out.caption, out.caption_cap);
+				ec = obs.step_caption(ctx->compact, out.caption, out.caption_cap);
 				if (!is_ok(ec))
 						return ec;
 		}
 
-		return latex::write_matrix_display(work.view(), latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+		// a compact step is a whole pivot column's worth of ops
+		const std::uint32_t changed = ctx->compact ? latex::kAllRows : row_op_rows(obs.last_op);
+		return write_echelon_matrix(vctx, index, changed, ctx->input, work.view(), out);
 }
 
 constexpr ExplanationVTable kEchelonVTable = {
@@ -63,23 +90,174 @@ constexpr ExplanationVTable kEchelonVTable = {
         .destroy = nullptr,
 };
 
+struct SolveMultiCtx {
+		MatrixView a;
+		MatrixView b;
+		std::size_t op_count = 0;
+};
+
+std::size_t solve_multi_step_count(const void* vctx) noexcept {
+		const auto* ctx = static_cast<const SolveMultiCtx*>(vctx);
+		return ctx->op_count + 1;
+}
+
+ErrorCode solve_multi_render_step(const void* vctx, std::size_t index, const StepRenderBuffers& out) noexcept {
+		const auto* ctx = static_cast<const SolveMultiCtx*>(vctx);
+		if (!ctx->a.data || !ctx->b.data)
+				return ErrorCode::Internal;
+		if (!out.scratch)
+				return ErrorCode::Internal;
+
+		if (out.caption && out.caption_cap)
+				out.caption[0] = '\0';
+		if (out.latex && out.latex_cap)
+				out.latex[0] = '\0';
+
+		if (index >= solve_multi_step_count(ctx))
+				return ErrorCode::StepOutOfRange;
+		if (index == 0)
+				return write_step_matrix(vctx, 0, latex::kAllRows, ctx->a, ctx->b, out);
+
+		MatrixMutView left;
+		MatrixMutView right;
+		ErrorCode ec = matrix_clone(*out.scratch, ctx->a, &left);
+		if (is_ok(ec))
+				ec = matrix_clone(*out.scratch, ctx->b, &right);
+		if (!is_ok(ec))
+				return ec;
+
+		OpObserver obs;
+		obs.target = index;
+		ec = echelon_apply_split(left, right, EchelonKind::Rref, &obs);
+		if (!is_ok(ec))
+				return ec;
+		if (obs.count < index)
+				return ErrorCode::StepOutOfRange;
+
+		if (out.caption) {
+				ec = row_op_caption(obs.last_op, out.caption, out.caption_cap);
+				if (!is_ok(ec))
+						return ec;
+		}
+		return write_step_matrix(vctx, index, row_op_rows(obs.last_op), left.view(), right.view(), out);
+}
+
+constexpr ExplanationVTable kSolveMultiVTable = {
+        .step_count = &solve_multi_step_count,
+        .render_step = &solve_multi_render_step,
+        .destroy = nullptr,
+};
+
+struct SpacesCtx {
+		MatrixView a;
+		std::size_t op_count = 0;
+		bool show_identity = false;
+};
+
+std::size_t spaces_step_count(const void* vctx) noexcept {
+		const auto* ctx = static_cast<const SpacesCtx*>(vctx);
+		return ctx->op_count + 1;
+}
+
+ErrorCode spaces_render_step(const void* vctx, std::size_t index, const StepRenderBuffers& out) noexcept {
+		const auto* ctx = static_cast<const SpacesCtx*>(vctx);
+		if (!ctx->a.data)
+				return ErrorCode::Internal;
+		if (!out.scratch)
+				return ErrorCode::Internal;
+
+		if (out.caption && out.caption_cap)
+				out.caption[0] = '\0';
+		if (out.latex && out.latex_cap)
+				out.latex[0] = '\0';
+
+		if (index >= spaces_step_count(ctx))
+				return ErrorCode::StepOutOfRange;
+
+		MatrixMutView left;
+		ErrorCode ec = matrix_clone(*out.scratch, ctx->a, &left);
+		if (!is_ok(ec))
+				return ec;
+		MatrixMutView right{};
+		if (ctx->show_identity) {
+				ec = matrix_alloc(*out.scratch, ctx->a.rows, ctx->a.rows, &right);
+				if (!is_ok(ec))
+						return ec;
+				matrix_fill_zero(right);
+				for (std::uint8_t r = 0; r < right.rows; r++)
+						right.at_mut(r, r) = Rational::from_int(1);
+		}
+
+		std::uint32_t changed = latex::kAllRows;
+		if (index > 0) {
+				OpObserver obs;
+				obs.target = index;
+				ec = echelon_apply_split(left, right, EchelonKind::Rref, &obs);
+				if (!is_ok(ec))
+						return ec;
+				if (obs.count < index)
+						return ErrorCode::StepOutOfRange;
+				if (out.caption) {
+						ec = row_op_caption(obs.last_op, out.caption, out.caption_cap);
+						if (!is_ok(ec))
+								return ec;
+				}
+				changed = row_op_rows(obs.last_op);
+		}
+
+		return write_step_matrix(vctx, index, changed, left.view(), ctx->show_identity ? right.view() : MatrixView{}, out);
+}
+
+constexpr ExplanationVTable kSpacesVTable = {
+        .step_count = &spaces_step_count,
+        .render_step = &spaces_render_step,
+        .destroy = nullptr,
+};
+
 } // namespace
 
 Error op_echelon(MatrixView a, EchelonKind kind, MatrixMutView out, Explanation* expl, const ExplainOptions& opts) noexcept {
-		Error err;
-		if (out.rows != a.rows || out.cols != a.cols)
+		return op_echelon_augmented(AugmentedView{a, MatrixView{}}, kind, out, expl, opts);
+}
+
+Error op_echelon_augmented(
+        const AugmentedView& a, EchelonKind kind, MatrixMutView out, Explanation* expl, const ExplainOptions& opts) noexcept {
+		EchelonTask task;
+		Error err = op_echelon_begin(a, kind, out, &task);
+		if (!is_ok(err))
+				return err;
+		return op_echelon_run(&task, static_cast<std::size_t>(-1), expl, opts);
+}
+
+Error op_echelon_begin(const AugmentedView& a, EchelonKind kind, MatrixMutView out, EchelonTask* task) noexcept {
+		if (!task)
+				return {ErrorCode::Internal};
+		if (out.rows != a.rows() || out.cols != a.cols())
 				return {ErrorCode::DimensionMismatch, a.dim(), out.dim()};
 
 		ErrorCode ec = matrix_copy(a, out);
 		if (!is_ok(ec))
 				return {ec};
 
-		OpObserver obs;
-		obs.target = static_cast<std::size_t>(-1);
-		ec = echelon_apply(out, kind, &obs);
+		*task = EchelonTask{};
+		task->input = a;
+		task->kind = kind;
+		task->out = out;
+		return {};
+}
+
+Error op_echelon_run(EchelonTask* task, std::size_t budget, Explanation* expl, const ExplainOptions& opts) noexcept {
+		Error err;
+		if (!task || !task->out.data)
+				return {ErrorCode::Internal};
+
+		task->obs.budget = budget;
+		ErrorCode ec = echelon_resume(task->out, MatrixMutView{}, task->kind, &task->cursor, &task->obs);
+		if (ec == ErrorCode::Pending)
+				return {ec};
 		if (!is_ok(ec)) {
 				err.code = ec;
-				err.a = a.dim();
+				err.a = task->input.dim();
 				return err;
 		}
 
@@ -92,9 +270,10 @@ Error op_echelon(MatrixView a, EchelonKind kind, MatrixMutView out, Explanation*
 				if (!mem)
 						return {ErrorCode::Overflow};
 				auto* ctx = new (mem) EchelonCtx{};
-				ctx->input = a;
-				ctx->kind = kind;
-				ctx->op_count = obs.count;
+				ctx->input = task->input;
+				ctx->kind = task->kind;
+				ctx->compact = (opts.detail == ExplainDetail::Compact);
+				ctx->step_count = task->obs.steps(ctx->compact);
 				*expl = Explanation::make(ctx, &kEchelonVTable);
 				tx.commit();
 		}
@@ -102,4 +281,117 @@ Error op_echelon(MatrixView a, EchelonKind kind, MatrixMutView out, Explanation*
 		return err;
 }
 
+std::uint8_t op_echelon_progress(const EchelonTask& task) noexcept {
+		if (task.cursor.done || task.out.cols == 0)
+				return 100;
+		return static_cast<std::uint8_t>((task.cursor.pivot_col * 100u) / task.out.cols);
+}
+
+Error op_solve_multi(
+        MatrixView a, MatrixView b, Arena& scratch, MatrixMutView x_out, Explanation* expl, const ExplainOptions& opts) noexcept {
+		Error err;
+		if (b.rows != a.rows)
+				return err_dim_mismatch(a.dim(), b.dim());
+		if (x_out.rows != a.cols || x_out.cols != b.cols)
+				return err_dim_mismatch(Dim{a.cols, b.cols}, x_out.dim());
+
+		ArenaScratchScope scratch_scope(scratch);
+		MatrixMutView left;
+		MatrixMutView right;
+		ErrorCode ec = matrix_clone(scratch, a, &left);
+		if (is_ok(ec))
+				ec = matrix_clone(scratch, b, &right);
+		if (!is_ok(ec))
+				return {ec};
+
+		OpObserver obs;
+		ec = echelon_apply_split(left, right, EchelonKind::Rref, &obs);
+		if (!is_ok(ec)) {
+				err.code = ec;
+				err.a = a.dim();
+				return err;
+		}
+
+		// rows past the last pivot are zero in A, so they must be zero in B too
+		std::uint8_t rank = 0;
+		matrix_fill_zero(x_out);
+		for (std::uint8_t r = 0; r < left.rows; r++) {
+				std::uint8_t pc = 0;
+				while (pc < left.cols && left.at(r, pc).is_zero())
+						pc++;
+				if (pc == left.cols)
+						break;
+				for (std::uint8_t j = 0; j < right.cols; j++)
+						x_out.at_mut(pc, j) = right.at(r, j);
+				rank++;
+		}
+		for (std::uint8_t j = 0; j < right.cols; j++) {
+				for (std::uint8_t r = rank; r < right.rows; r++) {
+						if (!right.at(r, j).is_zero()) {
+								err.code = ErrorCode::Inconsistent;
+								err.a = a.dim();
+								err.b = b.dim();
+								err.j = j;
+								return err;
+						}
+				}
+		}
+
+		if (opts.enable) {
+				if (!opts.persist || !expl)
+						return {ErrorCode::Internal};
+
+				ArenaScope tx(*opts.persist);
+				void* mem = opts.persist->allocate(sizeof(SolveMultiCtx), alignof(SolveMultiCtx));
+				if (!mem)
+						return err_overflow();
+				auto* ctx = new (mem) SolveMultiCtx{};
+				ctx->a = a;
+				ctx->b = b;
+				ctx->op_count = obs.count;
+				*expl = Explanation::make(ctx, &kSolveMultiVTable);
+				tx.commit();
+		}
+
+		return err;
+}
+
+Error op_fundamental_spaces(MatrixView a,
+        SpacesCache& cache,
+        Arena& scratch,
+        bool show_identity,
+        const FundamentalSpaces** out,
+        Explanation* expl,
+        const ExplainOptions& opts) noexcept {
+		Error err;
+		if (!out)
+				return {ErrorCode::Internal};
+
+		ArenaScratchScope scratch_scope(scratch);
+		ErrorCode ec = cache.get(a, scratch, out);
+		if (!is_ok(ec)) {
+				err.code = ec;
+				err.a = a.dim();
+				return err;
+		}
+
+		if (opts.enable) {
+				if (!opts.persist || !expl)
+						return {ErrorCode::Internal};
+
+				ArenaScope tx(*opts.persist);
+				void* mem = opts.persist->allocate(sizeof(SpacesCtx), alignof(SpacesCtx));
+				if (!mem)
+						return err_overflow();
+				auto* ctx = new (mem) SpacesCtx{};
+				ctx->a = a;
+				ctx->op_count = (*out)->op_count;
+				ctx->show_identity = show_identity;
+				*expl = Explanation::make(ctx, &kSpacesVTable);
+				tx.commit();
+		}
+
+		return err;
+}
+
 } // namespace matrix_core
@@ -215,7 +215,7 @@ ErrorCode dot_render_step(const void* vctx, std::size_t index, const StepRenderB
 		if (out.latex && out.latex_cap)
 				out.latex[0] = '\0';
 
-		Writer w{out.latex, out.latex_cap, 0};
+		Writer w = out.latex_writer();
 		ErrorCode ec = w.append("$$u\\cdot v = ");
 		if (!is_ok(ec))
 				return ec;
@@ -286,7 +286,7 @@ ErrorCode cross_render_step(const void* vctx, std::size_t index, const StepRende
 				out.latex[0] = '\0';
 
 		if (index == 0) {
-				Writer w{out.latex, out.latex_cap, 0};
+				Writer w = out.latex_writer();
 				ErrorCode ec = w.append(
 				        "$$u\\times v = \\begin{bmatrix}u_2 v_3 - u_3 v_2 \\\\ u_3 v_1 - u_1 v_3 \\\\ u_1 v_2 - u_2 v_1\\end{bmatrix}$$");
 				return ec;
@@ -308,7 +308,7 @@ ErrorCode cross_render_step(const void* vctx, std::size_t index, const StepRende
 						return ec;
 		}
 
-		return latex::write_matrix_display(tmp.view(), latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+		return latex::write_matrix_display(tmp.view(), latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
 }
 
 constexpr ExplanationVTable kCrossVTable = {
@@ -345,7 +345,7 @@ ErrorCode proj_render_step(const void* vctx, std::size_t index, const StepRender
 				out.latex[0] = '\0';
 
 		ErrorCode ec = ErrorCode::Ok;
-		Writer latex_w{out.latex, out.latex_cap, 0};
+		Writer latex_w = out.latex_writer();
 
 		if (index == 0) {
 				return latex_w.append("$$proj_v(u) = \\frac{u\\cdot v}{v\\cdot v} v$$");
@@ -422,7 +422,7 @@ ErrorCode proj_render_step(const void* vctx, std::size_t index, const StepRender
 						if (!is_ok(ec))
 								return ec;
 				}
-				return latex::write_matrix_display(proj.view(), latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+				return latex::write_matrix_display(proj.view(), latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
 		}
 
 		if (index == 5) {
@@ -450,7 +450,7 @@ ErrorCode proj_render_step(const void* vctx, std::size_t index, const StepRender
 						if (!is_ok(ec))
 								return ec;
 				}
-				return latex::write_matrix_display(orth.view(), latex::MatrixBrackets::BMatrix, {out.latex, out.latex_cap});
+				return latex::write_matrix_display(orth.view(), latex::MatrixBrackets::BMatrix, out.style, out.latex_buffer());
 		}
 
 		return ErrorCode::Internal;
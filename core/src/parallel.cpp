@@ -0,0 +1,30 @@
+#include "matrix_core/parallel.hpp"
+
+#if MATRIX_CORE_ENABLE_THREADS
+#include <thread>
+#endif
+
+namespace matrix_core::detail {
+
+void parallel_for(std::uint8_t count, ParallelTask task, void* ctx) noexcept {
+		if (!task)
+				return;
+#if MATRIX_CORE_ENABLE_THREADS
+		if (count > 1) {
+				std::thread workers[kMaxRows];
+				const std::uint8_t spawned = count - 1u > kMaxRows ? kMaxRows : static_cast<std::uint8_t>(count - 1u);
+				for (std::uint8_t i = 0; i < spawned; i++)
+						workers[i] = std::thread(task, ctx, static_cast<std::uint8_t>(i + 1u));
+				task(ctx, 0);
+				for (std::uint8_t i = static_cast<std::uint8_t>(spawned + 1u); i < count; i++)
+						task(ctx, i);
+				for (std::uint8_t i = 0; i < spawned; i++)
+						workers[i].join();
+				return;
+		}
+#endif
+		for (std::uint8_t i = 0; i < count; i++)
+				task(ctx, i);
+}
+
+} // namespace matrix_core::detail
@@ -0,0 +1,81 @@
+#include "matrix_core/result_cache.hpp"
+
+#include <utility>
+
+namespace matrix_core {
+namespace {
+void empty_entry(ResultCache::Entry& e) noexcept {
+		e.stamp = 0;
+		e.expl = {};
+		e.payload = nullptr;
+		e.input = {};
+		e.arena.clear();
+}
+} // namespace
+
+ErrorCode ResultCache::add_block(void* mem, std::size_t bytes) noexcept {
+		if (!mem || bytes == 0)
+				return ErrorCode::Internal;
+		if (count_ >= kMaxEntries)
+				return ErrorCode::Overflow;
+		Entry& e = entries_[count_];
+		e.arena.reset(mem, bytes);
+		empty_entry(e);
+		count_++;
+		return ErrorCode::Ok;
+}
+
+void ResultCache::release() noexcept {
+		for (std::uint8_t i = 0; i < count_; i++) {
+				empty_entry(entries_[i]);
+				entries_[i].arena.reset(nullptr, 0);
+		}
+		count_ = 0;
+}
+
+const ResultCache::Entry* ResultCache::find(const ResultKey& key, MatrixView input) noexcept {
+		for (std::uint8_t i = 0; i < count_; i++) {
+				Entry& e = entries_[i];
+				if (e.stamp != 0 && e.key == key && matrix_equal(e.input, input)) {
+						e.stamp = ++clock_;
+						hits_++;
+						return &e;
+				}
+		}
+		return nullptr;
+}
+
+ResultCache::Entry* ResultCache::begin(const ResultKey& key, MatrixView input) noexcept {
+		if (count_ == 0)
+				return nullptr;
+		Entry* victim = &entries_[0];
+		for (std::uint8_t i = 1; i < count_; i++) {
+				if (entries_[i].stamp < victim->stamp)
+						victim = &entries_[i];
+		}
+		misses_++;
+		empty_entry(*victim);
+		MatrixMutView copy;
+		if (!is_ok(matrix_clone(victim->arena, input, &copy))) {
+				victim->arena.clear();
+				return nullptr;
+		}
+		victim->key = key;
+		victim->input = copy.view();
+		return victim;
+}
+
+void ResultCache::commit(Entry* entry, Explanation&& expl, const void* payload) noexcept {
+		if (!entry)
+				return;
+		entry->expl = std::move(expl);
+		entry->payload = payload;
+		entry->stamp = ++clock_;
+}
+
+void ResultCache::clear() noexcept {
+		for (std::uint8_t i = 0; i < count_; i++)
+				empty_entry(entries_[i]);
+}
+
+} // namespace matrix_core
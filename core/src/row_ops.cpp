@@ -3,14 +3,52 @@
 #include "matrix_core/writer.hpp"
 
 namespace matrix_core {
+namespace {
+// X_{t} \leftarrow X_{t} + (k) X_{s}
+ErrorCode append_addmul(Writer& w, char x, const RowOp& op) noexcept {
+		ErrorCode ec = w.put(x);
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append("_{");
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append_index1(op.target_row);
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append("} \\leftarrow ");
+		if (!is_ok(ec))
+				return ec;
+		ec = w.put(x);
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append("_{");
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append_index1(op.target_row);
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append("} + (");
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append_rational_latex(op.scalar);
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append(") ");
+		if (!is_ok(ec))
+				return ec;
+		ec = w.put(x);
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append("_{");
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append_index1(op.source_row);
+		if (!is_ok(ec))
+				return ec;
+		return w.put('}');
+}
 
-ErrorCode row_op_caption(const RowOp& op, char* out, std::size_t cap) noexcept {
-		if (!out || cap == 0)
-				return ErrorCode::BufferTooSmall;
-		out[0] = '\0';
-
-		Writer w{out, cap, 0};
-
+ErrorCode write_row_op_caption(Writer& w, const RowOp& op) noexcept {
 		switch (op.kind) {
 		case RowOpKind::Swap: {
 				ErrorCode ec = w.append("$R_{");
@@ -49,34 +87,94 @@ ErrorCode row_op_caption(const RowOp& op, char* out, std::size_t cap) noexcept {
 				return w.append("}$");
 		}
 		case RowOpKind::AddMul: {
-				ErrorCode ec = w.append("$R_{");
-				if (!is_ok(ec))
-						return ec;
-				ec = w.append_index1(op.target_row);
-				if (!is_ok(ec))
-						return ec;
-				ec = w.append("} \\leftarrow R_{");
-				if (!is_ok(ec))
-						return ec;
-				ec = w.append_index1(op.target_row);
-				if (!is_ok(ec))
-						return ec;
-				ec = w.append("} + (");
-				if (!is_ok(ec))
-						return ec;
-				ec = w.append_rational_latex(op.scalar);
-				if (!is_ok(ec))
-						return ec;
-				ec = w.append(") R_{");
+				ErrorCode ec = w.put('$');
 				if (!is_ok(ec))
 						return ec;
-				ec = w.append_index1(op.source_row);
+				ec = append_addmul(w, 'R', op);
 				if (!is_ok(ec))
 						return ec;
-				return w.append("}$");
+				return w.put('$');
 		}
 		}
 		__builtin_unreachable();
 }
 
+ErrorCode write_congruence_op_caption(Writer& w, const RowOp& op) noexcept {
+		if (op.kind != RowOpKind::AddMul)
+				return write_row_op_caption(w, op);
+
+		ErrorCode ec = w.put('$');
+		if (!is_ok(ec))
+				return ec;
+		ec = append_addmul(w, 'R', op);
+		if (!is_ok(ec))
+				return ec;
+		ec = w.append(", ");
+		if (!is_ok(ec))
+				return ec;
+		ec = append_addmul(w, 'C', op);
+		if (!is_ok(ec))
+				return ec;
+		return w.put('$');
+}
+
+ErrorCode write_op_group_caption(Writer& w, const OpGroup& g) noexcept {
+		ErrorCode ec;
+		if (g.col == kScaleGroup) {
+				ec = w.append("Scale pivot rows");
+		} else {
+				ec = w.append("Pivot $R_{");
+				if (is_ok(ec))
+						ec = w.append_index1(g.row);
+				if (is_ok(ec))
+						ec = w.append("}$, clear $C_{");
+				if (is_ok(ec))
+						ec = w.append_index1(g.col);
+				if (is_ok(ec))
+						ec = w.append("}$");
+		}
+		if (is_ok(ec))
+				ec = w.append(" (");
+		if (is_ok(ec))
+				ec = w.append_u64(g.ops);
+		if (!is_ok(ec))
+				return ec;
+		return w.append(g.ops == 1 ? " op)" : " ops)");
+}
+
+// a caption writer that terminates out once, at the end
+Writer caption_writer(char* out, std::size_t cap) noexcept {
+		Writer w{out, cap, 0};
+		w.defer_terminator = true;
+		return w;
+}
+} // namespace
+
+ErrorCode row_op_caption(const RowOp& op, char* out, std::size_t cap) noexcept {
+		if (!out || cap == 0)
+				return ErrorCode::BufferTooSmall;
+		Writer w = caption_writer(out, cap);
+		const ErrorCode ec = write_row_op_caption(w, op);
+		w.terminate();
+		return ec;
+}
+
+ErrorCode congruence_op_caption(const RowOp& op, char* out, std::size_t cap) noexcept {
+		if (!out || cap == 0)
+				return ErrorCode::BufferTooSmall;
+		Writer w = caption_writer(out, cap);
+		const ErrorCode ec = write_congruence_op_caption(w, op);
+		w.terminate();
+		return ec;
+}
+
+ErrorCode op_group_caption(const OpGroup& g, char* out, std::size_t cap) noexcept {
+		if (!out || cap == 0)
+				return ErrorCode::BufferTooSmall;
+		Writer w = caption_writer(out, cap);
+		const ErrorCode ec = write_op_group_caption(w, g);
+		w.terminate();
+		return ec;
+}
+
 } // namespace matrix_core
@@ -5,84 +5,121 @@
 namespace matrix_core {
 namespace {
 constexpr bool is_one(const Rational& r) noexcept { return r.num() == 1 && r.den() == 1; }
+
+ErrorCode scale_both(MatrixMutView m, MatrixMutView right, std::uint8_t row, const Rational& k) noexcept {
+		ErrorCode ec = apply_scale(m, row, k);
+		if (!is_ok(ec))
+				return ec;
+		return apply_scale(right, row, k);
+}
+
+enum class Emit : std::uint8_t {
+		Go,
+		Stop,  // obs->target reached
+		Yield, // obs->budget used up
+};
+
+Emit emit(OpObserver* obs, const RowOp& op) noexcept {
+		if (!obs)
+				return Emit::Go;
+		if (!obs->on_op(op))
+				return Emit::Stop;
+		return (obs->budget == 0) ? Emit::Yield : Emit::Go;
+}
 } // namespace
 
 ErrorCode echelon_apply(MatrixMutView m, EchelonKind kind, OpObserver* obs) noexcept {
+		return echelon_apply_split(m, MatrixMutView{}, kind, obs);
+}
+
+ErrorCode echelon_apply_split(MatrixMutView m, MatrixMutView right, EchelonKind kind, OpObserver* obs) noexcept {
+		EchelonCursor cur;
+		const ErrorCode ec = echelon_resume(m, right, kind, &cur, obs);
+		return (ec == ErrorCode::Pending) ? ErrorCode::Ok : ec;
+}
+
+ErrorCode echelon_resume(MatrixMutView m, MatrixMutView right, EchelonKind kind, EchelonCursor* cur, OpObserver* obs) noexcept {
+		if (!cur)
+				return ErrorCode::Internal;
+		if (obs && obs->budget == 0 && !cur->done)
+				return ErrorCode::Pending;
 		const std::uint8_t rows = m.rows;
 		const std::uint8_t cols = m.cols;
 
-		std::uint8_t pivot_row = 0;
-		for (std::uint8_t pivot_col = 0; pivot_col < cols && pivot_row < rows; pivot_col++) {
-				// Find pivot row.
-				std::uint8_t best_row = pivot_row;
-				bool found = false;
-				for (std::uint8_t row = pivot_row; row < rows; row++) {
-						if (!m.at(row, pivot_col).is_zero()) {
-								best_row = row;
-								found = true;
-								break;
-						}
+		while (!cur->done) {
+				if (cur->pivot_col >= cols || cur->pivot_row >= rows) {
+						cur->done = true;
+						break;
 				}
-				if (!found)
-						continue;
+				const std::uint8_t pivot_row = cur->pivot_row;
+				const std::uint8_t pivot_col = cur->pivot_col;
+
+				if (cur->phase == 0) {
+						// Find pivot row.
+						std::uint8_t best_row = pivot_row;
+						bool found = false;
+						for (std::uint8_t row = pivot_row; row < rows; row++) {
+								if (!m.at(row, pivot_col).is_zero()) {
+										best_row = row;
+										found = true;
+										break;
+								}
+						}
+						if (!found) {
+								cur->pivot_col++;
+								continue;
+						}
 
-				if (best_row != pivot_row) {
-						apply_swap(m, pivot_row, best_row);
-						if (obs) {
+						cur->phase = 1;
+						if (best_row != pivot_row) {
+								apply_swap(m, pivot_row, best_row);
+								apply_swap(right, pivot_row, best_row);
 								RowOp op;
 								op.kind = RowOpKind::Swap;
 								op.target_row = pivot_row;
 								op.source_row = best_row;
-								if (!obs->on_op(op))
-										return ErrorCode::Ok;
+								const Emit e = emit(obs, op);
+								if (e != Emit::Go)
+										return (e == Emit::Stop) ? ErrorCode::Ok : ErrorCode::Pending;
 						}
+						continue;
 				}
 
-				// make pivot = 1 for RREF
-				if (kind == EchelonKind::Rref) {
+				if (cur->phase == 1) {
+						cur->phase = 2;
+						cur->row = 0;
 						const Rational pivot = m.at(pivot_row, pivot_col);
-						// avoid emitting no op scale steps when the pivot is already 1
-						if (!is_one(pivot)) {
-								Rational inv;
-								ErrorCode ec = rational_div(Rational::from_int(1), pivot, &inv);
+						RowOp op;
+						op.kind = RowOpKind::Scale;
+						op.target_row = pivot_row;
+						if (kind == EchelonKind::Rref) {
+								// make pivot = 1 for RREF, without emitting a no op scale step
+								// when it already is
+								if (is_one(pivot))
+										continue;
+								ErrorCode ec = rational_div(Rational::from_int(1), pivot, &op.scalar);
 								if (!is_ok(ec))
 										return ec;
-								ec = apply_scale(m, pivot_row, inv);
-								if (!is_ok(ec))
-										return ec;
-								if (obs) {
-										RowOp op;
-										op.kind = RowOpKind::Scale;
-										op.target_row = pivot_row;
-										op.scalar = inv;
-										if (!obs->on_op(op))
-												return ErrorCode::Ok;
-								}
-						}
-				} else {
-						// REF: keep pivots "simple" but normalize sign so leading pivots are
-						// positive. this avoids leaving a pivot at -1 (common after elimination),
-						// which is surprising for users expecting a conventional REF
-						const Rational pivot = m.at(pivot_row, pivot_col);
-
-						if (pivot.num() < 0) {
-								const Rational neg_one = Rational::from_int(-1);
-								ErrorCode ec = apply_scale(m, pivot_row, neg_one);
-								if (!is_ok(ec))
-										return ec;
-								if (obs) {
-										RowOp op;
-										op.kind = RowOpKind::Scale;
-										op.target_row = pivot_row;
-										op.scalar = neg_one;
-										if (!obs->on_op(op))
-												return ErrorCode::Ok;
-								}
+						} else {
+								// REF: keep pivots "simple" but normalize sign so leading pivots are
+								// positive. this avoids leaving a pivot at -1 (common after elimination),
+								// which is surprising for users expecting a conventional REF
+								if (pivot.num() >= 0)
+										continue;
+								op.scalar = Rational::from_int(-1);
 						}
+						ErrorCode ec = scale_both(m, right, pivot_row, op.scalar);
+						if (!is_ok(ec))
+								return ec;
+						const Emit e = emit(obs, op);
+						if (e != Emit::Go)
+								return (e == Emit::Stop) ? ErrorCode::Ok : ErrorCode::Pending;
+						continue;
 				}
 
 				// eliminate
-				for (std::uint8_t row = 0; row < rows; row++) {
+				while (cur->row < rows) {
+						const std::uint8_t row = cur->row++;
 						if (row == pivot_row)
 								continue;
 						if (kind == EchelonKind::Ref && row < pivot_row)
@@ -105,25 +142,29 @@ ErrorCode echelon_apply(MatrixMutView m, EchelonKind kind, OpObserver* obs) noex
 						}
 
 						ec = apply_addmul(m, row, pivot_row, factor);
+						if (is_ok(ec))
+								ec = apply_addmul(right, row, pivot_row, factor);
 						if (!is_ok(ec))
 								return ec;
 
-						if (obs) {
-								RowOp op;
-								op.kind = RowOpKind::AddMul;
-								op.target_row = row;
-								op.source_row = pivot_row;
-								op.scalar = factor;
-								if (!obs->on_op(op))
-										return ErrorCode::Ok;
-						}
+						RowOp op;
+						op.kind = RowOpKind::AddMul;
+						op.target_row = row;
+						op.source_row = pivot_row;
+						op.scalar = factor;
+						const Emit e = emit(obs, op);
+						if (e != Emit::Go)
+								return (e == Emit::Stop) ? ErrorCode::Ok : ErrorCode::Pending;
 				}
 
-				pivot_row++;
+				cur->pivot_row++;
+				cur->pivot_col++;
+				cur->phase = 0;
+				if (obs && !obs->on_group(pivot_row, pivot_col))
+						return ErrorCode::Ok;
 		}
 
 		return ErrorCode::Ok;
 }
 
 } // namespace matrix_core
-
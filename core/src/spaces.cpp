@@ -1,6 +1,11 @@
 #include "matrix_core/spaces.hpp"
 
+#include "matrix_core/lu.hpp"
+#include "matrix_core/ops.hpp"
 #include "matrix_core/rational.hpp"
+#include "matrix_core/row_reduction.hpp"
+
+#include <new>
 
 namespace matrix_core {
 namespace {
@@ -23,6 +28,49 @@ std::uint32_t pivot_mask_from_cols(const std::uint8_t* pivot_cols, std::uint8_t
 		}
 		return mask;
 }
+
+// RREF of [A | I] into left / right, then the compact rows into dst
+ErrorCode reduce_with_identity(MatrixView a, MatrixMutView left, MatrixMutView right, MatrixMutView dst, FundamentalSpaces* out) noexcept {
+		ErrorCode ec = matrix_copy(a, left);
+		if (!is_ok(ec))
+				return ec;
+		matrix_fill_zero(right);
+		for (std::uint8_t r = 0; r < a.rows; r++)
+				right.at_mut(r, r) = Rational::from_int(1);
+
+		OpObserver obs;
+		ec = echelon_apply_split(left, right, EchelonKind::Rref, &obs);
+		if (!is_ok(ec))
+				return ec;
+
+		FundamentalSpaces f;
+		ec = space_info_from_rref(left.view(), a.cols, &f.info);
+		if (!is_ok(ec))
+				return ec;
+		matrix_fill_zero(dst);
+		for (std::uint8_t r = 0; r < a.rows; r++) {
+				const bool from_r = r < f.info.rank;
+				const MatrixMutView src = from_r ? left : right;
+				for (std::uint8_t c = 0; c < src.cols; c++)
+						dst.at_mut(r, c) = src.at(r, c);
+		}
+		f.a = a.dim();
+		f.op_count = obs.count;
+		f.reduced = dst.view();
+		*out = f;
+		return ErrorCode::Ok;
+}
+
+ErrorCode alloc_work(Arena& arena, MatrixView a, MatrixMutView* left, MatrixMutView* right) noexcept {
+		ErrorCode ec = matrix_alloc(arena, a.rows, a.cols, left);
+		if (!is_ok(ec))
+				return ec;
+		return matrix_alloc(arena, a.rows, a.rows, right);
+}
+
+constexpr std::uint8_t reduced_cols(MatrixView a) noexcept {
+		return (a.cols > a.rows) ? a.cols : a.rows;
+}
 } // namespace
 
 ErrorCode space_info_from_rref(MatrixView rref, std::uint8_t var_cols, SpaceInfo* out) noexcept {
@@ -176,5 +224,130 @@ ErrorCode space_null_basis(MatrixView rref, std::uint8_t var_cols, const SpaceIn
 		return ErrorCode::Ok;
 }
 
-} // namespace matrix_core
+ErrorCode space_factor(MatrixView a, Arena& arena, FundamentalSpaces* out) noexcept {
+		if (!out || !a.data)
+				return ErrorCode::Internal;
+		if (a.rows == 0 || a.cols == 0)
+				return ErrorCode::InvalidDimension;
+
+		MatrixMutView dst;
+		ErrorCode ec = matrix_alloc(arena, a.rows, reduced_cols(a), &dst);
+		if (!is_ok(ec))
+				return ec;
+
+		ArenaScope work_scope(arena);
+		MatrixMutView left;
+		MatrixMutView right;
+		ec = alloc_work(arena, a, &left, &right);
+		if (!is_ok(ec))
+				return ec;
+		return reduce_with_identity(a, left, right, dst, out);
+}
+
+ErrorCode space_left_null_basis(const FundamentalSpaces& spaces, Arena& arena, MatrixMutView* out_basis) noexcept {
+		if (!out_basis)
+				return ErrorCode::Internal;
+		if (!spaces.reduced.data)
+				return ErrorCode::Internal;
 
+		const std::uint8_t m = spaces.a.rows;
+		const std::uint8_t rank = spaces.info.rank;
+		if (rank == m) {
+				MatrixMutView z{};
+				ErrorCode ec = matrix_alloc(arena, m, 1, &z);
+				if (!is_ok(ec))
+						return ec;
+				matrix_fill_zero(z);
+				*out_basis = z;
+				return ErrorCode::Ok;
+		}
+
+		// y^T A = 0 for each row y^T of E past the rank
+		MatrixMutView basis{};
+		ErrorCode ec = matrix_alloc(arena, m, static_cast<std::uint8_t>(m - rank), &basis);
+		if (!is_ok(ec))
+				return ec;
+		for (std::uint8_t k = 0; k < basis.cols; k++) {
+				for (std::uint8_t r = 0; r < m; r++)
+						basis.at_mut(r, k) = spaces.reduced.at(static_cast<std::uint8_t>(rank + k), r);
+		}
+
+		*out_basis = basis;
+		return ErrorCode::Ok;
+}
+
+ErrorCode SpacesCache::init(Arena& arena, std::uint8_t capacity) noexcept {
+		entries_ = nullptr;
+		capacity_ = 0;
+		clock_ = 0;
+		hits_ = 0;
+		misses_ = 0;
+		if (capacity == 0)
+				return ErrorCode::Ok;
+
+		void* mem = arena.allocate(sizeof(Entry) * capacity, alignof(Entry));
+		if (!mem)
+				return ErrorCode::Overflow;
+		auto* entries = static_cast<Entry*>(mem);
+		for (std::uint8_t i = 0; i < capacity; i++) {
+				auto* e = new (&entries[i]) Entry{};
+				void* data = arena.allocate(sizeof(Rational) * kMaxRows * kMaxCols, alignof(Rational));
+				void* input = arena.allocate(sizeof(Rational) * kMaxRows * kMaxCols, alignof(Rational));
+				if (!data || !input)
+						return ErrorCode::Overflow;
+				e->storage = static_cast<Rational*>(data);
+				e->input = static_cast<Rational*>(input);
+		}
+		entries_ = entries;
+		capacity_ = capacity;
+		return ErrorCode::Ok;
+}
+
+ErrorCode SpacesCache::get(MatrixView a, Arena& scratch, const FundamentalSpaces** out) noexcept {
+		if (!out || !a.data)
+				return ErrorCode::Internal;
+		if (!entries_)
+				return ErrorCode::Internal;
+		if (a.rows == 0 || a.cols == 0 || a.rows > kMaxRows || reduced_cols(a) > kMaxCols)
+				return ErrorCode::InvalidDimension;
+
+		const std::uint64_t h = content_hash(a);
+		Entry* victim = &entries_[0];
+		for (std::uint8_t i = 0; i < capacity_; i++) {
+				Entry& e = entries_[i];
+				if (e.stamp != 0 && e.hash == h && matrix_equal(MatrixView{a.rows, a.cols, kMaxCols, e.input}, a)) {
+						e.stamp = ++clock_;
+						hits_++;
+						*out = &e.spaces;
+						return ErrorCode::Ok;
+				}
+				if (e.stamp < victim->stamp)
+						victim = &e;
+		}
+
+		misses_++;
+		victim->stamp = 0;
+		ArenaScope work_scope(scratch);
+		MatrixMutView left;
+		MatrixMutView right;
+		ErrorCode ec = alloc_work(scratch, a, &left, &right);
+		if (!is_ok(ec))
+				return ec;
+		const MatrixMutView dst{a.rows, reduced_cols(a), kMaxCols, victim->storage};
+		ec = reduce_with_identity(a, left, right, dst, &victim->spaces);
+		if (is_ok(ec))
+				ec = matrix_copy(a, MatrixMutView{a.rows, a.cols, kMaxCols, victim->input});
+		if (!is_ok(ec))
+				return ec;
+		victim->hash = h;
+		victim->stamp = ++clock_;
+		*out = &victim->spaces;
+		return ErrorCode::Ok;
+}
+
+void SpacesCache::clear() noexcept {
+		for (std::uint8_t i = 0; i < capacity_; i++)
+				entries_[i].stamp = 0;
+}
+
+} // namespace matrix_core
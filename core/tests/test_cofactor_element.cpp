@@ -12,10 +12,12 @@
 #endif
 
 using matrix_core::Arena;
+using matrix_core::ArenaScope;
 using matrix_core::ErrorCode;
 using matrix_core::ExplainOptions;
 using matrix_core::Explanation;
 using matrix_core::MatrixMutView;
+using matrix_core::MatrixView;
 using matrix_core::Rational;
 using matrix_core::Slab;
 using matrix_core::StepRenderBuffers;
@@ -26,6 +28,16 @@ static MatrixMutView mat4(Arena& a) {
 		return m;
 }
 
+static MatrixMutView mat3(Arena& a, const std::int64_t (&vals)[3][3]) {
+		MatrixMutView m;
+		assert(matrix_core::matrix_alloc(a, 3, 3, &m) == ErrorCode::Ok);
+		for (std::uint8_t r = 0; r < 3; r++) {
+				for (std::uint8_t c = 0; c < 3; c++)
+						m.at_mut(r, c) = Rational::from_int(vals[r][c]);
+		}
+		return m;
+}
+
 int main() {
 #if defined(MATRIX_CE_TESTS)
 #ifdef NDEBUG
@@ -93,6 +105,31 @@ int main() {
 		dbg_printf("[test_cofactor_element] after expected cofactors asserts\n");
 #endif
 
+		// the factor path (no steps) and the replayed elimination agree, singular or not
+		{
+				MatrixMutView s = mat3(persist, {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+
+				const MatrixView mats[2] = {a.view(), s.view()};
+				for (const MatrixView m : mats) {
+						for (std::uint8_t r = 0; r < m.rows; r++) {
+								for (std::uint8_t c = 0; c < m.cols; c++) {
+										Rational fast;
+										Rational stepped;
+										Explanation expl;
+										assert(matrix_core::is_ok(matrix_core::op_cofactor_element(m, r, c, scratch, &fast, nullptr, ExplainOptions{})));
+										ArenaScope tx(persist);
+										assert(matrix_core::is_ok(matrix_core::op_cofactor_element(
+										        m, r, c, scratch, &stepped, &expl, ExplainOptions{.enable = true, .persist = &persist})));
+										assert(fast.num() == stepped.num() && fast.den() == stepped.den());
+								}
+						}
+				}
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_cofactor_element] after factor path asserts\n");
+#endif
+
 		// 1x1: cofactor=1.
 		{
 				MatrixMutView one;
@@ -220,5 +257,35 @@ int main() {
 		dbg_printf("[test_cofactor_element] after steps asserts\n");
 #endif
 
+		// Compact detail: the minor's elimination in pivot column steps
+		{
+				Rational cof;
+				Explanation full;
+				Explanation compact;
+				auto err = matrix_core::op_cofactor_element(
+				        a.view(), 1, 0, scratch, &cof, &full, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				err = matrix_core::op_cofactor_element(
+				        a.view(), 1, 0, scratch, &cof, &compact,
+				        ExplainOptions{.enable = true, .persist = &persist, .detail = matrix_core::ExplainDetail::Compact});
+				assert(matrix_core::is_ok(err));
+				assert(cof.num() == -72 && cof.den() == 1);
+				assert(compact.step_count() < full.step_count());
+
+				char caption[128];
+				char latex[512];
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				for (std::size_t i = 0; i < compact.step_count(); i++)
+						assert(compact.render_step(i, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(latex, "$$C_{2,1} = (-1)^{3} M_{2,1} = -72$$") == 0);
+				assert(compact.render_step(2, bufs) == ErrorCode::Ok);
+				assert(std::strncmp(caption, "Pivot", 5) == 0);
+				assert(compact.render_step(compact.step_count(), bufs) == ErrorCode::StepOutOfRange);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_cofactor_element] after compact asserts\n");
+#endif
+
 		return 0;
 }
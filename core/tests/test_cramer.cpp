@@ -19,6 +19,16 @@ using matrix_core::Rational;
 using matrix_core::Slab;
 using matrix_core::StepRenderBuffers;
 
+static MatrixMutView mat3(Arena& a, const std::int64_t (&vals)[3][3]) {
+		MatrixMutView m;
+		assert(matrix_core::matrix_alloc(a, 3, 3, &m) == ErrorCode::Ok);
+		for (std::uint8_t r = 0; r < 3; r++) {
+				for (std::uint8_t c = 0; c < 3; c++)
+						m.at_mut(r, c) = Rational::from_int(vals[r][c]);
+		}
+		return m;
+}
+
 int main() {
 #if defined(MATRIX_CE_TESTS)
 #ifdef NDEBUG
@@ -183,6 +193,64 @@ int main() {
 		dbg_printf("[test_cramer] after det(A_i) steps asserts\n");
 #endif
 
+		// Symmetric A: solved from one LDL^T.
+		{
+				MatrixMutView sa = mat3(persist, {{4, 2, 2}, {2, 5, 3}, {2, 3, 6}});
+				// x = (1, -1, 2)
+				MatrixMutView sb;
+				assert(matrix_core::matrix_alloc(persist, 3, 1, &sb) == ErrorCode::Ok);
+				sb.at_mut(0, 0) = Rational::from_int(6);
+				sb.at_mut(1, 0) = Rational::from_int(3);
+				sb.at_mut(2, 0) = Rational::from_int(11);
+
+				MatrixMutView sx;
+				assert(matrix_core::matrix_alloc(persist, 3, 1, &sx) == ErrorCode::Ok);
+				auto err2 = matrix_core::op_cramer_solve(sa.view(), sb.view(), scratch, sx);
+				assert(matrix_core::is_ok(err2));
+				assert(sx.at(0, 0).num() == 1 && sx.at(0, 0).den() == 1);
+				assert(sx.at(1, 0).num() == -1 && sx.at(1, 0).den() == 1);
+				assert(sx.at(2, 0).num() == 2 && sx.at(2, 0).den() == 1);
+		}
+
+		// Δ_i = Δ x_i from the single factorization, cached factor reused
+		{
+				MatrixMutView pa = mat3(persist, {{0, 2, 1}, {1, 1, 1}, {2, 1, 3}});
+				MatrixMutView pb;
+				assert(matrix_core::matrix_alloc(persist, 3, 1, &pb) == ErrorCode::Ok);
+				pb.at_mut(0, 0) = Rational::from_int(3);
+				pb.at_mut(1, 0) = Rational::from_int(-2);
+				pb.at_mut(2, 0) = Rational::from_int(7);
+
+				matrix_core::LuCache cache;
+				assert(cache.init(persist, 1) == ErrorCode::Ok);
+				MatrixMutView px;
+				assert(matrix_core::matrix_alloc(persist, 3, 1, &px) == ErrorCode::Ok);
+				assert(matrix_core::is_ok(matrix_core::op_cramer_solve_cached(pa.view(), pb.view(), cache, scratch, px)));
+
+				Rational delta;
+				Explanation dexpl;
+				assert(matrix_core::is_ok(matrix_core::op_det_cached(pa.view(), cache, scratch, &delta, &dexpl, ExplainOptions{})));
+				assert(cache.misses() == 1 && cache.hits() == 1);
+				for (std::uint8_t col = 0; col < 3; col++) {
+						Rational delta_i;
+						Rational expect;
+						assert(matrix_core::is_ok(
+						        matrix_core::op_det_replace_column(pa.view(), pb.view(), col, scratch, &delta_i, &dexpl, ExplainOptions{})));
+						assert(matrix_core::rational_mul(delta, px.at(col, 0), &expect) == ErrorCode::Ok);
+						assert(delta_i.num() == expect.num() && delta_i.den() == expect.den());
+				}
+
+				MatrixMutView qx;
+				assert(matrix_core::matrix_alloc(persist, 3, 1, &qx) == ErrorCode::Ok);
+				assert(matrix_core::is_ok(matrix_core::op_cramer_solve(pa.view(), pb.view(), scratch, qx)));
+				for (std::uint8_t r = 0; r < 3; r++)
+						assert(qx.at(r, 0).num() == px.at(r, 0).num() && qx.at(r, 0).den() == px.at(r, 0).den());
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_cramer] after factored solve asserts\n");
+#endif
+
 		// op_cramer_solve error cases.
 		{
 				MatrixMutView ns;
@@ -1,6 +1,8 @@
 #include "matrix_core/matrix_core.hpp"
 
+#include "matrix_core/block_detail.hpp"
 #include "matrix_core/det_detail.hpp"
+#include "matrix_core/ldlt_detail.hpp"
 #include "matrix_core/row_ops.hpp"
 
 #include "test_dbg_ce.hpp"
@@ -31,6 +33,16 @@ static MatrixMutView mat2(Arena& a, std::int64_t a00, std::int64_t a01, std::int
 		return m;
 }
 
+static MatrixMutView mat3(Arena& a, const std::int64_t (&vals)[3][3]) {
+		MatrixMutView m;
+		assert(matrix_core::matrix_alloc(a, 3, 3, &m) == ErrorCode::Ok);
+		for (std::uint8_t r = 0; r < 3; r++) {
+				for (std::uint8_t c = 0; c < 3; c++)
+						m.at_mut(r, c) = Rational::from_int(vals[r][c]);
+		}
+		return m;
+}
+
 int main() {
 #if defined(MATRIX_CE_TESTS)
 #ifdef NDEBUG
@@ -107,6 +119,117 @@ int main() {
 		dbg_printf("[test_det] after det=0 asserts\n");
 #endif
 
+		// Symmetric input: LDL^T congruence steps, ending on D.
+		{
+				Slab slab;
+				assert(slab.init(64 * 1024) == ErrorCode::Ok);
+				Arena persist(slab.data(), slab.size() / 2);
+				Arena scratch(slab.data() + (slab.size() / 2), slab.size() - (slab.size() / 2));
+
+				MatrixMutView a = mat3(persist, {{4, 2, 2}, {2, 5, 3}, {2, 3, 6}});
+				assert(matrix_core::matrix_is_symmetric(a.view()));
+
+				Rational det;
+				Explanation expl;
+				auto err = matrix_core::op_det(a.view(), scratch, &det, &expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				assert(det.num() == 64 && det.den() == 1);
+				// D = diag(4, 4, 4), three congruences
+				assert(expl.step_count() == 5);
+
+				char caption[128];
+				char latex[512];
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				assert(expl.render_step(1, bufs) == ErrorCode::Ok);
+				assert(std::strstr(caption, "R_{2}") != nullptr);
+				assert(std::strstr(caption, "C_{2}") != nullptr);
+
+				char expected[512];
+				MatrixMutView d;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &d) == ErrorCode::Ok);
+				for (std::uint8_t i = 0; i < 3; i++)
+						d.at_mut(i, i) = Rational::from_int(4);
+				assert(matrix_core::latex::write_matrix_display(d.view(), matrix_core::latex::MatrixBrackets::VMatrix,
+				                                                {expected, sizeof(expected)}) == ErrorCode::Ok);
+				assert(expl.render_step(3, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(latex, expected) == 0);
+				assert(expl.render_step(4, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(latex, "$$\\det(A) = 64$$") == 0);
+
+				// Zero pivot over a nonzero column: falls back to det_elim.
+				MatrixMutView p = mat2(persist, 0, 1, 1, 0);
+				err = matrix_core::op_det(p.view(), scratch, &det, &expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				assert(det.num() == -1 && det.den() == 1);
+				assert(expl.render_step(1, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(caption, "$R_{1} <-> R_{2}$") == 0);
+
+				// ldlt_elim leaves D on the diagonal and L^T above it.
+				MatrixMutView f;
+				assert(matrix_core::matrix_clone(persist, a.view(), &f) == ErrorCode::Ok);
+				std::size_t ops = 0;
+				assert(matrix_core::detail::ldlt_elim(f, &ops, static_cast<std::size_t>(-1), nullptr) == ErrorCode::Ok);
+				assert(ops == 3);
+				assert(f.at(0, 1).num() == 1 && f.at(0, 1).den() == 2);
+				assert(f.at(1, 2).num() == 1 && f.at(1, 2).den() == 2);
+				assert(f.at(2, 0).is_zero());
+				assert(matrix_core::detail::ldlt_elim(p, &ops, static_cast<std::size_t>(-1), nullptr) == ErrorCode::DivisionByZero);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_det] after symmetric asserts\n");
+#endif
+
+		// Block-diagonal up to permutation: product of block dets.
+		{
+				Slab slab;
+				assert(slab.init(64 * 1024) == ErrorCode::Ok);
+				Arena persist(slab.data(), slab.size() / 2);
+				Arena scratch(slab.data() + (slab.size() / 2), slab.size() - (slab.size() / 2));
+
+				// indices {1,3} and {2} connect: B_1 = [1 2; 3 4], B_2 = [5]
+				MatrixMutView a = mat3(persist, {{1, 0, 2}, {0, 5, 0}, {3, 0, 4}});
+
+				matrix_core::detail::BlockPartition part;
+				matrix_core::detail::block_partition(a.view(), &part);
+				assert(part.count == 2);
+				assert(part.size(0) == 2 && part.perm[0] == 0 && part.perm[1] == 2);
+				assert(part.size(1) == 1 && part.perm[2] == 1);
+				assert(!part.is_identity());
+
+				Rational det;
+				Explanation expl;
+				auto err = matrix_core::op_det(a.view(), scratch, &det, &expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				assert(det.num() == -10 && det.den() == 1);
+
+				// A, P A P^T, B_1, 1 row op, det(B_1), product
+				assert(expl.step_count() == 6);
+				char caption[128];
+				char latex[512];
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				for (std::size_t i = 0; i < expl.step_count(); i++)
+						assert(expl.render_step(i, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(latex, "$$\\det(A) = (-2)(5) = -10$$") == 0);
+				assert(expl.render_step(2, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(caption, "$B_{1}$") == 0);
+				assert(expl.render_step(4, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(latex, "$$\\det(B_{1}) = -2$$") == 0);
+
+				// Diagonal: every block is 1x1, only A and the product.
+				MatrixMutView d = mat2(persist, 2, 0, 0, 3);
+				err = matrix_core::op_det(d.view(), scratch, &det, &expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				assert(det.num() == 6);
+				assert(expl.step_count() == 2);
+				assert(expl.render_step(1, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(latex, "$$\\det(A) = (2)(3) = 6$$") == 0);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_det] after block asserts\n");
+#endif
+
 		// op_det: not-square error.
 		{
 				Slab slab;
@@ -209,5 +332,114 @@ int main() {
 		dbg_printf("[test_det] after det_elim/row_op_caption asserts\n");
 #endif
 
+		// Compact detail: one step per pivot column, symmetric input included
+		{
+				Slab slab;
+				assert(slab.init(64 * 1024) == ErrorCode::Ok);
+				Arena persist(slab.data(), slab.size() / 2);
+				Arena scratch(slab.data() + (slab.size() / 2), slab.size() - (slab.size() / 2));
+
+				const std::int64_t vals[2][3][3] = {{{0, 2, 1}, {3, -1, 4}, {1, 5, 2}}, {{4, 2, 2}, {2, 5, 3}, {2, 3, 6}}};
+				const std::int64_t dets[2] = {12, 64};
+				for (std::uint8_t t = 0; t < 2; t++) {
+						MatrixMutView a = mat3(persist, vals[t]);
+
+						Rational det;
+						Explanation expl;
+						auto err = matrix_core::op_det(a.view(), scratch, &det, &expl,
+						                               ExplainOptions{.enable = true,
+						                                              .persist = &persist,
+						                                              .detail = matrix_core::ExplainDetail::Compact});
+						assert(matrix_core::is_ok(err));
+						assert(det.num() == dets[t] && det.den() == 1);
+						// A, columns 1 and 2 (column 3 needs no op), det
+						assert(expl.step_count() == 4);
+
+						char caption[128];
+						char latex[512];
+						StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+						for (std::size_t i = 0; i < expl.step_count(); i++)
+								assert(expl.render_step(i, bufs) == ErrorCode::Ok);
+						assert(expl.render_step(1, bufs) == ErrorCode::Ok);
+						assert(std::strncmp(caption, "Pivot $R_{1}$, clear $C_{1}$ (", 30) == 0);
+						assert(expl.render_step(4, bufs) == ErrorCode::StepOutOfRange);
+				}
+
+				char buf[64];
+				assert(matrix_core::op_group_caption(matrix_core::OpGroup{1, 2, 1}, buf, sizeof(buf)) == ErrorCode::Ok);
+				assert(std::strcmp(buf, "Pivot $R_{2}$, clear $C_{3}$ (1 op)") == 0);
+				assert(matrix_core::op_group_caption(matrix_core::OpGroup{0, matrix_core::kScaleGroup, 3}, buf, sizeof(buf)) ==
+				       ErrorCode::Ok);
+				assert(std::strcmp(buf, "Scale pivot rows (3 ops)") == 0);
+				assert(matrix_core::op_group_caption(matrix_core::OpGroup{}, buf, 4) == ErrorCode::BufferTooSmall);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_det] after compact asserts\n");
+#endif
+
+		// Lazy: the result right away, the steps built when asked for
+		{
+				Slab slab;
+				assert(slab.init(64 * 1024) == ErrorCode::Ok);
+				Arena persist(slab.data(), slab.size() / 2);
+				Arena scratch(slab.data() + (slab.size() / 2), slab.size() - (slab.size() / 2));
+
+				MatrixMutView a = mat3(persist, {{1, 0, 2}, {0, 5, 0}, {3, 0, 4}});
+
+				Rational det;
+				Explanation eager;
+				std::size_t mark = persist.used();
+				auto err = matrix_core::op_det(a.view(), scratch, &det, &eager, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				const std::size_t eager_bytes = persist.used() - mark;
+
+				Explanation lazy;
+				det = Rational::from_int(0);
+				mark = persist.used();
+				err = matrix_core::op_det(
+				        a.view(), scratch, &det, &lazy, ExplainOptions{.enable = true, .persist = &persist, .lazy = true});
+				assert(matrix_core::is_ok(err));
+				assert(det.num() == -10 && det.den() == 1);
+				assert(lazy.available() && lazy.lazy());
+				assert(persist.used() - mark < eager_bytes);
+				assert(!eager.lazy() && eager.build_bytes() == 0);
+				assert(lazy.build_bytes() >= eager_bytes);
+
+				// nothing to show before the build
+				char caption[128];
+				char latex[512];
+				char eager_latex[512];
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				assert(lazy.step_count() == 0);
+				assert(lazy.render_step(0, bufs) == ErrorCode::Internal);
+
+				Explanation built;
+				assert(lazy.build(persist, scratch, &built) == ErrorCode::Ok);
+				assert(!built.lazy());
+				assert(built.step_count() == eager.step_count());
+				for (std::size_t i = 0; i < eager.step_count(); i++) {
+						assert(eager.render_step(i, bufs) == ErrorCode::Ok);
+						std::strcpy(eager_latex, latex);
+						assert(built.render_step(i, bufs) == ErrorCode::Ok);
+						assert(std::strcmp(latex, eager_latex) == 0);
+				}
+
+				// an eager explanation builds to a borrow of itself
+				Explanation same;
+				assert(eager.build(persist, scratch, &same) == ErrorCode::Ok);
+				assert(same.step_count() == eager.step_count());
+
+				// a build that does not fit leaves persist as it was
+				alignas(16) std::uint8_t small_buf[16] = {};
+				Arena small(small_buf, sizeof(small_buf));
+				assert(lazy.build(small, scratch, &built) == ErrorCode::Overflow);
+				assert(small.used() == 0);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_det] after lazy asserts\n");
+#endif
+
 		return 0;
 }
@@ -28,6 +28,16 @@ static MatrixMutView mat2(Arena& a, std::int64_t a00, std::int64_t a01, std::int
 		return m;
 }
 
+static MatrixMutView mat3(Arena& a, const std::int64_t (&vals)[3][3]) {
+		MatrixMutView m;
+		assert(matrix_core::matrix_alloc(a, 3, 3, &m) == ErrorCode::Ok);
+		for (std::uint8_t r = 0; r < 3; r++) {
+				for (std::uint8_t c = 0; c < 3; c++)
+						m.at_mut(r, c) = Rational::from_int(vals[r][c]);
+		}
+		return m;
+}
+
 int main() {
 #if defined(MATRIX_CE_TESTS)
 #ifdef NDEBUG
@@ -99,6 +109,242 @@ int main() {
 		dbg_printf("[test_inverse] after inverse asserts\n");
 #endif
 
+		// Symmetric input: LDL^T solves, symmetric Gauss-Jordan steps.
+		{
+				MatrixMutView a = mat3(persist, {{4, 2, 2}, {2, 5, 3}, {2, 3, 6}});
+				MatrixMutView inv;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
+
+				Explanation expl;
+				auto err = matrix_core::op_inverse(a.view(), scratch, inv, &expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+
+				MatrixMutView prod;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &prod) == ErrorCode::Ok);
+				assert(matrix_core::matrix_mul(a.view(), inv.view(), prod) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < 3; r++) {
+						for (std::uint8_t c = 0; c < 3; c++) {
+								const auto v = prod.at(r, c);
+								assert(v.den() == 1 && v.num() == (r == c ? 1 : 0));
+						}
+				}
+
+				// 3 nonzero l_ij down and up, 3 scales by 1/4
+				assert(expl.step_count() == 10);
+				char caption[128];
+				char latex[1024];
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				for (std::size_t i = 0; i < expl.step_count(); i++)
+						assert(expl.render_step(i, bufs) == ErrorCode::Ok);
+				assert(std::strstr(latex, "\\frac{21}{64}") != nullptr);
+
+				// zero pivot: falls back to the pivoting path
+				MatrixMutView p = mat2(persist, 0, 1, 1, 0);
+				MatrixMutView pinv;
+				assert(matrix_core::matrix_alloc(persist, 2, 2, &pinv) == ErrorCode::Ok);
+				err = matrix_core::op_inverse(p.view(), scratch, pinv, nullptr, ExplainOptions{.enable = false, .persist = nullptr});
+				assert(matrix_core::is_ok(err));
+				assert(pinv.at(0, 1).num() == 1 && pinv.at(1, 0).num() == 1 && pinv.at(0, 0).is_zero());
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_inverse] after symmetric asserts\n");
+#endif
+
+		// Block-diagonal up to permutation: inverted block by block.
+		{
+				MatrixMutView a = mat3(persist, {{1, 0, 2}, {0, 5, 0}, {3, 0, 4}});
+				MatrixMutView inv;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
+
+				Explanation expl;
+				auto err = matrix_core::op_inverse(a.view(), scratch, inv, &expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				assert(inv.at(0, 0).num() == -2 && inv.at(0, 2).num() == 1);
+				assert(inv.at(2, 0).num() == 3 && inv.at(2, 0).den() == 2);
+				assert(inv.at(1, 1).num() == 1 && inv.at(1, 1).den() == 5);
+				assert(inv.at(0, 1).is_zero() && inv.at(1, 2).is_zero());
+
+				char caption[128];
+				char latex[1024];
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				const std::size_t nsteps = expl.step_count();
+				for (std::size_t i = 0; i < nsteps; i++)
+						assert(expl.render_step(i, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(caption, "$A^{-1}$") == 0);
+				assert(std::strstr(latex, "\\frac{1}{5}") != nullptr);
+				assert(expl.render_step(nsteps, bufs) == ErrorCode::StepOutOfRange);
+
+				// singular block
+				a.at_mut(1, 1) = Rational::from_int(0);
+				err = matrix_core::op_inverse(a.view(), scratch, inv, nullptr, ExplainOptions{.enable = false, .persist = nullptr});
+				assert(err.code == ErrorCode::Singular);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_inverse] after block asserts\n");
+#endif
+
+		// in-place steps: the [B | I] display is rebuilt from the n x n state
+		{
+				MatrixMutView a = mat3(persist, {{0, 2, 0}, {1, 0, 0}, {0, 0, 3}});
+				MatrixMutView inv;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
+
+				Explanation expl;
+				auto err = matrix_core::op_inverse(a.view(), scratch, inv, &expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				assert(inv.at(0, 1).num() == 1 && inv.at(1, 0).num() == 1 && inv.at(1, 0).den() == 2);
+
+				// A, [B_1 | I], swap, scale
+				char caption[128];
+				char latex[1024];
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				assert(expl.step_count() == 5);
+				assert(expl.render_step(2, bufs) == ErrorCode::Ok);
+				assert(std::strstr(latex, "1 & 0 & 0 & 1 \\\\ 0 & 2 & 1 & 0") != nullptr);
+				assert(expl.render_step(3, bufs) == ErrorCode::Ok);
+				assert(std::strstr(latex, "0 & 1 & \\frac{1}{2} & 0") != nullptr);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_inverse] after in-place step asserts\n");
+#endif
+
+		// Compact detail: one step per pivot column, same final state
+		{
+				const std::int64_t vals[2][3][3] = {{{2, 1, 1}, {4, 3, 3}, {8, 7, 9}}, {{4, 2, 2}, {2, 5, 3}, {2, 3, 6}}};
+				// [A | I], 2 forward columns, the scales, 2 back columns
+				const std::size_t compact_steps[2] = {6, 6};
+				for (std::uint8_t t = 0; t < 2; t++) {
+						MatrixMutView a = mat3(persist, vals[t]);
+						MatrixMutView inv;
+						assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
+
+						Explanation full;
+						Explanation compact;
+						auto err =
+						        matrix_core::op_inverse(a.view(), scratch, inv, &full, ExplainOptions{.enable = true, .persist = &persist});
+						assert(matrix_core::is_ok(err));
+						err = matrix_core::op_inverse(a.view(), scratch, inv, &compact,
+						                              ExplainOptions{.enable = true,
+						                                             .persist = &persist,
+						                                             .detail = matrix_core::ExplainDetail::Compact});
+						assert(matrix_core::is_ok(err));
+						assert(compact.step_count() == compact_steps[t]);
+						assert(compact.step_count() < full.step_count());
+
+						char caption[128];
+						char latex[1024];
+						char full_latex[1024];
+						StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+						assert(full.render_step(full.step_count() - 1, bufs) == ErrorCode::Ok);
+						std::strcpy(full_latex, latex);
+						for (std::size_t i = 0; i < compact.step_count(); i++)
+								assert(compact.render_step(i, bufs) == ErrorCode::Ok);
+						assert(std::strcmp(latex, full_latex) == 0);
+						assert(compact.render_step(1, bufs) == ErrorCode::Ok);
+						assert(std::strncmp(caption, "Pivot $R_{1}$, clear $C_{1}$", 28) == 0);
+						assert(compact.render_step(compact.step_count(), bufs) == ErrorCode::StepOutOfRange);
+				}
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_inverse] after compact asserts\n");
+#endif
+
+		// Lazy: same steps once built
+		{
+				MatrixMutView a = mat2(persist, 1, 2, 3, 4);
+				MatrixMutView inv;
+				assert(matrix_core::matrix_alloc(persist, 2, 2, &inv) == ErrorCode::Ok);
+
+				Explanation eager;
+				Explanation lazy;
+				auto err = matrix_core::op_inverse(a.view(), scratch, inv, &eager, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				matrix_core::matrix_fill_zero(inv);
+				err = matrix_core::op_inverse(
+				        a.view(), scratch, inv, &lazy, ExplainOptions{.enable = true, .persist = &persist, .lazy = true});
+				assert(matrix_core::is_ok(err));
+				assert(inv.at(1, 0).num() == 3 && inv.at(1, 0).den() == 2);
+
+				char caption[128];
+				char latex[1024];
+				char eager_latex[1024];
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				Explanation built;
+				assert(lazy.build(persist, scratch, &built) == ErrorCode::Ok);
+				assert(built.step_count() == eager.step_count());
+				for (std::size_t i = 0; i < eager.step_count(); i++) {
+						assert(eager.render_step(i, bufs) == ErrorCode::Ok);
+						std::strcpy(eager_latex, latex);
+						assert(built.render_step(i, bufs) == ErrorCode::Ok);
+						assert(std::strcmp(latex, eager_latex) == 0);
+				}
+				assert(built.render_step(built.step_count(), bufs) == ErrorCode::StepOutOfRange);
+		}
+
+		// a lazy 6x6 inverse in a result cache sized block: the block holds the
+		// input copy, the result, the recipe and the page, and the steps build
+		// into an arena of build_bytes() (plain and block diagonal, full and
+		// compact)
+		{
+				constexpr std::uint8_t n = 6;
+				constexpr std::size_t kBlockBytes = 768u + sizeof(Rational) * matrix_core::kMaxEntries;
+				const std::int64_t plain[n][n] = {{2, 1, 0, 0, 1, 3},
+				        {1, 3, 1, 0, 0, 1},
+				        {0, 1, 4, 1, 0, 2},
+				        {1, 0, 1, 5, 1, 0},
+				        {0, 2, 0, 1, 6, 1},
+				        {3, 0, 1, 0, 1, 7}};
+				const std::int64_t blocks[n][n] = {{2, 1, 0, 0, 0, 0},
+				        {1, 3, 0, 0, 0, 0},
+				        {0, 0, 4, 1, 0, 0},
+				        {0, 0, 2, 5, 0, 0},
+				        {0, 0, 0, 0, 6, 1},
+				        {0, 0, 0, 0, 3, 7}};
+				for (const auto* vals : {plain, blocks}) {
+						for (const matrix_core::ExplainDetail detail : {matrix_core::ExplainDetail::Full, matrix_core::ExplainDetail::Compact}) {
+								alignas(std::max_align_t) static std::uint8_t block_buf[kBlockBytes];
+								Arena block(block_buf, sizeof(block_buf));
+								MatrixMutView a;
+								MatrixMutView copy;
+								MatrixMutView inv;
+								assert(matrix_core::matrix_alloc(persist, n, n, &a) == ErrorCode::Ok);
+								for (std::uint8_t r = 0; r < n; r++) {
+										for (std::uint8_t c = 0; c < n; c++)
+												a.at_mut(r, c) = Rational::from_int(vals[r][c]);
+								}
+								assert(matrix_core::matrix_clone(block, a.view(), &copy) == ErrorCode::Ok);
+								assert(matrix_core::matrix_alloc(block, n, n, &inv) == ErrorCode::Ok);
+
+								Explanation lazy;
+								const ExplainOptions opts{.enable = true, .persist = &block, .detail = detail, .lazy = true};
+								assert(matrix_core::is_ok(matrix_core::op_inverse(a.view(), scratch, inv, &lazy, opts)));
+								assert(lazy.lazy());
+								// and still room for the shell's result page
+								assert(block.capacity() - block.used() >= 64);
+
+								alignas(std::max_align_t) static std::uint8_t steps_buf[256];
+								assert(lazy.build_bytes() <= sizeof(steps_buf));
+								Arena steps(steps_buf, lazy.build_bytes());
+								Explanation built;
+								assert(lazy.build(steps, scratch, &built) == ErrorCode::Ok);
+								assert(built.step_count() > 1);
+								static char big_latex[4096];
+								static char big_caption[128];
+								StepRenderBuffers big{big_caption, sizeof(big_caption), big_latex, sizeof(big_latex), &scratch};
+								for (std::size_t i = 0; i < built.step_count(); i++)
+										assert(built.render_step(i, big) == ErrorCode::Ok);
+						}
+				}
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_inverse] after lazy asserts\n");
+#endif
+
 		// Singular matrix.
 		{
 				MatrixMutView a = mat2(persist, 1, 2, 2, 4);
@@ -180,7 +426,7 @@ int main() {
 				MatrixMutView inv;
 				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
 
-				std::uint8_t tiny_buf[64] = {};
+				std::uint8_t tiny_buf[32] = {};
 				Arena tiny_scratch(tiny_buf, sizeof(tiny_buf));
 				auto err =
 				        matrix_core::op_inverse(a.view(), tiny_scratch, inv, nullptr, ExplainOptions{.enable = false, .persist = nullptr});
@@ -192,5 +438,35 @@ int main() {
 		dbg_printf("[test_inverse] after scratch overflow asserts\n");
 #endif
 
+		// row fragments give the full write's LaTeX on every step, swaps included
+		{
+				MatrixMutView a = mat3(persist, {{0, 2, 1}, {3, -1, 4}, {1, 5, 2}});
+				MatrixMutView inv;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
+				Explanation expl;
+				assert(matrix_core::is_ok(matrix_core::op_inverse(
+				        a.view(), scratch, inv, &expl, ExplainOptions{.enable = true, .persist = &persist})));
+
+				matrix_core::latex::RowFragments frags;
+				assert(frags.init(persist, 128) == ErrorCode::Ok);
+				char caption[128];
+				char latex[1024];
+				char plain[1024];
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				StepRenderBuffers rowed = bufs;
+				rowed.rows = &frags;
+				for (std::size_t i = 0; i < expl.step_count(); i++) {
+						assert(expl.render_step(i, bufs) == ErrorCode::Ok);
+						std::strcpy(plain, latex);
+						assert(expl.render_step(i, rowed) == ErrorCode::Ok);
+						assert(std::strcmp(latex, plain) == 0);
+				}
+				assert(frags.rows_written() < 3 * expl.step_count());
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_inverse] after row fragment asserts\n");
+#endif
+
 		return 0;
 }
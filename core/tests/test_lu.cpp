@@ -0,0 +1,291 @@
+#include "matrix_core/matrix_core.hpp"
+
+#include "matrix_core/det_detail.hpp"
+
+#include "test_dbg_ce.hpp"
+
+#include <cassert>
+#include <cstring>
+
+#if defined(MATRIX_CE_TESTS)
+#include <debug.h>
+#endif
+
+using matrix_core::Arena;
+using matrix_core::EditTracker;
+using matrix_core::ErrorCode;
+using matrix_core::ExplainOptions;
+using matrix_core::Explanation;
+using matrix_core::LuCache;
+using matrix_core::LuFactor;
+using matrix_core::MatrixMutView;
+using matrix_core::MatrixView;
+using matrix_core::Rational;
+using matrix_core::Slab;
+using matrix_core::StepRenderBuffers;
+
+static MatrixMutView mat3(Arena& a, const std::int64_t (&vals)[3][3]) {
+		MatrixMutView m;
+		assert(matrix_core::matrix_alloc(a, 3, 3, &m) == ErrorCode::Ok);
+		for (std::uint8_t r = 0; r < 3; r++) {
+				for (std::uint8_t c = 0; c < 3; c++)
+						m.at_mut(r, c) = Rational::from_int(vals[r][c]);
+		}
+		return m;
+}
+
+static bool same(MatrixView x, MatrixView y) {
+		if (x.rows != y.rows || x.cols != y.cols)
+				return false;
+		for (std::uint8_t r = 0; r < x.rows; r++) {
+				for (std::uint8_t c = 0; c < x.cols; c++) {
+						if (x.at(r, c).num() != y.at(r, c).num() || x.at(r, c).den() != y.at(r, c).den())
+								return false;
+				}
+		}
+		return true;
+}
+
+int main() {
+#if defined(MATRIX_CE_TESTS)
+#ifdef NDEBUG
+		dbg_printf("[test_lu] NDEBUG defined (asserts off)\n");
+#else
+		dbg_printf("[test_lu] NDEBUG not defined (asserts on)\n");
+#endif
+#endif
+		Slab slab;
+		assert(slab.init(128 * 1024) == ErrorCode::Ok);
+
+		Arena persist(slab.data(), slab.size() / 2);
+		Arena scratch(slab.data() + (slab.size() / 2), slab.size() - (slab.size() / 2));
+
+#if defined(MATRIX_CE_TESTS)
+		static char caption[128];
+		static char latex[1024];
+#else
+		char caption[128];
+		char latex[1024];
+#endif
+		StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+
+		// P A = L U with a row swap, steps end with L and P
+		{
+				MatrixMutView a = mat3(persist, {{0, 2, 1}, {1, 1, 1}, {2, 1, 3}});
+				MatrixMutView l;
+				MatrixMutView u;
+				MatrixMutView p;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &l) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &u) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &p) == ErrorCode::Ok);
+
+				Explanation expl;
+				auto err = matrix_core::op_lu(a.view(), scratch, l, u, p, &expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+
+				for (std::uint8_t r = 0; r < 3; r++) {
+						assert(l.at(r, r).num() == 1 && l.at(r, r).den() == 1);
+						for (std::uint8_t c = static_cast<std::uint8_t>(r + 1); c < 3; c++) {
+								assert(l.at(r, c).is_zero());
+								assert(u.at(c, r).is_zero());
+						}
+				}
+
+				MatrixMutView pa;
+				MatrixMutView lu;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &pa) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &lu) == ErrorCode::Ok);
+				assert(matrix_core::matrix_mul(p.view(), a.view(), pa) == ErrorCode::Ok);
+				assert(matrix_core::matrix_mul(l.view(), u.view(), lu) == ErrorCode::Ok);
+				assert(same(pa.view(), lu.view()));
+
+				// swap R1<->R2, one elimination per column
+				assert(expl.step_count() == 1 + 3 + 2);
+				for (std::size_t i = 0; i < expl.step_count(); i++)
+						assert(expl.render_step(i, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(caption, "$P$") == 0);
+				assert(expl.render_step(expl.step_count() - 2, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(caption, "$L$") == 0);
+				assert(expl.render_step(expl.step_count(), bufs) == ErrorCode::StepOutOfRange);
+
+#if defined(MATRIX_CE_TESTS)
+				matrix_test_ce::print_matrix("L", l.view());
+				matrix_test_ce::print_matrix("U", u.view());
+#endif
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_lu] after op_lu asserts\n");
+#endif
+
+		// det, solve and inverse from one factor
+		{
+				MatrixMutView a = mat3(persist, {{2, 1, 1}, {4, -6, 0}, {-2, 7, 2}});
+				LuFactor f;
+				assert(matrix_core::lu_factor(a.view(), persist, &f) == ErrorCode::Ok);
+				assert(!f.singular);
+
+				Rational det;
+				assert(matrix_core::lu_det(f, &det) == ErrorCode::Ok);
+				Rational ref;
+				Explanation expl;
+				assert(matrix_core::is_ok(matrix_core::op_det(a.view(), scratch, &ref, &expl, ExplainOptions{})));
+				assert(det.num() == ref.num() && det.den() == ref.den());
+				assert(det.num() == -16 && det.den() == 1);
+
+				// x = (1, 1, 2)
+				MatrixMutView b;
+				MatrixMutView x;
+				assert(matrix_core::matrix_alloc(persist, 3, 1, &b) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 3, 1, &x) == ErrorCode::Ok);
+				b.at_mut(0, 0) = Rational::from_int(5);
+				b.at_mut(1, 0) = Rational::from_int(-2);
+				b.at_mut(2, 0) = Rational::from_int(9);
+				assert(matrix_core::lu_solve(f, b.view(), x) == ErrorCode::Ok);
+				assert(x.at(0, 0).num() == 1 && x.at(1, 0).num() == 1 && x.at(2, 0).num() == 2);
+
+				MatrixMutView inv;
+				MatrixMutView inv_ref;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv_ref) == ErrorCode::Ok);
+				assert(matrix_core::lu_inverse(f, inv) == ErrorCode::Ok);
+				assert(matrix_core::is_ok(matrix_core::op_inverse(a.view(), scratch, inv_ref, &expl, ExplainOptions{})));
+				assert(same(inv.view(), inv_ref.view()));
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_lu] after solve asserts\n");
+#endif
+
+		// singular: det_ops matches det_elim, solves refuse
+		{
+				MatrixMutView a = mat3(persist, {{1, 2, 3}, {2, 4, 6}, {1, 0, 1}});
+				LuFactor f;
+				assert(matrix_core::lu_factor(a.view(), persist, &f) == ErrorCode::Ok);
+				assert(f.singular);
+
+				MatrixMutView work;
+				assert(matrix_core::matrix_clone(scratch, a.view(), &work) == ErrorCode::Ok);
+				Rational det;
+				std::size_t ops = 0;
+				assert(matrix_core::detail::det_elim(work, &det, &ops, static_cast<std::size_t>(-1), nullptr) == ErrorCode::Ok);
+				assert(f.det_ops == ops);
+				assert(matrix_core::lu_det(f, &det) == ErrorCode::Ok);
+				assert(det.is_zero());
+
+				MatrixMutView inv;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
+				assert(matrix_core::lu_inverse(f, inv) == ErrorCode::Singular);
+				scratch.clear();
+		}
+
+		// cache: hits on unchanged contents, same results and steps as the uncached ops
+		{
+				LuCache cache;
+				assert(cache.init(persist, 2) == ErrorCode::Ok);
+
+				MatrixMutView a = mat3(persist, {{0, 2, 1}, {1, 1, 1}, {2, 1, 3}});
+				Rational det;
+				Rational ref;
+				Explanation expl;
+				Explanation expl_ref;
+				const ExplainOptions opts{.enable = true, .persist = &persist};
+				assert(matrix_core::is_ok(matrix_core::op_det_cached(a.view(), cache, scratch, &det, &expl, opts)));
+				assert(matrix_core::is_ok(matrix_core::op_det(a.view(), scratch, &ref, &expl_ref, opts)));
+				assert(det.num() == ref.num() && det.den() == ref.den());
+				assert(expl.step_count() == expl_ref.step_count());
+				assert(cache.misses() == 1 && cache.hits() == 0);
+
+				MatrixMutView inv;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
+				assert(matrix_core::is_ok(matrix_core::op_inverse_cached(a.view(), cache, scratch, inv, &expl, opts)));
+				assert(cache.misses() == 1 && cache.hits() == 1);
+				MatrixMutView inv_ref;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv_ref) == ErrorCode::Ok);
+				assert(matrix_core::is_ok(matrix_core::op_inverse(a.view(), scratch, inv_ref, &expl_ref, opts)));
+				assert(same(inv.view(), inv_ref.view()));
+				assert(expl.step_count() == expl_ref.step_count());
+				for (std::size_t i = 0; i < expl.step_count(); i++)
+						assert(expl.render_step(i, bufs) == ErrorCode::Ok);
+
+				// editing the matrix invalidates by contents
+				a.at_mut(2, 2) = Rational::from_int(4);
+				assert(matrix_core::is_ok(matrix_core::op_det_cached(a.view(), cache, scratch, &det, &expl, opts)));
+				assert(cache.misses() == 2);
+				a.at_mut(2, 2) = Rational::from_int(3);
+				assert(matrix_core::is_ok(matrix_core::op_det_cached(a.view(), cache, scratch, &det, &expl, opts)));
+				assert(cache.misses() == 2 && cache.hits() == 2);
+				assert(det.num() == ref.num());
+
+				// a hit is confirmed against the factored entries, not just the hash
+				MatrixMutView b = mat3(persist, {{0, 2, 1}, {1, 1, 1}, {2, 1, 3}});
+				assert(matrix_core::is_ok(matrix_core::op_det_cached(b.view(), cache, scratch, &det, &expl, opts)));
+				assert(cache.misses() == 2 && cache.hits() == 3);
+				b.at_mut(0, 0) = Rational::from_int(5);
+				assert(matrix_core::is_ok(matrix_core::op_det_cached(b.view(), cache, scratch, &det, &expl, opts)));
+				assert(cache.misses() == 3 && det.num() == 7);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_lu] after cache asserts\n");
+#endif
+
+		// edit tracker: single entry edits update det and A^{-1} without refactoring
+		{
+				EditTracker t;
+				assert(t.init(persist) == ErrorCode::Ok);
+				MatrixMutView a = mat3(persist, {{2, 1, 1}, {4, -6, 0}, {-2, 7, 2}});
+				assert(t.reset(a.view(), scratch) == ErrorCode::Ok);
+				assert(t.known() && t.rank() == 3 && t.det().num() == -16);
+
+				MatrixMutView inv;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &inv) == ErrorCode::Ok);
+				const std::int64_t edits[][3] = {{0, 0, 5}, {2, 1, -3}, {1, 2, 4}, {0, 2, -7}, {1, 1, 1}};
+				for (const auto& e : edits) {
+						const std::uint8_t r = static_cast<std::uint8_t>(e[0]);
+						const std::uint8_t c = static_cast<std::uint8_t>(e[1]);
+						const Rational old = a.at(r, c);
+						a.at_mut(r, c) = Rational::from_int(e[2]);
+						assert(t.update(a.view(), r, c, old, scratch) == ErrorCode::Ok);
+
+						LuFactor f;
+						Rational det;
+						assert(matrix_core::lu_factor(a.view(), scratch, &f) == ErrorCode::Ok);
+						assert(matrix_core::lu_det(f, &det) == ErrorCode::Ok);
+						assert(t.det().num() == det.num() && t.det().den() == det.den());
+						assert(t.has_inverse());
+						assert(matrix_core::lu_inverse(f, inv) == ErrorCode::Ok);
+						assert(same(t.inverse(), inv.view()));
+						scratch.clear();
+				}
+				assert(t.refactors() == 1);
+
+				// an edit that makes A singular refactors: det 0, rank 2
+				const std::size_t before = t.refactors();
+				MatrixMutView s = mat3(persist, {{1, 2, 3}, {2, 4, 6}, {1, 0, 2}});
+				assert(t.reset(s.view(), scratch) == ErrorCode::Ok);
+				assert(t.det().is_zero() && t.rank() == 2 && !t.has_inverse());
+				Rational old = s.at(1, 2);
+				s.at_mut(1, 2) = Rational::from_int(5);
+				assert(t.update(s.view(), 1, 2, old, scratch) == ErrorCode::Ok);
+				assert(t.rank() == 3 && t.det().num() == -2);
+				old = s.at(1, 2);
+				s.at_mut(1, 2) = Rational::from_int(6);
+				assert(t.update(s.view(), 1, 2, old, scratch) == ErrorCode::Ok);
+				assert(t.det().is_zero() && t.rank() == 2);
+				assert(t.refactors() == before + 3);
+
+				// non square: rank only
+				MatrixMutView w;
+				assert(matrix_core::matrix_alloc(persist, 2, 3, &w) == ErrorCode::Ok);
+				w.at_mut(0, 1) = Rational::from_int(3);
+				assert(t.reset(w.view(), scratch) == ErrorCode::Ok);
+				assert(!t.square() && t.rank() == 1);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_lu] after edit tracker asserts\n");
+#endif
+
+		return 0;
+}
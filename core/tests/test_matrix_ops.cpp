@@ -18,6 +18,7 @@ using matrix_core::ExplainOptions;
 using matrix_core::Explanation;
 using matrix_core::MatrixMutView;
 using matrix_core::MatrixView;
+using matrix_core::MinorView;
 using matrix_core::Rational;
 using matrix_core::Slab;
 using matrix_core::StepRenderBuffers;
@@ -331,6 +332,138 @@ int main() {
 		dbg_printf("[test_matrix_ops] after op_transpose asserts\n");
 #endif
 
+		// transposed views: no copy, and kernels read them like any other view
+		{
+				MatrixMutView a;
+				assert(matrix_core::matrix_alloc(persist, 2, 3, &a) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < 2; r++) {
+						for (std::uint8_t c = 0; c < 3; c++)
+								a.at_mut(r, c) = Rational::from_int(1 + r * 3 + c);
+				}
+
+				MatrixView at;
+				Explanation expl;
+				const std::size_t used = persist.used();
+				auto err = matrix_core::op_transpose_view(a.view(), &at, nullptr, ExplainOptions{});
+				assert(matrix_core::is_ok(err));
+				assert(persist.used() == used);
+				assert(at.rows == 3 && at.cols == 2 && at.data == a.data);
+
+				MatrixMutView ref;
+				assert(matrix_core::matrix_alloc(persist, 3, 2, &ref) == ErrorCode::Ok);
+				assert(matrix_core::matrix_transpose(a.view(), ref) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < 3; r++) {
+						for (std::uint8_t c = 0; c < 2; c++)
+								assert(at.at(r, c).num() == ref.at(r, c).num());
+				}
+				assert(at.transposed().at(1, 2).num() == a.at(1, 2).num());
+
+				// A^T A from the view equals it from the copy
+				MatrixMutView ata;
+				MatrixMutView ata_ref;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &ata) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &ata_ref) == ErrorCode::Ok);
+				assert(matrix_core::matrix_mul(at, a.view(), ata) == ErrorCode::Ok);
+				assert(matrix_core::matrix_mul(ref.view(), a.view(), ata_ref) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < 3; r++) {
+						for (std::uint8_t c = 0; c < 3; c++)
+								assert(ata.at(r, c).num() == ata_ref.at(r, c).num());
+				}
+
+				// writes through a transposed mutable view land in the original
+				a.transposed().at_mut(2, 0) = Rational::from_int(-7);
+				assert(a.at(0, 2).num() == -7);
+
+				err = matrix_core::op_transpose_view(a.view(), &at, &expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err));
+				char latex[256];
+				StepRenderBuffers bufs{nullptr, 0, latex, sizeof(latex), nullptr};
+				assert(expl.render_step(1, bufs) == ErrorCode::Ok);
+				assert(std::strstr(latex, "1 & 4 \\\\ 2 & 5 \\\\ -7 & 6") != nullptr);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_matrix_ops] after transposed view asserts\n");
+#endif
+
+		// minor views: index maps over the source, copied only on request
+		{
+				MatrixMutView a;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &a) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < 3; r++) {
+						for (std::uint8_t c = 0; c < 3; c++)
+								a.at_mut(r, c) = Rational::from_int(1 + r * 3 + c);
+				}
+
+				MinorView m;
+				const std::size_t used = persist.used();
+				assert(matrix_core::minor_view(a.view(), 1, 0, &m) == ErrorCode::Ok);
+				assert(persist.used() == used);
+				assert(m.rows == 2 && m.cols == 2);
+				assert(m.at(0, 0).num() == 2 && m.at(0, 1).num() == 3);
+				assert(m.at(1, 0).num() == 8 && m.at(1, 1).num() == 9);
+
+				// the view follows later edits of the source
+				a.at_mut(2, 2) = Rational::from_int(-9);
+				assert(m.at(1, 1).num() == -9);
+
+				MatrixMutView copy;
+				assert(matrix_core::matrix_clone(persist, m, &copy) == ErrorCode::Ok);
+				copy.at_mut(0, 0) = Rational::from_int(0);
+				assert(a.at(0, 1).num() == 2);
+				assert(copy.at(1, 0).num() == 8 && copy.at(1, 1).num() == -9);
+
+				// works on a transposed view too
+				assert(matrix_core::minor_view(a.view().transposed(), 0, 2, &m) == ErrorCode::Ok);
+				assert(m.at(0, 0).num() == 2 && m.at(1, 1).num() == 6);
+
+				assert(matrix_core::minor_view(a.view(), 3, 0, &m) == ErrorCode::IndexOutOfRange);
+				MatrixMutView one;
+				assert(matrix_core::matrix_alloc(persist, 1, 3, &one) == ErrorCode::Ok);
+				assert(matrix_core::minor_view(one.view(), 0, 0, &m) == ErrorCode::InvalidDimension);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_matrix_ops] after minor view asserts\n");
+#endif
+
+		// content hash: rolling updates match a full rehash, dims count
+		{
+				MatrixMutView a = mat2(persist, 1, 2, 3, 4);
+				std::uint64_t h = matrix_core::content_hash(a.view());
+				const std::uint64_t start = h;
+
+				h = matrix_core::content_hash_update(h, 0, 1, a.at(0, 1), Rational::from_int(7));
+				a.at_mut(0, 1) = Rational::from_int(7);
+				assert(h == matrix_core::content_hash(a.view()));
+				assert(h != start);
+
+				// the same value at another position is a different matrix
+				MatrixMutView b = mat2(persist, 1, 2, 3, 4);
+				b.at_mut(1, 0) = Rational::from_int(7);
+				b.at_mut(0, 1) = Rational::from_int(3);
+				assert(matrix_core::content_hash(b.view()) != h);
+
+				h = matrix_core::content_hash_update(h, 0, 1, a.at(0, 1), Rational::from_int(2));
+				a.at_mut(0, 1) = Rational::from_int(2);
+				assert(h == start);
+
+				MatrixView top{1, 2, a.stride, a.data};
+				assert(matrix_core::content_hash(top) != start);
+
+				// moving 2^48 from one cell to another is a different matrix
+				const std::int64_t big = std::int64_t{1} << 48;
+				MatrixMutView c = mat2(persist, big + 1, 5, 0, 1);
+				MatrixMutView d = mat2(persist, big + 5, 1, 0, 1);
+				assert(matrix_core::content_hash(c.view()) != matrix_core::content_hash(d.view()));
+				assert(!matrix_core::matrix_equal(c.view(), d.view()));
+				assert(matrix_core::matrix_equal(c.view(), c.view()));
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_matrix_ops] after content hash asserts\n");
+#endif
+
 		// Empty Explanation behavior.
 		{
 				Explanation empty;
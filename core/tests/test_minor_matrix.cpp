@@ -1,5 +1,7 @@
 #include "matrix_core/matrix_core.hpp"
 
+#include "matrix_core/det_detail.hpp"
+
 #include "test_dbg_ce.hpp"
 
 #include <cassert>
@@ -12,6 +14,7 @@
 using matrix_core::Arena;
 using matrix_core::ErrorCode;
 using matrix_core::MatrixMutView;
+using matrix_core::MinorView;
 using matrix_core::Rational;
 using matrix_core::Slab;
 
@@ -21,6 +24,16 @@ static MatrixMutView mat4(Arena& a) {
 		return m;
 }
 
+static MatrixMutView mat3(Arena& a, const std::int64_t (&vals)[3][3]) {
+		MatrixMutView m;
+		assert(matrix_core::matrix_alloc(a, 3, 3, &m) == ErrorCode::Ok);
+		for (std::uint8_t r = 0; r < 3; r++) {
+				for (std::uint8_t c = 0; c < 3; c++)
+						m.at_mut(r, c) = Rational::from_int(vals[r][c]);
+		}
+		return m;
+}
+
 int main() {
 #if defined(MATRIX_CE_TESTS)
 #ifdef NDEBUG
@@ -79,6 +92,99 @@ int main() {
 		dbg_printf("[test_minor_matrix] after expected minors asserts\n");
 #endif
 
+		// singular (rank 2): the minors come from the fraction-free fallback
+		{
+				MatrixMutView s = mat3(persist, {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+				const std::int64_t expected[3][3] = {{-3, -6, -3}, {-6, -12, -6}, {-3, -6, -3}};
+
+				MatrixMutView out3;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &out3) == ErrorCode::Ok);
+				assert(matrix_core::is_ok(matrix_core::op_minor_matrix(s.view(), scratch, out3)));
+				for (std::uint8_t r = 0; r < 3; r++) {
+						for (std::uint8_t c = 0; c < 3; c++)
+								assert(out3.at(r, c).num() == expected[r][c] && out3.at(r, c).den() == 1);
+				}
+
+				// rank 1: every 2x2 minor vanishes
+				for (std::uint8_t c = 0; c < 3; c++) {
+						s.at_mut(1, c) = Rational::from_int(2 * s.at(0, c).num());
+						s.at_mut(2, c) = Rational::from_int(-s.at(0, c).num());
+				}
+				assert(matrix_core::is_ok(matrix_core::op_minor_matrix(s.view(), scratch, out3)));
+				for (std::uint8_t r = 0; r < 3; r++) {
+						for (std::uint8_t c = 0; c < 3; c++)
+								assert(out3.at(r, c).is_zero());
+				}
+		}
+
+		// fractions: the factor path agrees with per-minor elimination
+		{
+				MatrixMutView f;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &f) == ErrorCode::Ok);
+				const std::int64_t nums[3][3] = {{1, 0, 2}, {3, -1, 1}, {0, 5, 4}};
+				for (std::uint8_t r = 0; r < 3; r++) {
+						for (std::uint8_t c = 0; c < 3; c++)
+								assert(Rational::make(nums[r][c], static_cast<std::int64_t>(r + c + 1), &f.at_mut(r, c)) == ErrorCode::Ok);
+				}
+
+				MatrixMutView out3;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &out3) == ErrorCode::Ok);
+				assert(matrix_core::is_ok(matrix_core::op_minor_matrix(f.view(), scratch, out3)));
+				for (std::uint8_t r = 0; r < 3; r++) {
+						for (std::uint8_t c = 0; c < 3; c++) {
+								MinorView view;
+								MatrixMutView sub;
+								assert(matrix_core::minor_view(f.view(), r, c, &view) == ErrorCode::Ok);
+								assert(matrix_core::matrix_clone(scratch, view, &sub) == ErrorCode::Ok);
+								Rational det;
+								std::size_t ops = 0;
+								assert(matrix_core::detail::det_elim(sub, &det, &ops, static_cast<std::size_t>(-1), nullptr) == ErrorCode::Ok);
+								assert(out3.at(r, c).num() == det.num() && out3.at(r, c).den() == det.den());
+						}
+				}
+				scratch.clear();
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_minor_matrix] after singular and fraction asserts\n");
+#endif
+
+		// singular with zero leading entries: the fallback pivots on the minor
+		// view's row map instead of a copy, and must agree with det_elim
+		{
+				MatrixMutView z;
+				assert(matrix_core::matrix_alloc(persist, 4, 4, &z) == ErrorCode::Ok);
+				const std::int64_t zvals[4][4] = {{0, 0, 1, 2}, {0, 3, 0, 1}, {2, 0, 0, 4}, {2, 3, 1, 7}};
+				for (std::uint8_t r = 0; r < 4; r++) {
+						for (std::uint8_t c = 0; c < 4; c++)
+								z.at_mut(r, c) = Rational::from_int(zvals[r][c]);
+				}
+
+				MatrixMutView out4;
+				assert(matrix_core::matrix_alloc(persist, 4, 4, &out4) == ErrorCode::Ok);
+				assert(matrix_core::is_ok(matrix_core::op_minor_matrix(z.view(), scratch, out4)));
+				bool any_nonzero = false;
+				for (std::uint8_t r = 0; r < 4; r++) {
+						for (std::uint8_t c = 0; c < 4; c++) {
+								MinorView view;
+								MatrixMutView sub;
+								assert(matrix_core::minor_view(z.view(), r, c, &view) == ErrorCode::Ok);
+								assert(matrix_core::matrix_clone(scratch, view, &sub) == ErrorCode::Ok);
+								Rational det;
+								std::size_t ops = 0;
+								assert(matrix_core::detail::det_elim(sub, &det, &ops, static_cast<std::size_t>(-1), nullptr) == ErrorCode::Ok);
+								assert(out4.at(r, c).num() == det.num() && out4.at(r, c).den() == det.den());
+								any_nonzero = any_nonzero || !det.is_zero();
+						}
+				}
+				assert(any_nonzero);
+				scratch.clear();
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_minor_matrix] after zero pivot asserts\n");
+#endif
+
 		// Argument validation.
 		{
 				MatrixMutView ns;
@@ -1,5 +1,6 @@
 #include "matrix_core/rational.hpp"
 #include "matrix_core/latex.hpp"
+#include "matrix_core/writer.hpp"
 
 #include "test_dbg_ce.hpp"
 
@@ -178,5 +179,149 @@ int main() {
 		dbg_printf("[test_rational] after latex asserts\n");
 #endif
 
+		// measured writers: the exact buffer size, and the constexpr bounds
+		{
+				namespace latex = matrix_core::latex;
+				std::size_t bytes = 0;
+				assert(latex::write_rational_size(make(-3, 2), &bytes) == ErrorCode::Ok);
+				assert(bytes == std::strlen("\\frac{-3}{2}") + 1);
+				assert(latex::write_rational_display_size(Rational::from_int(7), &bytes) == ErrorCode::Ok);
+				assert(bytes == std::strlen("$$7$$") + 1);
+
+				// every entry \frac{1}{2}: the bound for 11 byte entries is exact
+				Rational halves[6];
+				for (Rational& h : halves)
+						h = make(1, 2);
+				const matrix_core::MatrixView m{2, 3, 3, halves};
+				assert(latex::write_matrix_display_size(m, latex::MatrixBrackets::VMatrix, &bytes) == ErrorCode::Ok);
+				assert(bytes == latex::matrix_display_bound(2, 3, 11));
+				char buf[latex::matrix_display_bound(2, 3, 11)];
+				assert(bytes <= sizeof(buf));
+				assert(latex::write_matrix_display(m, latex::MatrixBrackets::VMatrix, {buf, bytes}) == ErrorCode::Ok);
+				assert(std::strlen(buf) + 1 == bytes);
+				assert(latex::write_matrix_display(m, latex::MatrixBrackets::VMatrix, {buf, bytes - 1}) == ErrorCode::BufferTooSmall);
+
+				const matrix_core::MatrixView left{2, 2, 3, halves};
+				const matrix_core::MatrixView right{2, 1, 3, halves + 2};
+				assert(latex::write_augmented_matrix_size(left, right, &bytes) == ErrorCode::Ok);
+				assert(bytes == latex::augmented_matrix_bound(2, 2, 1, 11));
+				assert(latex::write_augmented_matrix_display_size(left, right, &bytes) == ErrorCode::Ok);
+				assert(bytes == latex::augmented_matrix_display_bound(2, 2, 1, 11));
+				char aug[latex::augmented_matrix_display_bound(2, 2, 1, 11)];
+				assert(bytes <= sizeof(aug));
+				assert(latex::write_augmented_matrix_display(left, right, {aug, bytes}) == ErrorCode::Ok);
+				assert(std::strlen(aug) + 1 == bytes);
+
+				// the widest entries stay within the default bounds
+				const std::int64_t big = std::numeric_limits<std::int64_t>::max();
+				Rational wide[36];
+				for (Rational& w : wide)
+						w = make(-big, big - 1);
+				assert(latex::write_rational_size(wide[0], &bytes) == ErrorCode::Ok);
+				assert(bytes <= latex::kRationalLatexMax + 1);
+				const matrix_core::MatrixView w6{6, 6, 6, wide};
+				assert(latex::write_matrix_display_size(w6, latex::MatrixBrackets::BMatrix, &bytes) == ErrorCode::Ok);
+				assert(bytes <= latex::matrix_display_bound(6, 6));
+
+				assert(latex::write_matrix_size(matrix_core::MatrixView{1, 1, 1, nullptr}, latex::MatrixBrackets::BMatrix, &bytes) ==
+				       ErrorCode::Internal);
+				assert(latex::write_augmented_matrix_size(left, w6, &bytes) == ErrorCode::DimensionMismatch);
+		}
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rational] after measured latex asserts\n");
+#endif
+
+		// Writer: digit pairs across the 32 bit boundary, bulk appends, deferred terminator
+		{
+				char buf[64];
+				matrix_core::Writer w{buf, sizeof(buf), 0};
+				const std::uint64_t vals[] = {0u, 7u, 10u, 99u, 100u, 4294967295u, 4294967296u, 18446744073709551615u};
+				const char* texts[] = {"0", "7", "10", "99", "100", "4294967295", "4294967296", "18446744073709551615"};
+				for (std::size_t i = 0; i < sizeof(vals) / sizeof(vals[0]); i++) {
+						w.len = 0;
+						assert(w.append_u64(vals[i]) == ErrorCode::Ok);
+						assert(std::strcmp(buf, texts[i]) == 0);
+				}
+				w.len = 0;
+				assert(w.append_i64(std::numeric_limits<std::int64_t>::min()) == ErrorCode::Ok);
+				assert(std::strcmp(buf, "-9223372036854775808") == 0);
+				w.len = 0;
+				assert(w.append_rational_latex(make(std::numeric_limits<std::int64_t>::min() + 1, 3)) == ErrorCode::Ok);
+				assert(std::strcmp(buf, "\\frac{-9223372036854775807}{3}") == 0);
+
+				// a bulk append that does not fit writes nothing
+				char small[8];
+				matrix_core::Writer s8{small, sizeof(small), 0};
+				assert(s8.append("abc", 3) == ErrorCode::Ok);
+				assert(s8.append("defgh", 5) == ErrorCode::BufferTooSmall);
+				assert(s8.len == 3 && std::strcmp(small, "abc") == 0);
+				assert(s8.append("defg", 4) == ErrorCode::Ok);
+				assert(std::strcmp(small, "abcdefg") == 0);
+
+				matrix_core::Writer d{buf, sizeof(buf), 0};
+				d.defer_terminator = true;
+				std::memset(buf, 'x', sizeof(buf));
+				assert(d.append("ab") == ErrorCode::Ok && d.put('c') == ErrorCode::Ok);
+				assert(buf[3] == 'x');
+				d.terminate();
+				assert(std::strcmp(buf, "abc") == 0);
+		}
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rational] after writer asserts\n");
+#endif
+
+		// common denominator factoring
+		{
+				namespace latex = matrix_core::latex;
+				constexpr latex::MatrixStyle kFactor = latex::MatrixStyle::FactorDenominator;
+				char buf[160];
+				Rational sixths[4] = {make(1, 2), make(1, 3), make(1, 6), Rational::from_int(0)};
+				const matrix_core::MatrixView m{2, 2, 2, sixths};
+				std::int64_t d = 0;
+				assert(latex::common_denominator(m, &d) == ErrorCode::Ok && d == 6);
+				assert(latex::write_matrix_display(m, latex::MatrixBrackets::BMatrix, kFactor, {buf, sizeof(buf)}) == ErrorCode::Ok);
+				assert(std::strcmp(buf, "$$\\frac{1}{6}\\begin{bmatrix}3 & 2 \\\\ 1 & 0\\end{bmatrix}$$") == 0);
+				std::size_t bytes = 0;
+				assert(latex::write_matrix_display_size(m, latex::MatrixBrackets::BMatrix, kFactor, &bytes) == ErrorCode::Ok);
+				assert(bytes == std::strlen(buf) + 1);
+				assert(latex::write_matrix_display(m, latex::MatrixBrackets::BMatrix, kFactor, {buf, 20}) == ErrorCode::BufferTooSmall);
+				assert(latex::write_matrix_display(m, latex::MatrixBrackets::BMatrix, kFactor, {buf, bytes - 1}) ==
+				       ErrorCode::BufferTooSmall);
+
+				// a determinant, or a form that comes out longer, stays plain
+				char plain[160];
+				assert(latex::write_matrix_display(m, latex::MatrixBrackets::VMatrix, {plain, sizeof(plain)}) == ErrorCode::Ok);
+				assert(latex::write_matrix_display(m, latex::MatrixBrackets::VMatrix, kFactor, {buf, sizeof(buf)}) == ErrorCode::Ok);
+				assert(std::strcmp(buf, plain) == 0);
+				Rational mostly_ints[4] = {make(1, 1000), Rational::from_int(1), Rational::from_int(2), Rational::from_int(3)};
+				const matrix_core::MatrixView row{1, 4, 4, mostly_ints};
+				assert(latex::write_matrix_display(row, latex::MatrixBrackets::PMatrix, {plain, sizeof(plain)}) == ErrorCode::Ok);
+				assert(latex::write_matrix_display(row, latex::MatrixBrackets::PMatrix, kFactor, {buf, sizeof(buf)}) == ErrorCode::Ok);
+				assert(std::strcmp(buf, plain) == 0);
+				assert(latex::write_matrix_display_size(row, latex::MatrixBrackets::PMatrix, kFactor, &bytes) == ErrorCode::Ok);
+				assert(bytes == std::strlen(plain) + 1);
+
+				// write_rows_display comes out as the full write, fragments or not
+				assert(latex::write_rows_display_size(m, matrix_core::MatrixView{}, &bytes) == ErrorCode::Ok);
+				assert(latex::write_matrix_display(m, latex::MatrixBrackets::BMatrix, {plain, sizeof(plain)}) == ErrorCode::Ok);
+				assert(bytes == std::strlen(plain) + 1);
+				const matrix_core::MatrixView col{2, 1, 2, sixths + 1};
+				assert(latex::write_rows_display_size(m, col, &bytes) == ErrorCode::Ok);
+				assert(latex::write_augmented_matrix_display(m, col, {plain, sizeof(plain)}) == ErrorCode::Ok);
+				assert(bytes == std::strlen(plain) + 1);
+				assert(latex::write_rows_display_size(m, row, &bytes) == ErrorCode::DimensionMismatch);
+
+				// coprime denominators whose product overflows
+				Rational coprime[2] = {make(1, 4000000000), make(1, 4000000001)};
+				const matrix_core::MatrixView big{1, 2, 2, coprime};
+				assert(latex::common_denominator(big, &d) == ErrorCode::Overflow);
+				assert(latex::write_matrix_display(big, latex::MatrixBrackets::BMatrix, {plain, sizeof(plain)}) == ErrorCode::Ok);
+				assert(latex::write_matrix_display(big, latex::MatrixBrackets::BMatrix, kFactor, {buf, sizeof(buf)}) == ErrorCode::Ok);
+				assert(std::strcmp(buf, plain) == 0);
+		}
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rational] after factored latex asserts\n");
+#endif
+
 		return 0;
 }
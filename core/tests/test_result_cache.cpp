@@ -0,0 +1,117 @@
+#include "matrix_core/matrix_core.hpp"
+
+#include "test_dbg_ce.hpp"
+
+#include <cassert>
+#include <utility>
+
+#if defined(MATRIX_CE_TESTS)
+#include <debug.h>
+#endif
+
+using matrix_core::Arena;
+using matrix_core::ErrorCode;
+using matrix_core::ExplainOptions;
+using matrix_core::Explanation;
+using matrix_core::MatrixMutView;
+using matrix_core::Rational;
+using matrix_core::ResultCache;
+using matrix_core::ResultKey;
+using matrix_core::Slab;
+using matrix_core::StepRenderBuffers;
+
+static MatrixMutView mat3(Arena& a, const std::int64_t (&vals)[3][3]) {
+		MatrixMutView m;
+		assert(matrix_core::matrix_alloc(a, 3, 3, &m) == ErrorCode::Ok);
+		for (std::uint8_t r = 0; r < 3; r++) {
+				for (std::uint8_t c = 0; c < 3; c++)
+						m.at_mut(r, c) = Rational::from_int(vals[r][c]);
+		}
+		return m;
+}
+
+int main() {
+#if defined(MATRIX_CE_TESTS)
+#ifdef NDEBUG
+		dbg_printf("[test_result_cache] NDEBUG defined (asserts off)\n");
+#else
+		dbg_printf("[test_result_cache] NDEBUG not defined (asserts on)\n");
+#endif
+#endif
+		Slab slab;
+		assert(slab.init(32 * 1024) == ErrorCode::Ok);
+
+		Arena persist(slab.data(), slab.size() / 2);
+		Arena scratch(slab.data() + (slab.size() / 2), slab.size() - (slab.size() / 2));
+
+#if defined(MATRIX_CE_TESTS)
+		static char caption[128];
+		static char latex[1024];
+#else
+		char caption[128];
+		char latex[1024];
+#endif
+		StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+
+		// result cache: hits hand back the same explanation, LRU eviction, release
+		{
+				alignas(Rational) static unsigned char blocks[2][512];
+				ResultCache cache;
+				ResultKey key;
+				key.op = 1;
+				key.a = 42;
+				MatrixMutView a = mat3(persist, {{0, 2, 1}, {1, 1, 1}, {2, 1, 3}});
+				assert(cache.begin(key, a.view()) == nullptr);
+				assert(cache.add_block(blocks[0], sizeof(blocks[0])) == ErrorCode::Ok);
+				assert(cache.add_block(blocks[1], sizeof(blocks[1])) == ErrorCode::Ok);
+				assert(cache.block_count() == 2);
+				assert(cache.find(key, a.view()) == nullptr);
+
+				ResultCache::Entry* fill = cache.begin(key, a.view());
+				assert(fill);
+				Rational* det = static_cast<Rational*>(fill->arena.allocate(sizeof(Rational), alignof(Rational)));
+				assert(det);
+				Explanation expl;
+				const ExplainOptions opts{.enable = true, .persist = &fill->arena};
+				assert(matrix_core::is_ok(matrix_core::op_det(a.view(), scratch, det, &expl, opts)));
+				const std::size_t steps = expl.step_count();
+				cache.commit(fill, std::move(expl), det);
+
+				const ResultCache::Entry* hit = cache.find(key, a.view());
+				assert(hit && hit->payload == det);
+				assert(cache.hits() == 1 && cache.misses() == 1);
+
+				// a matching key over different entries (a hash collision) misses
+				MatrixMutView b = mat3(persist, {{0, 2, 1}, {1, 1, 1}, {2, 1, 4}});
+				assert(cache.find(key, b.view()) == nullptr);
+				assert(cache.hits() == 1);
+				{
+						Explanation borrowed = hit->expl.borrow();
+						assert(borrowed.step_count() == steps);
+						assert(borrowed.render_step(0, bufs) == ErrorCode::Ok);
+				}
+				// dropping the borrow leaves the cached one usable
+				assert(hit->expl.available() && hit->expl.step_count() == steps);
+
+				// a second key fills the other block, a third evicts the older one
+				ResultKey other = key;
+				other.tag = 1;
+				cache.commit(cache.begin(other, a.view()), Explanation{}, nullptr);
+				assert(cache.find(key, a.view()) != nullptr);
+				ResultKey third = key;
+				third.b = 7;
+				cache.commit(cache.begin(third, a.view()), Explanation{}, nullptr);
+				assert(cache.find(other, a.view()) == nullptr);
+				assert(cache.find(key, a.view()) != nullptr && cache.find(third, a.view()) != nullptr);
+
+				cache.release();
+				assert(cache.block_count() == 0);
+				assert(cache.find(key, a.view()) == nullptr);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_result_cache] after result cache asserts\n");
+#endif
+
+		return 0;
+}
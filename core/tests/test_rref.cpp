@@ -10,6 +10,7 @@
 #endif
 
 using matrix_core::Arena;
+using matrix_core::AugmentedView;
 using matrix_core::EchelonKind;
 using matrix_core::ErrorCode;
 using matrix_core::ExplainOptions;
@@ -19,6 +20,37 @@ using matrix_core::Rational;
 using matrix_core::Slab;
 using matrix_core::StepRenderBuffers;
 
+// what a streamed step handed over
+struct Collected {
+		char text[4096];
+		std::size_t len = 0;
+		std::size_t chunks = 0;
+		bool fail = false;
+};
+
+static ErrorCode collect(void* ctx, const char* data, std::size_t n) noexcept {
+		auto* c = static_cast<Collected*>(ctx);
+		if (c->fail)
+				return ErrorCode::Overflow;
+		if (c->len + n >= sizeof(c->text))
+				return ErrorCode::BufferTooSmall;
+		std::memcpy(c->text + c->len, data, n);
+		c->len += n;
+		c->text[c->len] = '\0';
+		c->chunks++;
+		return ErrorCode::Ok;
+}
+
+static MatrixMutView mat3(Arena& a, const std::int64_t (&vals)[3][3]) {
+		MatrixMutView m;
+		assert(matrix_core::matrix_alloc(a, 3, 3, &m) == ErrorCode::Ok);
+		for (std::uint8_t r = 0; r < 3; r++) {
+				for (std::uint8_t c = 0; c < 3; c++)
+						m.at_mut(r, c) = Rational::from_int(vals[r][c]);
+		}
+		return m;
+}
+
 int main() {
 #if defined(MATRIX_CE_TESTS)
 #ifdef NDEBUG
@@ -155,5 +187,508 @@ int main() {
 		dbg_printf("[test_rref] after dim-mismatch asserts\n");
 #endif
 
+		// [A | b] through an augmented view: same RREF as the materialized copy,
+		// only the explanation context in persist, steps drawn with the bar
+		{
+				MatrixMutView sys;
+				MatrixMutView rhs;
+				assert(matrix_core::matrix_alloc(persist, 2, 2, &sys) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 2, 1, &rhs) == ErrorCode::Ok);
+				const std::int64_t vals[2][3] = {{0, 2, 4}, {3, 1, 5}};
+				for (std::uint8_t r = 0; r < 2; r++) {
+						sys.at_mut(r, 0) = Rational::from_int(vals[r][0]);
+						sys.at_mut(r, 1) = Rational::from_int(vals[r][1]);
+						rhs.at_mut(r, 0) = Rational::from_int(vals[r][2]);
+				}
+
+				MatrixMutView copy;
+				MatrixMutView ref;
+				MatrixMutView rref;
+				assert(matrix_core::matrix_alloc(persist, 2, 3, &copy) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 2, 3, &ref) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 2, 3, &rref) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < 2; r++) {
+						for (std::uint8_t c = 0; c < 3; c++)
+								copy.at_mut(r, c) = Rational::from_int(vals[r][c]);
+				}
+				Explanation ref_expl;
+				assert(matrix_core::is_ok(matrix_core::op_echelon(
+				        copy.view(), EchelonKind::Rref, ref, &ref_expl, ExplainOptions{.enable = true, .persist = &persist})));
+
+				AugmentedView aug;
+				assert(matrix_core::augmented_view(sys.view(), rhs.view(), &aug) == ErrorCode::Ok);
+				assert(aug.cols() == 3 && aug.at(1, 2).num() == 5);
+
+				Explanation aug_expl;
+				const std::size_t used = persist.used();
+				auto err2 = matrix_core::op_echelon_augmented(
+				        aug, EchelonKind::Rref, rref, &aug_expl, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err2));
+				assert(persist.used() - used < sizeof(Rational) * 6);
+				for (std::uint8_t r = 0; r < 2; r++) {
+						for (std::uint8_t c = 0; c < 3; c++)
+								assert(rref.at(r, c).num() == ref.at(r, c).num() && rref.at(r, c).den() == ref.at(r, c).den());
+				}
+				// x = (1, 2)
+				assert(rref.at(0, 2).num() == 1 && rref.at(1, 2).num() == 2);
+
+				assert(aug_expl.step_count() == ref_expl.step_count());
+				for (std::size_t i = 0; i < aug_expl.step_count(); i++) {
+						assert(aug_expl.render_step(i, bufs) == ErrorCode::Ok);
+						assert(std::strstr(latex, "{rr|r}") != nullptr);
+				}
+
+				MatrixMutView tall;
+				assert(matrix_core::matrix_alloc(persist, 3, 1, &tall) == ErrorCode::Ok);
+				assert(matrix_core::augmented_view(sys.view(), tall.view(), &aug) == ErrorCode::DimensionMismatch);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rref] after augmented view asserts\n");
+#endif
+
+		// A X = B: one shared elimination for every right-hand side
+		{
+				MatrixMutView sys;
+				MatrixMutView rhs;
+				MatrixMutView x;
+				assert(matrix_core::matrix_alloc(persist, 2, 2, &sys) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 2, 2, &rhs) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 2, 2, &x) == ErrorCode::Ok);
+				const std::int64_t avals[2][2] = {{0, 2}, {3, 1}};
+				const std::int64_t bvals[2][2] = {{4, 2}, {5, 1}};
+				for (std::uint8_t r = 0; r < 2; r++) {
+						for (std::uint8_t c = 0; c < 2; c++) {
+								sys.at_mut(r, c) = Rational::from_int(avals[r][c]);
+								rhs.at_mut(r, c) = Rational::from_int(bvals[r][c]);
+						}
+				}
+
+				Explanation multi;
+				auto err2 = matrix_core::op_solve_multi(
+				        sys.view(), rhs.view(), scratch, x, &multi, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err2));
+				// X = [1 0; 2 1]
+				assert(x.at(0, 0).num() == 1 && x.at(1, 0).num() == 2);
+				assert(x.at(0, 1).is_zero() && x.at(1, 1).num() == 1);
+
+				// same row operations as one RREF of the materialized [A | B]
+				MatrixMutView copy;
+				MatrixMutView ref;
+				assert(matrix_core::matrix_alloc(persist, 2, 4, &copy) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, 2, 4, &ref) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < 2; r++) {
+						for (std::uint8_t c = 0; c < 2; c++) {
+								copy.at_mut(r, c) = Rational::from_int(avals[r][c]);
+								copy.at_mut(r, static_cast<std::uint8_t>(c + 2)) = Rational::from_int(bvals[r][c]);
+						}
+				}
+				Explanation ref_expl;
+				assert(matrix_core::is_ok(matrix_core::op_echelon(
+				        copy.view(), EchelonKind::Rref, ref, &ref_expl, ExplainOptions{.enable = true, .persist = &persist})));
+				assert(multi.step_count() == ref_expl.step_count());
+				for (std::size_t i = 0; i < multi.step_count(); i++) {
+						assert(multi.render_step(i, bufs) == ErrorCode::Ok);
+						assert(std::strstr(latex, "{rr|rr}") != nullptr);
+				}
+				assert(multi.render_step(multi.step_count(), bufs) == ErrorCode::StepOutOfRange);
+
+				// second column has no solution
+				sys.at_mut(0, 0) = Rational::from_int(1);
+				sys.at_mut(0, 1) = Rational::from_int(1);
+				sys.at_mut(1, 0) = Rational::from_int(2);
+				sys.at_mut(1, 1) = Rational::from_int(2);
+				rhs.at_mut(0, 0) = Rational::from_int(1);
+				rhs.at_mut(1, 0) = Rational::from_int(2);
+				rhs.at_mut(0, 1) = Rational::from_int(2);
+				rhs.at_mut(1, 1) = Rational::from_int(5);
+				err2 = matrix_core::op_solve_multi(sys.view(), rhs.view(), scratch, x, nullptr, ExplainOptions{});
+				assert(err2.code == ErrorCode::Inconsistent && err2.j == 1);
+		}
+
+		// 6x6 A with a 6x6 B: wider than any one matrix may be
+		{
+				constexpr std::uint8_t n = 6;
+				MatrixMutView sys;
+				MatrixMutView x;
+				assert(matrix_core::matrix_alloc(persist, n, n, &sys) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, n, n, &x) == ErrorCode::Ok);
+				// lower triangular ones with the first two rows swapped, B = A so X = I
+				for (std::uint8_t r = 0; r < n; r++) {
+						const std::uint8_t row = (r < 2) ? static_cast<std::uint8_t>(1 - r) : r;
+						for (std::uint8_t c = 0; c < n; c++)
+								sys.at_mut(row, c) = Rational::from_int(c <= r ? 1 : 0);
+				}
+
+				Explanation wide;
+				auto err2 = matrix_core::op_solve_multi(
+				        sys.view(), sys.view(), scratch, x, &wide, ExplainOptions{.enable = true, .persist = &persist});
+				assert(matrix_core::is_ok(err2));
+				for (std::uint8_t r = 0; r < n; r++) {
+						for (std::uint8_t c = 0; c < n; c++)
+								assert(x.at(r, c).num() == (r == c ? 1 : 0) && x.at(r, c).den() == 1);
+				}
+
+#if defined(MATRIX_CE_TESTS)
+				static char wide_latex[1024];
+#else
+				char wide_latex[1024];
+#endif
+				StepRenderBuffers wide_bufs{caption, sizeof(caption), wide_latex, sizeof(wide_latex), &scratch};
+				for (std::size_t i = 0; i < wide.step_count(); i++)
+						assert(wide.render_step(i, wide_bufs) == ErrorCode::Ok);
+				assert(std::strstr(wide_latex, "{rrrrrr|rrrrrr}") != nullptr);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rref] after multi solve asserts\n");
+#endif
+
+		// sliced echelon: one op per run matches the one shot reduction
+		{
+				constexpr std::uint8_t n = 4;
+				MatrixMutView src;
+				MatrixMutView whole;
+				MatrixMutView sliced;
+				assert(matrix_core::matrix_alloc(persist, n, n, &src) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, n, n, &whole) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, n, n, &sliced) == ErrorCode::Ok);
+				const std::int64_t vals[n][n] = {{0, 2, 1, 3}, {2, 4, -2, 1}, {1, 1, 0, 5}, {3, 7, -1, 9}};
+				for (std::uint8_t r = 0; r < n; r++) {
+						for (std::uint8_t c = 0; c < n; c++)
+								src.at_mut(r, c) = Rational::from_int(vals[r][c]);
+				}
+
+				for (EchelonKind kind : {EchelonKind::Ref, EchelonKind::Rref}) {
+						Explanation once;
+						assert(matrix_core::is_ok(matrix_core::op_echelon(
+						        src.view(), kind, whole, &once, ExplainOptions{.enable = true, .persist = &persist})));
+
+						matrix_core::EchelonTask task;
+						AugmentedView in{src.view(), MatrixMutView{}.view()};
+						assert(matrix_core::is_ok(matrix_core::op_echelon_begin(in, kind, sliced, &task)));
+						assert(matrix_core::op_echelon_progress(task) == 0);
+
+						Explanation resumed;
+						std::size_t runs = 0;
+						std::uint8_t last_progress = 0;
+						matrix_core::Error run_err;
+						do {
+								run_err = matrix_core::op_echelon_run(
+								        &task, 1, &resumed, ExplainOptions{.enable = true, .persist = &persist});
+								assert(matrix_core::op_echelon_progress(task) >= last_progress);
+								last_progress = matrix_core::op_echelon_progress(task);
+								runs++;
+						} while (run_err.code == ErrorCode::Pending);
+						assert(matrix_core::is_ok(run_err));
+						assert(runs > 1);
+						assert(last_progress == 100);
+						assert(task.obs.count == once.step_count() - 1);
+						assert(resumed.step_count() == once.step_count());
+						for (std::uint8_t r = 0; r < n; r++) {
+								for (std::uint8_t c = 0; c < n; c++)
+										assert(sliced.at(r, c).num() == whole.at(r, c).num() &&
+										        sliced.at(r, c).den() == whole.at(r, c).den());
+						}
+				}
+
+				// a task cut short stays Pending and leaves out partly reduced
+				matrix_core::EchelonTask task;
+				AugmentedView in{src.view(), MatrixMutView{}.view()};
+				assert(matrix_core::is_ok(matrix_core::op_echelon_begin(in, EchelonKind::Rref, sliced, &task)));
+				// a budget of 0 applies nothing
+				assert(matrix_core::op_echelon_run(&task, 0, nullptr, ExplainOptions{}).code == ErrorCode::Pending);
+				assert(task.obs.count == 0 && !task.cursor.done && matrix_core::op_echelon_progress(task) == 0);
+				assert(task.obs.budget == 0);
+				assert(matrix_core::op_echelon_run(&task, 1, nullptr, ExplainOptions{}).code == ErrorCode::Pending);
+				assert(task.obs.count == 1 && !task.cursor.done);
+				assert(matrix_core::op_echelon_run(nullptr, 1, nullptr, ExplainOptions{}).code == ErrorCode::Internal);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rref] after sliced echelon asserts\n");
+#endif
+
+		// compact detail: one step per pivot column, ending on the same matrix
+		{
+				constexpr std::uint8_t n = 3;
+				MatrixMutView src = mat3(persist, {{0, 2, 1}, {3, -1, 4}, {1, 5, 2}});
+				MatrixMutView reduced;
+				assert(matrix_core::matrix_alloc(persist, n, n, &reduced) == ErrorCode::Ok);
+
+				Explanation full;
+				Explanation compact;
+				assert(matrix_core::is_ok(matrix_core::op_echelon(
+				        src.view(), EchelonKind::Rref, reduced, &full, ExplainOptions{.enable = true, .persist = &persist})));
+				assert(matrix_core::is_ok(matrix_core::op_echelon(
+				        src.view(), EchelonKind::Rref, reduced, &compact,
+				        ExplainOptions{.enable = true, .persist = &persist, .detail = matrix_core::ExplainDetail::Compact})));
+				// A, then one step per pivot column
+				assert(compact.step_count() == n + 1);
+				assert(compact.step_count() < full.step_count());
+
+				char full_latex[512];
+				assert(full.render_step(full.step_count() - 1, bufs) == ErrorCode::Ok);
+				std::strcpy(full_latex, latex);
+				assert(compact.render_step(n, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(latex, full_latex) == 0);
+				assert(std::strncmp(caption, "Pivot $R_{3}$, clear $C_{3}$", 28) == 0);
+				assert(compact.render_step(n + 1, bufs) == ErrorCode::StepOutOfRange);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rref] after compact asserts\n");
+#endif
+
+		// step cache: repeats come back without rendering, LRU eviction
+		{
+				MatrixMutView src = mat3(persist, {{0, 2, 1}, {3, -1, 4}, {1, 5, 2}});
+				MatrixMutView reduced;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &reduced) == ErrorCode::Ok);
+				Explanation steps;
+				assert(matrix_core::is_ok(matrix_core::op_echelon(
+				        src.view(), EchelonKind::Rref, reduced, &steps, ExplainOptions{.enable = true, .persist = &persist})));
+
+				matrix_core::StepCache cache;
+				assert(cache.init(persist, 2, sizeof(caption), sizeof(latex)) == ErrorCode::Ok);
+				StepRenderBuffers cached = bufs;
+				cached.cache = &cache;
+
+				char plain_latex[512];
+				assert(steps.render_step(2, bufs) == ErrorCode::Ok);
+				std::strcpy(plain_latex, latex);
+
+				assert(steps.render_step(1, cached) == ErrorCode::Ok);
+				assert(steps.render_step(2, cached) == ErrorCode::Ok);
+				latex[0] = '\0';
+				assert(steps.render_step(2, cached) == ErrorCode::Ok);
+				assert(std::strcmp(latex, plain_latex) == 0);
+				assert(cache.hits() == 1 && cache.misses() == 2);
+
+				// 1 is the least recently used, 3 takes its entry
+				assert(steps.render_step(3, cached) == ErrorCode::Ok);
+				assert(steps.render_step(2, cached) == ErrorCode::Ok);
+				assert(steps.render_step(1, cached) == ErrorCode::Ok);
+				assert(cache.hits() == 2 && cache.misses() == 4);
+
+				// a cached step that does not fit the caller's buffer renders again
+				char tiny_latex[8];
+				StepRenderBuffers tiny{caption, sizeof(caption), tiny_latex, sizeof(tiny_latex), &scratch, &cache};
+				assert(steps.render_step(1, tiny) == ErrorCode::BufferTooSmall);
+
+				cache.clear();
+				assert(steps.render_step(1, cached) == ErrorCode::Ok);
+				assert(cache.hits() == 2 && cache.misses() == 6);
+
+				// the same step in another style, or of an explanation built
+				// again at the same address with another detail, is not a hit
+				char full_latex[512];
+				std::strcpy(full_latex, latex);
+				StepRenderBuffers factored = cached;
+				factored.style = matrix_core::latex::MatrixStyle::FactorDenominator;
+				assert(steps.render_step(1, factored) == ErrorCode::Ok);
+				assert(cache.hits() == 2 && cache.misses() == 7);
+
+				const std::size_t at = persist.mark();
+				Explanation again;
+				assert(matrix_core::is_ok(matrix_core::op_echelon(
+				        src.view(), EchelonKind::Rref, reduced, &again, ExplainOptions{.enable = true, .persist = &persist})));
+				assert(again.render_step(1, cached) == ErrorCode::Ok);
+				assert(std::strcmp(latex, full_latex) == 0);
+				again = Explanation{};
+				persist.rewind(at);
+				assert(matrix_core::is_ok(matrix_core::op_echelon(src.view(), EchelonKind::Rref, reduced, &again,
+				        ExplainOptions{.enable = true, .persist = &persist, .detail = matrix_core::ExplainDetail::Compact})));
+				assert(again.render_step(1, cached) == ErrorCode::Ok);
+				assert(std::strcmp(latex, full_latex) != 0);
+				char compact_latex[512];
+				std::strcpy(compact_latex, latex);
+				assert(again.render_step(1, bufs) == ErrorCode::Ok);
+				assert(std::strcmp(latex, compact_latex) == 0);
+				assert(cache.hits() == 2 && cache.misses() == 9);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rref] after step cache asserts\n");
+#endif
+
+		// row fragments: the same LaTeX as a full write, only changed rows formatted
+		{
+				constexpr std::uint8_t n = 4;
+				MatrixMutView src;
+				MatrixMutView reduced;
+				assert(matrix_core::matrix_alloc(persist, n, n, &src) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, n, n, &reduced) == ErrorCode::Ok);
+				const std::int64_t vals[n][n] = {{0, 2, 1, 3}, {3, -1, 4, 1}, {1, 5, 2, -2}, {2, 1, -3, 4}};
+				for (std::uint8_t r = 0; r < n; r++) {
+						for (std::uint8_t c = 0; c < n; c++)
+								src.at_mut(r, c) = Rational::from_int(vals[r][c]);
+				}
+				Explanation steps;
+				assert(matrix_core::is_ok(matrix_core::op_echelon(
+				        src.view(), EchelonKind::Rref, reduced, &steps, ExplainOptions{.enable = true, .persist = &persist})));
+
+				matrix_core::latex::RowFragments frags;
+				assert(frags.init(persist, 96) == ErrorCode::Ok);
+				StepRenderBuffers rowed = bufs;
+				rowed.rows = &frags;
+
+				char plain_latex[512];
+				std::size_t full_rows = 0;
+				for (std::size_t i = 0; i < steps.step_count(); i++) {
+						assert(steps.render_step(i, bufs) == ErrorCode::Ok);
+						std::strcpy(plain_latex, latex);
+						assert(steps.render_step(i, rowed) == ErrorCode::Ok);
+						assert(std::strcmp(latex, plain_latex) == 0);
+						full_rows += n;
+				}
+				// every step after the first wrote one row, or two for a swap
+				assert(frags.rows_written() < full_rows / 2);
+
+				// the same step again writes nothing, going back writes every row
+				const std::size_t before = frags.rows_written();
+				assert(steps.render_step(steps.step_count() - 1, rowed) == ErrorCode::Ok);
+				assert(frags.rows_written() == before);
+				assert(steps.render_step(1, rowed) == ErrorCode::Ok);
+				assert(frags.rows_written() == before + n);
+				assert(steps.render_step(1, bufs) == ErrorCode::Ok);
+				std::strcpy(plain_latex, latex);
+				assert(steps.render_step(1, rowed) == ErrorCode::Ok);
+				assert(std::strcmp(latex, plain_latex) == 0);
+
+				// a row that does not fit its fragment falls back to a full write
+				matrix_core::latex::RowFragments narrow;
+				assert(narrow.init(persist, 4) == ErrorCode::Ok);
+				rowed.rows = &narrow;
+				assert(steps.render_step(2, bufs) == ErrorCode::Ok);
+				std::strcpy(plain_latex, latex);
+				assert(steps.render_step(2, rowed) == ErrorCode::Ok);
+				assert(std::strcmp(latex, plain_latex) == 0);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rref] after row fragment asserts\n");
+#endif
+
+		// render_document: caption, newline, LaTeX in one buffer
+		{
+				char doc_buf[sizeof(caption) + 1 + sizeof(latex)];
+				matrix_core::StepDocument doc{doc_buf, sizeof(doc_buf), sizeof(caption)};
+				char expect[sizeof(caption) + 1 + sizeof(latex)];
+
+				assert(expl.render_step(1, bufs) == ErrorCode::Ok);
+				std::strcpy(expect, caption);
+				std::strcat(expect, "\n");
+				std::strcat(expect, latex);
+				assert(expl.render_document(1, bufs, &doc) == ErrorCode::Ok);
+				assert(doc.text != nullptr && std::strcmp(doc.text, expect) == 0);
+
+				// step 0 has no caption
+				assert(expl.render_step(0, bufs) == ErrorCode::Ok);
+				assert(expl.render_document(0, bufs, &doc) == ErrorCode::Ok);
+				assert(std::strcmp(doc.text, latex) == 0);
+
+				matrix_core::StepDocument small{doc_buf, 24, sizeof(caption)};
+				assert(expl.render_document(1, bufs, &small) == ErrorCode::BufferTooSmall);
+				assert(small.text == nullptr);
+
+				// a step that does not fit is measured and refused before any
+				// of its LaTeX is written
+				std::size_t bytes = 0;
+				assert(expl.step_latex_size(1, bufs, &bytes) == ErrorCode::Ok);
+				assert(expl.render_step(1, bufs) == ErrorCode::Ok);
+				assert(bytes == std::strlen(latex) + 1);
+				std::memset(doc_buf, 'x', sizeof(doc_buf));
+				matrix_core::StepDocument tight{doc_buf, sizeof(caption) + bytes, sizeof(caption)};
+				assert(expl.render_document(1, bufs, &tight) == ErrorCode::BufferTooSmall);
+				assert(tight.text == nullptr && doc_buf[0] == '\0' && doc_buf[sizeof(caption) + 1] == '\0');
+				assert(doc_buf[sizeof(caption) + 2] == 'x');
+				tight.cap = sizeof(caption) + 1 + bytes;
+				assert(expl.render_document(1, bufs, &tight) == ErrorCode::Ok);
+				assert(std::strcmp(tight.text, expect) == 0);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rref] after step document asserts\n");
+#endif
+
+		// FactorDenominator steps: a plain matrix, or 1/d times an integer one
+		{
+				MatrixMutView src = mat3(persist, {{3, 1, 2}, {1, 3, 1}, {2, 1, 3}});
+				MatrixMutView reduced;
+				assert(matrix_core::matrix_alloc(persist, 3, 3, &reduced) == ErrorCode::Ok);
+				Explanation steps;
+				assert(matrix_core::is_ok(matrix_core::op_echelon(
+				        src.view(), EchelonKind::Rref, reduced, &steps, ExplainOptions{.enable = true, .persist = &persist})));
+
+				StepRenderBuffers factored = bufs;
+				factored.style = matrix_core::latex::MatrixStyle::FactorDenominator;
+				char plain_latex[512];
+				std::size_t shorter = 0;
+				for (std::size_t i = 0; i < steps.step_count(); i++) {
+						assert(steps.render_step(i, bufs) == ErrorCode::Ok);
+						std::strcpy(plain_latex, latex);
+						assert(steps.render_step(i, factored) == ErrorCode::Ok);
+						if (std::strcmp(latex, plain_latex) != 0) {
+								assert(std::strncmp(latex, "$$\\frac{1}{", 11) == 0);
+								assert(std::strlen(latex) < std::strlen(plain_latex));
+								shorter++;
+						}
+				}
+				assert(shorter > 0);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rref] after factored step asserts\n");
+#endif
+
+		// stream_step: any step through a 40 byte chunk buffer, matrices a row at a time
+		{
+				constexpr std::uint8_t n = 6;
+				MatrixMutView src;
+				MatrixMutView reduced;
+				assert(matrix_core::matrix_alloc(persist, n, n, &src) == ErrorCode::Ok);
+				assert(matrix_core::matrix_alloc(persist, n, n, &reduced) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < n; r++) {
+						for (std::uint8_t c = 0; c < n; c++)
+								src.at_mut(r, c) = Rational::from_int((r == c) ? 7 : (r * 3 + c * 5) % 11 - 5);
+				}
+				Explanation steps;
+				assert(matrix_core::is_ok(matrix_core::op_echelon(
+				        src.view(), EchelonKind::Rref, reduced, &steps, ExplainOptions{.enable = true, .persist = &persist})));
+				Rational det;
+				Explanation det_steps;
+				assert(matrix_core::is_ok(
+				        matrix_core::op_det(src.view(), scratch, &det, &det_steps, ExplainOptions{.enable = true, .persist = &persist})));
+
+				static char whole[4096];
+				static Collected got;
+				char chunk[40];
+				StepRenderBuffers full{caption, sizeof(caption), whole, sizeof(whole), &scratch};
+				StepRenderBuffers chunked{caption, sizeof(caption), chunk, sizeof(chunk), &scratch};
+				const matrix_core::WriterSink sink{&got, &collect};
+				const Explanation* both[] = {&steps, &det_steps};
+				for (const Explanation* e : both) {
+						for (std::size_t i = 0; i < e->step_count(); i++) {
+								assert(e->render_step(i, full) == ErrorCode::Ok);
+								got.len = 0;
+								got.chunks = 0;
+								assert(e->stream_step(i, chunked, sink) == ErrorCode::Ok);
+								assert(got.len == std::strlen(whole) && std::strcmp(got.text, whole) == 0);
+								if (std::strstr(whole, "\\begin{") != nullptr)
+										assert(got.chunks >= n);
+						}
+				}
+				// too long for the chunk buffer as a whole
+				assert(steps.render_step(1, chunked) == ErrorCode::BufferTooSmall);
+
+				got.fail = true;
+				assert(steps.stream_step(1, chunked, sink) == ErrorCode::Overflow);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_rref] after stream asserts\n");
+#endif
+
 		return 0;
 }
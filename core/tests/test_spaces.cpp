@@ -3,6 +3,7 @@
 #include "test_dbg_ce.hpp"
 
 #include <cassert>
+#include <cstring>
 
 #if defined(MATRIX_CE_TESTS)
 #include <debug.h>
@@ -12,10 +13,14 @@ using matrix_core::Arena;
 using matrix_core::EchelonKind;
 using matrix_core::ErrorCode;
 using matrix_core::ExplainOptions;
+using matrix_core::Explanation;
+using matrix_core::FundamentalSpaces;
 using matrix_core::MatrixMutView;
 using matrix_core::Rational;
 using matrix_core::Slab;
 using matrix_core::SpaceInfo;
+using matrix_core::SpacesCache;
+using matrix_core::StepRenderBuffers;
 
 static MatrixMutView mat2(Arena& arena, std::int64_t a00, std::int64_t a01, std::int64_t a10, std::int64_t a11) {
 		MatrixMutView m;
@@ -141,5 +146,113 @@ int main() {
 		dbg_printf("[test_spaces] after augmented asserts\n");
 #endif
 
+		// all four subspaces from one RREF of [A | I]
+		{
+				MatrixMutView a;
+				assert(matrix_core::matrix_alloc(persist, 3, 2, &a) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < 3; r++) {
+						a.at_mut(r, 0) = Rational::from_int(r + 1);
+						a.at_mut(r, 1) = Rational::from_int(2 * (r + 1));
+				}
+
+				FundamentalSpaces f;
+				assert(matrix_core::space_factor(a.view(), persist, &f) == ErrorCode::Ok);
+				assert(f.info.rank == 1 && f.info.nullity == 1);
+				assert(f.reduced.rows == 3 && f.reduced.cols == 3);
+
+				MatrixMutView rbas;
+				MatrixMutView nbas;
+				MatrixMutView lbas;
+				assert(matrix_core::space_row_basis(f.reduced, 2, f.info, persist, &rbas) == ErrorCode::Ok);
+				assert(rbas.rows == 1 && rbas.at(0, 0).num() == 1 && rbas.at(0, 1).num() == 2);
+				assert(matrix_core::space_null_basis(f.reduced, 2, f.info, persist, &nbas) == ErrorCode::Ok);
+				assert(nbas.cols == 1 && nbas.at(0, 0).num() == -2 && nbas.at(1, 0).num() == 1);
+
+				// Null(A^T) has dimension m - rank, and y^T A = 0 for every basis vector
+				assert(matrix_core::space_left_null_basis(f, persist, &lbas) == ErrorCode::Ok);
+				assert(lbas.rows == 3 && lbas.cols == 2);
+				MatrixMutView ya;
+				assert(matrix_core::matrix_alloc(persist, 2, 2, &ya) == ErrorCode::Ok);
+				assert(matrix_core::matrix_mul(lbas.view().transposed(), a.view(), ya) == ErrorCode::Ok);
+				for (std::uint8_t r = 0; r < 2; r++) {
+						for (std::uint8_t c = 0; c < 2; c++)
+								assert(ya.at(r, c).is_zero());
+				}
+				FundamentalSpaces lf;
+				assert(matrix_core::space_factor(lbas.view(), persist, &lf) == ErrorCode::Ok);
+				assert(lf.info.rank == 2);
+
+				// full row rank: Null(A^T) = {0}
+				MatrixMutView wide;
+				assert(matrix_core::matrix_alloc(persist, 2, 3, &wide) == ErrorCode::Ok);
+				matrix_core::matrix_fill_zero(wide);
+				wide.at_mut(0, 0) = Rational::from_int(1);
+				wide.at_mut(1, 2) = Rational::from_int(4);
+				assert(matrix_core::space_factor(wide.view(), persist, &f) == ErrorCode::Ok);
+				assert(f.info.rank == 2 && f.info.nullity == 1);
+				assert(matrix_core::space_left_null_basis(f, persist, &lbas) == ErrorCode::Ok);
+				assert(lbas.rows == 2 && lbas.cols == 1 && lbas.at(0, 0).is_zero() && lbas.at(1, 0).is_zero());
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_spaces] after fundamental spaces asserts\n");
+#endif
+
+		// the cache reduces an unchanged matrix once; steps match op_echelon
+		{
+				SpacesCache cache;
+				assert(cache.init(persist, 1) == ErrorCode::Ok);
+				MatrixMutView a = mat2(persist, 0, 2, 3, 1);
+
+				const FundamentalSpaces* f = nullptr;
+				const FundamentalSpaces* g = nullptr;
+				Explanation expl;
+				const ExplainOptions opts{.enable = true, .persist = &persist};
+				assert(matrix_core::is_ok(matrix_core::op_fundamental_spaces(a.view(), cache, scratch, false, &f, &expl, opts)));
+				assert(f->info.rank == 2);
+				assert(matrix_core::is_ok(matrix_core::op_fundamental_spaces(a.view(), cache, scratch, true, &g, &expl, opts)));
+				assert(f == g && cache.misses() == 1 && cache.hits() == 1);
+
+#if defined(MATRIX_CE_TESTS)
+				static char caption[128];
+				static char latex[512];
+#else
+				char caption[128];
+				char latex[512];
+#endif
+				StepRenderBuffers bufs{caption, sizeof(caption), latex, sizeof(latex), &scratch};
+				for (std::size_t i = 0; i < expl.step_count(); i++) {
+						assert(expl.render_step(i, bufs) == ErrorCode::Ok);
+						assert(std::strstr(latex, "{rr|rr}") != nullptr);
+				}
+				// [I | A^{-1}] at the end
+				assert(std::strstr(latex, "1 & 0 &") != nullptr);
+
+				MatrixMutView rref;
+				Explanation ref;
+				assert(matrix_core::matrix_alloc(persist, 2, 2, &rref) == ErrorCode::Ok);
+				assert(matrix_core::is_ok(matrix_core::op_echelon(a.view(), EchelonKind::Rref, rref, &ref, opts)));
+				assert(ref.step_count() == expl.step_count());
+
+				a.at_mut(1, 1) = Rational::from_int(5);
+				assert(matrix_core::is_ok(
+				        matrix_core::op_fundamental_spaces(a.view(), cache, scratch, false, &f, nullptr, ExplainOptions{})));
+				assert(cache.misses() == 2);
+
+				// same contents at another address hit; other contents miss
+				MatrixMutView b = mat2(persist, 0, 2, 3, 5);
+				assert(matrix_core::is_ok(
+				        matrix_core::op_fundamental_spaces(b.view(), cache, scratch, false, &g, nullptr, ExplainOptions{})));
+				assert(f == g && cache.misses() == 2 && cache.hits() == 2);
+				b.at_mut(0, 0) = Rational::from_int(1);
+				assert(matrix_core::is_ok(
+				        matrix_core::op_fundamental_spaces(b.view(), cache, scratch, false, &g, nullptr, ExplainOptions{})));
+				assert(cache.misses() == 3);
+		}
+
+#if defined(MATRIX_CE_TESTS)
+		dbg_printf("[test_spaces] after spaces cache asserts\n");
+#endif
+
 		return 0;
 }
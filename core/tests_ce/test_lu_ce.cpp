@@ -0,0 +1,13 @@
+#include <debug.h>
+
+#define main matrix_test_lu_main
+#include "../tests/test_lu.cpp"
+#undef main
+
+int main() {
+		dbg_printf("[TSTLU] start\n");
+		const int rc = matrix_test_lu_main();
+		dbg_printf("[TSTLU] PASS rc=%d\n", rc);
+		return rc;
+}
+
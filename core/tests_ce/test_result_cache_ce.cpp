@@ -0,0 +1,12 @@
+#include <debug.h>
+
+#define main matrix_test_result_cache_main
+#include "../tests/test_result_cache.cpp"
+#undef main
+
+int main() {
+		dbg_printf("[TSTRES] start\n");
+		const int rc = matrix_test_result_cache_main();
+		dbg_printf("[TSTRES] PASS rc=%d\n", rc);
+		return rc;
+}
@@ -5,9 +5,14 @@
 
 #include "matrix_core/arena.hpp"
 #include "matrix_core/explanation.hpp"
+#include "matrix_core/latex.hpp"
+#include "matrix_core/lu.hpp"
 #include "matrix_core/matrix.hpp"
+#include "matrix_core/ops.hpp"
 #include "matrix_core/rational.hpp"
+#include "matrix_core/result_cache.hpp"
 #include "matrix_core/slab.hpp"
+#include "matrix_core/spaces.hpp"
 
 #include "matrix_shell/input.hpp"
 #include "matrix_shell/config.hpp"
@@ -19,6 +24,13 @@ namespace matrix_shell {
 
 constexpr std::size_t kMaxPageDepth = 8;
 constexpr std::uint8_t kSlotCount = 8;
+// a step caption, and the LaTeX of one step: any matrix the slots can hold,
+// augmented or not, whatever its entries. render_document measures a step
+// before writing it, so anything longer fails cleanly with BufferTooSmall
+constexpr std::size_t kStepCaptionBytes = 128;
+constexpr std::size_t kStepLatexBytes =
+        matrix_core::latex::augmented_matrix_display_bound(matrix_core::kMaxRows, matrix_core::kMaxCols - 1, 1);
+static_assert(matrix_core::latex::matrix_display_bound(matrix_core::kMaxRows, matrix_core::kMaxCols) <= kStepLatexBytes);
 
 enum class MenuId : std::uint8_t {
 		Main,
@@ -53,6 +65,7 @@ enum class OperationId : std::uint8_t {
 		CofactorElement,
 		Ref,
 		Rref,
+		Lu,
 };
 
 struct MenuState {
@@ -95,9 +108,12 @@ struct ResultState {
 		std::uint8_t rows;
 		std::uint8_t cols;
 		std::uint8_t stride;
+		std::uint8_t col_stride; // entry (r, c) is data[r * stride + c * col_stride]
 		const matrix_core::Rational* data;
 
 		// for scalar results that depend on element selection (cofactor element)
+		// Lu: i is the factor shown (0 = L, 1 = U, 2 = P), data holds [L | U | P]
+		// SolveRref: den > 1 is the number of right-hand sides, data holds X
 		std::uint8_t i;
 		std::uint8_t j;
 
@@ -132,6 +148,7 @@ enum class PageKind : std::uint8_t {
 		CramerStepsMenu,
 		Steps,
 		Confirm,
+		Busy,
 };
 
 struct CofactorElementState {
@@ -171,6 +188,12 @@ struct StepsState {
 		std::uint16_t index;
 };
 
+// a Ref/Rref running a few row operations per frame (App::busy_task_)
+struct BusyState {
+		OperationId op;
+		std::uint8_t slot;
+};
+
 struct Page {
 		PageKind kind;
 
@@ -185,6 +208,7 @@ struct Page {
 				CramerStepsMenuState cramer_steps;
 				StepsState steps;
 				ConfirmState confirm;
+				BusyState busy;
 		} u;
 
 		static Page make_menu(MenuId id) noexcept;
@@ -200,6 +224,9 @@ struct Page {
 		        std::uint8_t cols,
 		        std::uint8_t stride,
 		        const matrix_core::Rational* data) noexcept;
+		// matrix result backed by a (possibly strided, e.g. transposed) view
+		static Page make_result_view(
+		        OperationId op, std::uint8_t slot_a, std::uint8_t slot_b, bool has_steps, matrix_core::MatrixView m) noexcept;
 		static Page make_result_scalar(
 		        OperationId op, std::uint8_t slot_a, std::uint8_t slot_b, bool has_steps, std::int64_t num, std::int64_t den) noexcept;
 		static Page make_projection_result(std::uint8_t slot_u,
@@ -218,18 +245,40 @@ struct Page {
 		        std::uint8_t slot_a, std::uint8_t i, std::uint8_t j, bool has_steps, std::int64_t num, std::int64_t den) noexcept;
 		static Page make_steps() noexcept;
 		static Page make_confirm(std::uint8_t slot, ConfirmAction action) noexcept;
+		static Page make_busy(OperationId op, std::uint8_t slot) noexcept;
+};
+
+// one formatted step of the Steps page; the layout may point into doc
+struct StepTex {
+		static constexpr std::uint16_t kEmpty = 0xFFFF;
+
+		std::uint16_t index = kEmpty;
+		matrix_core::ErrorCode ec = matrix_core::ErrorCode::Internal; // of render_step
+		TeX_Layout* layout = nullptr; // nullptr with ec Ok: tex_format failed
+		int height = 0;
+		// caption and LaTeX as rendered by Explanation::render_document
+		char doc[kStepCaptionBytes + 1 + kStepLatexBytes]{};
+		char* text = nullptr;
 };
 
 struct Slot {
 		matrix_core::MatrixMutView backing{}; // always 6x6 when allocated
 		std::uint8_t rows = 0;                // active
 		std::uint8_t cols = 0;                // active
+		std::uint64_t hash = 0;               // content_hash of the active view, kept current by every edit
 
 		bool allocated() const noexcept { return backing.data != nullptr; }
 		bool is_set() const noexcept { return allocated() && rows >= 1 && cols >= 1; }
 
 		matrix_core::MatrixView view_active() const noexcept { return {rows, cols, backing.stride, backing.data}; }
 		matrix_core::MatrixMutView view_active_mut() noexcept { return {rows, cols, backing.stride, backing.data}; }
+
+		void rehash() noexcept { hash = matrix_core::content_hash(view_active()); }
+		void set_entry(std::uint8_t r, std::uint8_t c, const matrix_core::Rational& v) noexcept {
+				matrix_core::Rational& e = backing.at_mut(r, c);
+				hash = matrix_core::content_hash_update(hash, r, c, e, v);
+				e = v;
+		}
 };
 
 class App {
@@ -241,8 +290,28 @@ class App {
 		matrix_core::Slab slab_{};
 		matrix_core::Arena persist_{};
 		matrix_core::Arena scratch_{};
+		std::size_t persist_cache_mark_ = 0; // result cache blocks sit between here and persist_base_mark_
 		std::size_t persist_base_mark_ = 0;
 		std::size_t persist_tail_mark_ = 0;
+		matrix_core::LuCache lu_cache_{}; // factors of recent det/inverse inputs, below persist_base_mark_
+		matrix_core::SpacesCache spaces_cache_{}; // [A | I] reduction behind the subspace ops, below persist_base_mark_
+		matrix_core::ResultCache result_cache_{}; // recent Det/Inverse/Ref/Rref pages and their explanations
+		matrix_core::EditTracker edit_tracker_{}; // live det/rank of the slot in the editor, below persist_base_mark_
+		std::uint8_t edit_tracker_slot_ = kSlotCount;
+		std::uint64_t edit_tracker_hash_ = 0;
+
+		// idle time speculation on the slot last edited
+		std::uint16_t idle_frames_ = 0;
+		std::uint8_t spec_slot_ = kSlotCount;
+		std::uint8_t spec_stage_ = 0;
+		std::uint64_t spec_hash_ = 0;
+
+		// the reduction behind the Busy page, writing into busy_arena_ (busy_fill_'s
+		// arena, or persist_ above persist_base_mark_ when it is null)
+		matrix_core::EchelonTask busy_task_{};
+		matrix_core::ResultCache::Entry* busy_fill_ = nullptr;
+		matrix_core::Arena* busy_arena_ = nullptr;
+		matrix_core::ExplainDetail busy_detail_ = matrix_core::ExplainDetail::Full;
 
 		Slot slots_[kSlotCount]{};
 		Page stack_[kMaxPageDepth]{};
@@ -251,17 +320,16 @@ class App {
 		Input input_{};
 		MessageState msg_{};
 		char fmt_buf_[64]{};
-		char step_caption_[128]{};
-		char step_latex_[1024]{};
 		matrix_core::Explanation expl_{};
+		matrix_core::StepCache step_cache_{}; // steps of expl_ seen on this Steps page, in the slab past scratch_
+		matrix_core::latex::RowFragments step_rows_{}; // rows of the step last rendered, in the slab past step_cache_
 
 		TeX_Renderer* tex_renderer_ = nullptr;
-		TeX_Layout* tex_layout_ = nullptr;
-		std::uint16_t tex_cached_step_index_ = 0xFFFF;
-		matrix_core::ErrorCode tex_cached_step_ec_ = matrix_core::ErrorCode::Internal;
+		// the step on screen and its neighbors, formatted ahead on idle frames
+		static constexpr std::uint8_t kStepTexSlots = 3;
+		StepTex step_tex_[kStepTexSlots]{};
+		const StepTex* step_tex_shown_ = nullptr; // what tex_renderer_ last drew
 		int tex_scroll_y_ = 0;
-		int tex_total_height_ = 0;
-		char tex_doc_[1400]{};
 
 		Page& top() noexcept;
 		const Page& top() const noexcept;
@@ -285,6 +353,7 @@ class App {
 		void render_steps(const StepsState& s) noexcept;
 		void render_cofactor_element(const CofactorElementState& s) noexcept;
 		void render_confirm(const ConfirmState& s) noexcept;
+		void render_busy(const BusyState& s) noexcept;
 
 		void update_message() noexcept;
 		void show_message(const char* msg) noexcept;
@@ -299,14 +368,34 @@ class App {
 		void update_cramer_steps_menu(CramerStepsMenuState& s) noexcept;
 		void update_steps(StepsState& s) noexcept;
 		void update_confirm(ConfirmState& s) noexcept;
+		void update_busy(BusyState& s) noexcept;
 
 		matrix_core::ErrorCode ensure_slot_allocated(std::uint8_t slot) noexcept;
 		void clear_slot(std::uint8_t slot) noexcept;
+		void track_slot(std::uint8_t slot) noexcept;
+		void edit_slot_entry(std::uint8_t slot, std::uint8_t r, std::uint8_t c, const matrix_core::Rational& v) noexcept;
+
+		void grow_result_cache() noexcept;
+		matrix_core::ExplainDetail explain_detail(matrix_core::MatrixView a) const noexcept;
+		matrix_core::ResultKey result_key(OperationId op, std::uint8_t slot) const noexcept;
+		matrix_core::Error compute_slot_result(
+		        OperationId op, std::uint8_t slot, matrix_core::Arena& arena, Page* page, matrix_core::Explanation* expl) noexcept;
+		bool store_result(matrix_core::ResultCache::Entry* fill, matrix_core::Explanation& expl, const Page& p) noexcept;
+		void keep_result(matrix_core::ResultCache::Entry* fill, matrix_core::Explanation&& expl, const Page& p) noexcept;
+		bool push_result(Page p) noexcept;
+		bool build_steps() noexcept;
+		bool start_busy(OperationId op, std::uint8_t slot, matrix_core::ResultCache::Entry* fill) noexcept;
+		void run_busy() noexcept;
+		void speculate() noexcept;
+		void speculate_result(OperationId op, std::uint8_t slot) noexcept;
 
 		static bool parse_i64(const char* s, std::int64_t* out) noexcept;
 
 		void steps_tex_reset() noexcept;
 		void steps_tex_release() noexcept;
+		StepTex* step_tex_find(std::size_t idx) noexcept;
+		StepTex* step_tex_format(std::size_t idx, std::size_t center) noexcept;
+		void prefetch_steps(const StepsState& s) noexcept;
 };
 
 } // namespace matrix_shell
@@ -17,6 +17,7 @@ class Input {
 		bool down(std::uint8_t group, std::uint8_t mask) const noexcept;
 		bool pressed(std::uint8_t group, std::uint8_t mask) const noexcept;
 		bool released(std::uint8_t group, std::uint8_t mask) const noexcept;
+		bool any_down() const noexcept;
 
 		bool repeat(std::uint8_t group, std::uint8_t mask, RepeatConfig cfg = {}) noexcept;
 
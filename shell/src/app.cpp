@@ -17,6 +17,7 @@
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 #include <utility>
 
 namespace matrix_shell {
@@ -37,11 +38,40 @@ using detail::kScreenW;
 using detail::op_is_binary;
 using detail::op_name;
 
-constexpr std::size_t kSlabBytes = 18u * 1024u;
-constexpr std::size_t kPersistBytes = 9u * 1024u;
+constexpr std::size_t kSlabBytes = 25u * 1024u;
+constexpr std::size_t kPersistBytes = 11u * 1024u;
 constexpr std::size_t kScratchBytes = 9u * 1024u;
-
-static_assert(kPersistBytes + kScratchBytes == kSlabBytes);
+// rendered steps kept for paging back, each a caption of kStepCaptionBytes
+// and a LaTeX buffer that fits a typical step; longer steps are not kept
+constexpr std::size_t kStepCacheBytes = 4u * 1024u;
+constexpr std::uint8_t kStepCacheEntries = 3;
+constexpr std::size_t kStepCacheLatexBytes = 1024u;
+// the rows of the step last rendered, kMaxRows fragments that fit a typical
+// row of fractions; longer rows are written in full
+constexpr std::size_t kStepRowsBytes = 1024u;
+
+static_assert(kPersistBytes + kScratchBytes + kStepCacheBytes + kStepRowsBytes == kSlabBytes);
+
+// each entry pins a 6x6 factor and the 6x6 input it came from in persist
+// (below the slots)
+constexpr std::uint8_t kLuCacheEntries = 2;
+
+// one reduction (and the input it came from) covers all four subspaces of
+// the last slot asked about
+constexpr std::uint8_t kSpacesCacheEntries = 1;
+
+// result cache blocks are carved from persist above the slots while there is
+// room; a block holds the largest cached result (a 6x6 inverse) with its page
+// and explanation context plus the copy of the input a hit is checked
+// against, and the reserve keeps room for uncached results (Lu packs
+// [L | U | P])
+constexpr std::uint8_t kResultCacheEntries = 3;
+constexpr std::size_t kResultCacheBlockBytes = 768u + sizeof(matrix_core::Rational) * matrix_core::kMaxEntries;
+constexpr std::size_t kResultCacheReserveBytes = 2560u;
+static_assert(kResultCacheEntries <= matrix_core::ResultCache::kMaxEntries);
+
+// keyless frames before speculation starts, so it never delays typing
+constexpr std::uint16_t kSpeculateIdleFrames = 10;
 
 constexpr std::size_t kTeXRendererBytes = 20u * 1024u;
 
@@ -70,14 +100,28 @@ bool App::init() noexcept {
 
 		persist_.reset(slab_.data(), kPersistBytes);
 		scratch_.reset(slab_.data() + kPersistBytes, kScratchBytes);
-		persist_base_mark_ = persist_.mark();
+		matrix_core::Arena step_cache_arena(slab_.data() + kPersistBytes + kScratchBytes, kStepCacheBytes);
+		if (!matrix_core::is_ok(step_cache_.init(step_cache_arena, kStepCacheEntries, kStepCaptionBytes, kStepCacheLatexBytes)))
+				return false;
+		matrix_core::Arena step_rows_arena(slab_.data() + kPersistBytes + kScratchBytes + kStepCacheBytes, kStepRowsBytes);
+		if (!matrix_core::is_ok(step_rows_.init(step_rows_arena, kStepRowsBytes / matrix_core::kMaxRows)))
+				return false;
+		if (!matrix_core::is_ok(lu_cache_.init(persist_, kLuCacheEntries)))
+				return false;
+		if (!matrix_core::is_ok(spaces_cache_.init(persist_, kSpacesCacheEntries)))
+				return false;
+		if (!matrix_core::is_ok(edit_tracker_.init(persist_)))
+				return false;
+		persist_cache_mark_ = persist_.mark();
+		persist_base_mark_ = persist_cache_mark_;
 		persist_tail_mark_ = persist_base_mark_;
 
 		depth_ = 0;
 		push_root();
 		msg_ = {};
 
-		SHELL_DBG("[init] slab=%uB persist=%uB scratch=%uB\n", (unsigned)kSlabBytes, (unsigned)kPersistBytes, (unsigned)kScratchBytes);
+		SHELL_DBG("[init] slab=%uB persist=%uB scratch=%uB step_cache=%uB step_rows=%uB\n", (unsigned)kSlabBytes,
+		          (unsigned)kPersistBytes, (unsigned)kScratchBytes, (unsigned)kStepCacheBytes, (unsigned)kStepRowsBytes);
 		SHELL_DBG("[init] persist base=%p cap=%u\n", (void*)slab_.data(), (unsigned)persist_.capacity());
 		SHELL_DBG("[init] scratch base=%p cap=%u\n", (void*)(slab_.data() + kPersistBytes), (unsigned)scratch_.capacity());
 		SHELL_DBG("[init] persist_base_mark=%u\n", (unsigned)persist_base_mark_);
@@ -131,8 +175,11 @@ bool App::push(const Page& p) noexcept {
 				return false;
 		stack_[depth_++] = p;
 		SHELL_DBG("[nav] push kind=%u depth=%u\n", (unsigned)p.kind, (unsigned)depth_);
-		if (p.kind == PageKind::Steps)
-				steps_tex_reset();
+		if (p.kind == PageKind::Steps) {
+				steps_tex_release();
+				step_cache_.clear();
+				step_rows_.clear();
+		}
 		return true;
 }
 
@@ -168,9 +215,12 @@ matrix_core::ErrorCode App::ensure_slot_allocated(std::uint8_t slot) noexcept {
 		if (slots_[slot].allocated())
 				return matrix_core::ErrorCode::Ok;
 
+		// slots live below the result cache, so a new one gives its blocks back
+		expl_ = {};
+		result_cache_.release();
+		persist_base_mark_ = persist_cache_mark_;
 		persist_.rewind(persist_base_mark_);
 		persist_tail_mark_ = persist_base_mark_;
-		expl_ = {};
 		matrix_core::ArenaScope tx(persist_);
 
 		matrix_core::MatrixMutView backing;
@@ -187,8 +237,10 @@ matrix_core::ErrorCode App::ensure_slot_allocated(std::uint8_t slot) noexcept {
 		slots_[slot].backing = backing;
 		slots_[slot].rows = 2;
 		slots_[slot].cols = 2;
+		slots_[slot].rehash();
 
-		persist_base_mark_ = persist_.mark();
+		persist_cache_mark_ = persist_.mark();
+		persist_base_mark_ = persist_cache_mark_;
 		persist_tail_mark_ = persist_base_mark_;
 		tx.commit();
 		SHELL_DBG("[slot] alloc %c backing=%p base_mark=%u used=%u/%u\n",
@@ -209,9 +261,138 @@ void App::clear_slot(std::uint8_t slot) noexcept {
 		matrix_core::matrix_fill_zero(slots_[slot].backing);
 		slots_[slot].rows = 0;
 		slots_[slot].cols = 0;
+		slots_[slot].rehash();
 		SHELL_DBG("[slot] cleared %c\n", (char)('A' + slot));
 }
 
+void App::grow_result_cache() noexcept {
+		if (result_cache_.block_count() >= kResultCacheEntries)
+				return;
+		if (persist_.capacity() - persist_.used() < kResultCacheBlockBytes + kResultCacheReserveBytes)
+				return;
+
+		void* mem = persist_.allocate(kResultCacheBlockBytes, alignof(std::max_align_t));
+		if (!mem || !matrix_core::is_ok(result_cache_.add_block(mem, kResultCacheBlockBytes))) {
+				persist_.rewind(persist_base_mark_);
+				return;
+		}
+		persist_base_mark_ = persist_.mark();
+		persist_tail_mark_ = persist_base_mark_;
+		SHELL_DBG("[cache] result block %u base_mark=%u used=%u/%u\n",
+		        (unsigned)result_cache_.block_count(),
+		        (unsigned)persist_base_mark_,
+		        (unsigned)persist_.used(),
+		        (unsigned)persist_.capacity());
+}
+
+// moves a fresh result's explanation and page into the entry it was computed
+// into; false, leaving expl alone, when there is no entry or no room
+bool App::store_result(matrix_core::ResultCache::Entry* fill, matrix_core::Explanation& expl, const Page& p) noexcept {
+		if (!fill)
+				return false;
+		void* mem = fill->arena.allocate(sizeof(Page), alignof(Page));
+		if (!mem)
+				return false;
+		result_cache_.commit(fill, std::move(expl), new (mem) Page(p));
+		return true;
+}
+
+void App::keep_result(matrix_core::ResultCache::Entry* fill, matrix_core::Explanation&& expl, const Page& p) noexcept {
+		if (store_result(fill, expl, p))
+				expl_ = fill->expl.borrow();
+		else
+				expl_ = std::move(expl);
+}
+
+// pushes a result page for expl_; steps are only offered when expl_ is
+// there and a lazy one's build fits in persist_
+bool App::push_result(Page p) noexcept {
+		p.u.result.has_steps = expl_.available() && persist_.capacity() - persist_.used() >= expl_.build_bytes();
+		return push(p);
+}
+
+// turns a lazy expl_ into the explanation to step through, its context
+// above the result in persist_ (dropped with it); false when it cannot be built
+bool App::build_steps() noexcept {
+		if (!expl_.lazy())
+				return true;
+		matrix_core::Explanation built;
+		const matrix_core::ErrorCode ec = expl_.build(persist_, scratch_, &built);
+		SHELL_DBG("[steps] build ec=%u used=%u/%u\n", (unsigned)ec, (unsigned)persist_.used(), (unsigned)persist_.capacity());
+		if (!matrix_core::is_ok(ec))
+				return false;
+		expl_ = std::move(built);
+		return true;
+}
+
+void App::speculate_result(OperationId op, std::uint8_t slot) noexcept {
+		const matrix_core::ResultKey key = result_key(op, slot);
+		const matrix_core::MatrixView a = slots_[slot].view_active();
+		if (result_cache_.find(key, a))
+				return;
+		grow_result_cache();
+		matrix_core::ResultCache::Entry* fill = result_cache_.begin(key, a);
+		if (!fill)
+				return; // never spills into persist_
+
+		Page p{};
+		matrix_core::Explanation expl;
+		const matrix_core::Error err = compute_slot_result(op, slot, fill->arena, &p, &expl);
+		const bool stored = matrix_core::is_ok(err) && store_result(fill, expl, p);
+		SHELL_DBG("[spec] %s slot=%c err=%u stored=%u\n", op_name(op), (char)('A' + slot), (unsigned)err.code, (unsigned)stored);
+		(void)stored;
+}
+
+// on idle frames, computes what is likely asked next about the slot last
+// edited, one op per frame: Det (which also factors it into lu_cache_), Rref,
+// then the [A | I] reduction behind rank and the subspaces. on the Steps page
+// it formats the neighbors of the step on screen instead
+void App::speculate() noexcept {
+		// a step is formatted in one frame, so any frame without a key down will do
+		if (top().kind == PageKind::Steps) {
+				if (idle_frames_ > 0)
+						prefetch_steps(top().u.steps);
+				return;
+		}
+		if (idle_frames_ < kSpeculateIdleFrames)
+				return;
+		// only pages with nothing live above persist_base_mark_
+		const PageKind kind = top().kind;
+		if (kind != PageKind::Menu && kind != PageKind::Editor && kind != PageKind::SlotPick)
+				return;
+
+		const std::uint8_t slot = edit_tracker_slot_;
+		if (slot >= kSlotCount || !slots_[slot].is_set())
+				return;
+		if (spec_slot_ != slot || spec_hash_ != slots_[slot].hash) {
+				spec_slot_ = slot;
+				spec_hash_ = slots_[slot].hash;
+				spec_stage_ = 0;
+		}
+
+		const matrix_core::MatrixView a = slots_[slot].view_active();
+		switch (spec_stage_) {
+		case 0:
+				if (a.rows == a.cols)
+						speculate_result(OperationId::Det, slot);
+				break;
+		case 1:
+				speculate_result(OperationId::Rref, slot);
+				break;
+		case 2: {
+				matrix_core::ArenaScratchScope scratch_tx(scratch_);
+				const matrix_core::FundamentalSpaces* spaces = nullptr;
+				const matrix_core::ErrorCode ec = spaces_cache_.get(a, scratch_, &spaces);
+				SHELL_DBG("[spec] spaces slot=%c ec=%u\n", (char)('A' + slot), (unsigned)ec);
+				(void)ec;
+				break;
+		}
+		default:
+				return;
+		}
+		spec_stage_++;
+}
+
 bool App::parse_i64(const char* s, std::int64_t* out) noexcept {
 		if (!out || !s || s[0] == '\0')
 				return false;
@@ -231,6 +412,10 @@ bool App::parse_i64(const char* s, std::int64_t* out) noexcept {
 bool App::step() noexcept {
 		input_.begin_frame();
 		update_message();
+		if (input_.any_down())
+				idle_frames_ = 0;
+		else if (idle_frames_ < kSpeculateIdleFrames)
+				idle_frames_++;
 
 		// global back/exit handling
 		const bool clear_pressed = input_.pressed(kKbGroup6, kb_Clear);
@@ -282,12 +467,16 @@ bool App::step() noexcept {
 		case PageKind::Confirm:
 				update_confirm(p.u.confirm);
 				break;
+		case PageKind::Busy:
+				update_busy(p.u.busy);
+				break;
 		default:
 				fail_fast("Unhandled PageKind in step()");
 		}
 
 		render();
 		gfx_SwapDraw();
+		speculate();
 		return true;
 }
 
@@ -369,6 +558,9 @@ void App::render() noexcept {
 		case PageKind::Confirm:
 				render_confirm(p.u.confirm);
 				break;
+		case PageKind::Busy:
+				render_busy(p.u.busy);
+				break;
 		default:
 				fail_fast("Unhandled PageKind in render()");
 		}
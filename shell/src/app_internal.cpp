@@ -105,8 +105,9 @@ constexpr OpMeta kOpMeta[] = {
 #endif
         /* Ref */ {"op.ref"_tid, false, true},
         /* Rref */ {"op.rref"_tid, false, true},
+        /* Lu */ {"op.lu"_tid, false, true},
 };
-static_assert(sizeof(kOpMeta) / sizeof(kOpMeta[0]) == static_cast<std::size_t>(OperationId::Rref) + 1u, "Update kOpMeta");
+static_assert(sizeof(kOpMeta) / sizeof(kOpMeta[0]) == static_cast<std::size_t>(OperationId::Lu) + 1u, "Update kOpMeta");
 
 const OpMeta& op_meta(OperationId op) noexcept {
 		const std::size_t idx = static_cast<std::size_t>(op);
@@ -31,6 +31,14 @@ bool Input::released(std::uint8_t group, std::uint8_t mask) const noexcept {
 		return (cur_[group] & mask) == 0 && (prev_[group] & mask) != 0;
 }
 
+bool Input::any_down() const noexcept {
+		for (std::uint8_t i = 0; i < 8; i++) {
+				if (cur_[i] != 0)
+						return true;
+		}
+		return false;
+}
+
 Input::RepeatState& Input::rep_state_for(std::uint8_t group, std::uint8_t mask) noexcept {
 		// Only arrows repeat.
 		if (group == 7 && mask == kb_Up)
@@ -37,6 +37,13 @@ Page Page::make_confirm(std::uint8_t slot, ConfirmAction action) noexcept {
 		return p;
 }
 
+Page Page::make_busy(OperationId op, std::uint8_t slot) noexcept {
+		Page p{};
+		p.kind = PageKind::Busy;
+		p.u.busy = BusyState{op, slot};
+		return p;
+}
+
 Page Page::make_slot_pick(OperationId op) noexcept {
 		Page p{};
 		p.kind = PageKind::SlotPick;
@@ -63,6 +70,7 @@ Page Page::make_result_matrix(OperationId op,
 		r.rows = rows;
 		r.cols = cols;
 		r.stride = stride;
+		r.col_stride = 1;
 		r.data = data;
 		r.i = 0;
 		r.j = 0;
@@ -72,6 +80,13 @@ Page Page::make_result_matrix(OperationId op,
 		return p;
 }
 
+Page Page::make_result_view(
+        OperationId op, std::uint8_t slot_a, std::uint8_t slot_b, bool has_steps, matrix_core::MatrixView m) noexcept {
+		Page p = make_result_matrix(op, slot_a, slot_b, has_steps, m.rows, m.cols, m.stride, m.data);
+		p.u.result.col_stride = m.col_stride;
+		return p;
+}
+
 Page Page::make_result_scalar(
         OperationId op, std::uint8_t slot_a, std::uint8_t slot_b, bool has_steps, std::int64_t num, std::int64_t den) noexcept {
 		Page p{};
@@ -85,6 +100,7 @@ Page Page::make_result_scalar(
 		r.rows = 0;
 		r.cols = 0;
 		r.stride = 0;
+		r.col_stride = 1;
 		r.data = nullptr;
 		r.i = 0;
 		r.j = 0;
@@ -158,6 +174,7 @@ Page Page::make_result_cofactor_element(
 		r.rows = 0;
 		r.cols = 0;
 		r.stride = 0;
+		r.col_stride = 1;
 		r.data = nullptr;
 		r.i = i;
 		r.j = j;
@@ -0,0 +1,129 @@
+#include "matrix_shell/app.hpp"
+
+#include "matrix_shell/text.hpp"
+#include "matrix_shell/ui.hpp"
+
+#include "matrix_shell/detail/app_internal.hpp"
+
+#include "matrix_core/ops.hpp"
+
+#include <graphx.h>
+#include <keypadc.h>
+
+#include <utility>
+
+namespace matrix_shell {
+namespace {
+using detail::fail_fast;
+using detail::kKbGroup6;
+using detail::kScreenW;
+using detail::op_name;
+using namespace matrix_shell::text_literals;
+
+// row operations per frame; one 6x6 row op is a dozen rational updates
+constexpr std::size_t kBusyOpsPerFrame = 4;
+} // namespace
+
+void App::render_busy(const BusyState& s) noexcept {
+		const ui::Layout l = ui::Layout{};
+
+		render_header(nullptr);
+		gfx_PrintString(op_name(s.op));
+		gfx_PrintString(": ");
+		gfx_PrintChar(static_cast<char>('A' + s.slot));
+		render_footer_hint("footer.cancel"_tx);
+
+		gfx_SetTextFGColor(ui::color::kBlack);
+		gfx_SetTextXY(l.margin_x, 60);
+		gfx_PrintString("busy.working"_tx);
+
+		const int bar_w = kScreenW - 2 * l.margin_x;
+		const int bar_h = 12;
+		const int y = 80;
+		gfx_SetColor(ui::color::kDarkGray);
+		gfx_Rectangle(l.margin_x, y, bar_w, bar_h);
+		const int fill_w = ((bar_w - 4) * matrix_core::op_echelon_progress(busy_task_)) / 100;
+		if (fill_w > 0) {
+				gfx_SetColor(ui::color::kBlue);
+				gfx_FillRectangle(l.margin_x + 2, y + 2, fill_w, bar_h - 4);
+		}
+}
+
+void App::update_busy(BusyState& s) noexcept {
+		// CLEAR: cancel, dropping the partial result
+		if (input_.pressed(kKbGroup6, kb_Clear)) {
+				SHELL_DBG("[busy] CLEAR cancel op=%s slot=%c ops=%u\n", op_name(s.op), (char)('A' + s.slot),
+				          (unsigned)busy_task_.obs.count);
+				if (!busy_fill_)
+						persist_.rewind(persist_base_mark_);
+				busy_task_ = {};
+				busy_fill_ = nullptr;
+				busy_arena_ = nullptr;
+				REQUIRE(pop(), "pop failed (busy cancel)");
+				show_message("msg.cancelled"_tx);
+				return;
+		}
+
+		run_busy();
+}
+
+// sets up busy_task_ for a Ref/Rref of slot, its result going to fill's arena
+// (or persist_ without one); false when that arena cannot hold the result
+bool App::start_busy(OperationId op, std::uint8_t slot, matrix_core::ResultCache::Entry* fill) noexcept {
+		const matrix_core::MatrixView a = slots_[slot].view_active();
+		matrix_core::Arena& arena = fill ? fill->arena : persist_;
+		// before out takes its share of persist_
+		busy_detail_ = explain_detail(a);
+
+		matrix_core::MatrixMutView out{};
+		if (!matrix_core::is_ok(matrix_core::matrix_alloc(arena, a.rows, a.cols, &out)))
+				return false;
+
+		const matrix_core::EchelonKind kind = (op == OperationId::Ref) ? matrix_core::EchelonKind::Ref : matrix_core::EchelonKind::Rref;
+		const matrix_core::AugmentedView in{a, matrix_core::MatrixView{}};
+		const matrix_core::Error err = matrix_core::op_echelon_begin(in, kind, out, &busy_task_);
+		if (!matrix_core::is_ok(err))
+				fail_fast("start_busy: op_echelon_begin returned unexpected error");
+
+		busy_fill_ = fill;
+		busy_arena_ = &arena;
+		return true;
+}
+
+// one slice of busy_task_ for the Busy page on top; the last one replaces it
+// with the result page
+void App::run_busy() noexcept {
+		if (!busy_arena_)
+				fail_fast("run_busy: no task");
+
+		matrix_core::ExplainOptions opts_steps;
+		opts_steps.enable = true;
+		opts_steps.persist = busy_arena_;
+		opts_steps.detail = busy_detail_;
+
+		matrix_core::Explanation expl;
+		const matrix_core::Error err = matrix_core::op_echelon_run(&busy_task_, kBusyOpsPerFrame, &expl, opts_steps);
+		if (err.code == matrix_core::ErrorCode::Pending)
+				return;
+
+		const BusyState s = top().u.busy;
+		SHELL_DBG("[op] %s err=%u ops=%u\n", op_name(s.op), (unsigned)err.code, (unsigned)busy_task_.obs.count);
+		matrix_core::ResultCache::Entry* fill = busy_fill_;
+		busy_fill_ = nullptr;
+		busy_arena_ = nullptr;
+		REQUIRE(pop(), "pop failed (busy)");
+
+		if (!matrix_core::is_ok(err)) {
+				if (err.code == matrix_core::ErrorCode::DimensionMismatch || err.code == matrix_core::ErrorCode::Internal)
+						fail_fast("run_busy: echelon returned unexpected error");
+				show_message("common.error"_tx);
+				return;
+		}
+
+		const matrix_core::MatrixMutView out = busy_task_.out;
+		const Page p = Page::make_result_matrix(s.op, s.slot, 0, expl.available(), out.rows, out.cols, out.stride, out.data);
+		keep_result(fill, std::move(expl), p);
+		REQUIRE(push_result(p), "push result failed (busy)");
+}
+
+} // namespace matrix_shell
@@ -131,6 +131,7 @@ void App::update_cofactor_element(CofactorElementState& s) noexcept {
 		matrix_core::ExplainOptions opts_steps;
 		opts_steps.enable = true;
 		opts_steps.persist = &persist_;
+		opts_steps.detail = explain_detail(a);
 
 		matrix_core::Explanation expl;
 		matrix_core::Rational cofactor = matrix_core::Rational::from_int(0);
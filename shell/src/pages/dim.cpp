@@ -83,6 +83,7 @@ void App::update_dim(DimState& s) noexcept {
 		matrix_core::matrix_fill_zero(slots_[s.slot].backing);
 		slots_[s.slot].rows = s.rows;
 		slots_[s.slot].cols = s.cols;
+		slots_[s.slot].rehash();
 		SHELL_DBG("[dim] resized %c active=%ux%u backing=%p base_mark=%u used=%u/%u\n",
 		        (char)('A' + s.slot),
 		        (unsigned)s.rows,
@@ -39,6 +39,22 @@ void App::render_editor(const EditorState& s) noexcept {
 		gfx_PrintChar(static_cast<char>('0' + slot.rows));
 		gfx_PrintChar('x');
 		gfx_PrintChar(static_cast<char>('0' + slot.cols));
+		if (edit_tracker_slot_ == s.slot && edit_tracker_.known()) {
+				fmt_buf_[0] = '\0';
+				matrix_core::CheckedWriter w{fmt_buf_, sizeof(fmt_buf_)};
+				if (edit_tracker_.square()) {
+						const matrix_core::Rational& det = edit_tracker_.det();
+						w.append("editor.det_prefix"_tx);
+						w.append_i64(det.num());
+						if (det.den() != 1) {
+								w.put('/');
+								w.append_i64(det.den());
+						}
+				}
+				w.append("editor.rank_prefix"_tx);
+				w.append_u64(edit_tracker_.rank());
+				gfx_PrintString(fmt_buf_);
+		}
 
 		if (s.editing)
 				render_footer_hint("footer.editor_input"_tx);
@@ -100,6 +116,35 @@ void App::render_editor(const EditorState& s) noexcept {
 		}
 }
 
+// points edit_tracker_ at slot; a different slot, or one changed outside the
+// editor (resize, clear), is refactored once
+void App::track_slot(std::uint8_t slot) noexcept {
+		const Slot& sl = slots_[slot];
+		if (edit_tracker_slot_ == slot && edit_tracker_hash_ == sl.hash)
+				return;
+
+		matrix_core::ArenaScratchScope scratch_tx(scratch_);
+		const matrix_core::ErrorCode ec = edit_tracker_.reset(sl.view_active(), scratch_);
+		SHELL_DBG("[edit] track slot=%c ec=%u rank=%u\n", (char)('A' + slot), (unsigned)ec, (unsigned)edit_tracker_.rank());
+		(void)ec; // an overflow only hides the live det/rank
+		edit_tracker_slot_ = slot;
+		edit_tracker_hash_ = sl.hash;
+}
+
+// writes one entry and brings the live det/rank along in O(n^2)
+void App::edit_slot_entry(std::uint8_t slot, std::uint8_t r, std::uint8_t c, const matrix_core::Rational& v) noexcept {
+		track_slot(slot);
+		Slot& sl = slots_[slot];
+		const matrix_core::Rational old = sl.view_active().at(r, c);
+		sl.set_entry(r, c, v);
+
+		matrix_core::ArenaScratchScope scratch_tx(scratch_);
+		const matrix_core::ErrorCode ec = edit_tracker_.update(sl.view_active(), r, c, old, scratch_);
+		SHELL_DBG("[edit] tracker ec=%u refactors=%u\n", (unsigned)ec, (unsigned)edit_tracker_.refactors());
+		(void)ec;
+		edit_tracker_hash_ = sl.hash;
+}
+
 void App::update_editor(EditorState& s) noexcept {
 		if (s.slot >= kSlotCount) {
 				REQUIRE(pop(), "pop failed (invalid slot)");
@@ -111,6 +156,7 @@ void App::update_editor(EditorState& s) noexcept {
 				REQUIRE(pop(), "pop failed (unset slot)");
 				return;
 		}
+		track_slot(s.slot);
 
 		if (s.editing) {
 				assert(s.edit_len < sizeof(s.edit_buf));
@@ -203,7 +249,7 @@ void App::update_editor(EditorState& s) noexcept {
 						return;
 				}
 
-				slot.view_active_mut().at_mut(s.cur_r, s.cur_c) = matrix_core::Rational::from_int(v);
+				edit_slot_entry(s.slot, s.cur_r, s.cur_c, matrix_core::Rational::from_int(v));
 					SHELL_DBG("[edit] commit slot=%c cell=(%u,%u) v=", (char)('A' + s.slot), (unsigned)s.cur_r, (unsigned)s.cur_c);
 					detail::dbg_print_i64(v);
 					SHELL_DBG("\n");
@@ -240,7 +286,7 @@ void App::update_editor(EditorState& s) noexcept {
 
 		// quick clear cell to 0
 		if (input_.pressed(kKbGroup1, kb_Del)) {
-				slot.view_active_mut().at_mut(s.cur_r, s.cur_c) = matrix_core::Rational::from_int(0);
+				edit_slot_entry(s.slot, s.cur_r, s.cur_c, matrix_core::Rational::from_int(0));
 				SHELL_DBG("[edit] DEL zero slot=%c cell=(%u,%u)\n", (char)('A' + s.slot), (unsigned)s.cur_r, (unsigned)s.cur_c);
 				return;
 		}
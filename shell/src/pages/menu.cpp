@@ -65,6 +65,7 @@ constexpr MenuEntry kOperationsMenuEntries[] = {
         {"menu.entry.span_indep"_tid, MenuEntryKind::Submenu, MenuId::Span, OperationId::Add},
         {TextId::None, MenuEntryKind::Operation, MenuId::Main, OperationId::Transpose},
         {TextId::None, MenuEntryKind::Operation, MenuId::Main, OperationId::Inverse},
+        {TextId::None, MenuEntryKind::Operation, MenuId::Main, OperationId::Lu},
         {"menu.entry.spaces"_tid, MenuEntryKind::Submenu, MenuId::Spaces, OperationId::Add},
         {TextId::None, MenuEntryKind::Operation, MenuId::Main, OperationId::Projection},
 };
@@ -49,7 +49,9 @@ void App::render_result(const ResultState& s) noexcept {
 		render_header(nullptr);
 		gfx_PrintString(op_name(s.op));
 		gfx_PrintString("result.suffix"_tx);
-		if (s.has_steps)
+		if (s.op == OperationId::Lu)
+				render_footer_hint(s.has_steps ? "footer.projection_steps_back"_tx : "footer.projection_back"_tx);
+		else if (s.has_steps)
 				render_footer_hint("footer.result_steps_back"_tx);
 		else
 				render_footer_hint("footer.clear_back"_tx);
@@ -163,11 +165,16 @@ void App::render_result(const ResultState& s) noexcept {
 				return;
 		}
 
-		if (!s.data || s.rows < 1 || s.cols < 1 || s.stride < s.cols)
+		const bool row_major = (s.col_stride == 1);
+		if (!s.data || s.rows < 1 || s.cols < 1 || (row_major ? s.stride < s.cols : s.col_stride < s.rows))
 				fail_fast("render_result: invalid matrix result state");
 
 		int grid_top = l.header_h + 8;
-		if (s.op == OperationId::SolveRref || s.op == OperationId::ColSpaceBasis || s.op == OperationId::RowSpaceBasis ||
+		if (s.op == OperationId::SolveRref && s.den > 1) {
+				gfx_SetTextXY(l.margin_x, l.header_h + 4);
+				gfx_PrintString("result.solution_cols"_tx);
+				grid_top = l.header_h + 18;
+		} else if (s.op == OperationId::SolveRref || s.op == OperationId::ColSpaceBasis || s.op == OperationId::RowSpaceBasis ||
 		        s.op == OperationId::NullSpaceBasis || s.op == OperationId::LeftNullSpaceBasis) {
 				gfx_SetTextXY(l.margin_x, l.header_h + 4);
 				gfx_PrintString("result.rank_eq"_tx);
@@ -201,6 +208,16 @@ void App::render_result(const ResultState& s) noexcept {
 				grid_top = l.header_h + 30;
 		}
 
+		const matrix_core::Rational* data = s.data;
+		if (s.op == OperationId::Lu) {
+				static constexpr char kFactorName[] = {'L', 'U', 'P'};
+				gfx_SetTextXY(l.margin_x, l.header_h + 4);
+				gfx_PrintString("result.lu_label"_tx);
+				gfx_PrintChar(kFactorName[s.i]);
+				data += static_cast<std::size_t>(s.i) * s.cols * s.col_stride;
+				grid_top = l.header_h + 18;
+		}
+
 		const int grid_left = l.margin_x;
 		const int max_cols = 6;
 		const int max_rows = 6;
@@ -221,7 +238,8 @@ void App::render_result(const ResultState& s) noexcept {
 						gfx_SetColor(ui::color::kDarkGray);
 						gfx_Rectangle(x, y, cell_w - 1, cell_h - 1);
 
-						const matrix_core::Rational& v = s.data[static_cast<std::size_t>(r) * s.stride + static_cast<std::size_t>(c)];
+						const matrix_core::Rational& v =
+						        data[static_cast<std::size_t>(r) * s.stride + static_cast<std::size_t>(c) * s.col_stride];
 						fmt_buf_[0] = '\0';
 						matrix_core::CheckedWriter w{fmt_buf_, sizeof(fmt_buf_)};
 						if (v.den() == 1) {
@@ -250,10 +268,26 @@ void App::update_result(ResultState& s) noexcept {
 #endif
 		if (s.has_steps && input_.pressed(kKbGroup1, kb_2nd) && expl_.available()) {
 				SHELL_DBG("[result] 2ND steps\n");
+				if (!build_steps()) {
+						show_message("common.out_of_memory"_tx);
+						return;
+				}
 				REQUIRE(push(Page::make_steps()), "push steps failed");
 				return;
 		}
 
+		// L -> U -> P
+		if (s.op == OperationId::Lu) {
+				if (input_.repeat(kKbGroupArrows, kb_Right)) {
+						s.i = static_cast<std::uint8_t>((s.i + 1u) % 3u);
+						return;
+				}
+				if (input_.repeat(kKbGroupArrows, kb_Left)) {
+						s.i = static_cast<std::uint8_t>((s.i + 2u) % 3u);
+						return;
+				}
+		}
+
 		if (!input_.pressed(kKbGroup6, kb_Clear))
 				return;
 		SHELL_DBG("[result] CLEAR back -> drop tail\n");
@@ -29,6 +29,10 @@ using detail::kScreenW;
 using detail::op_is_binary;
 using detail::op_name;
 using namespace matrix_shell::text_literals;
+
+// explain_detail thresholds: 4x4 and up, or under 1 KiB of persist_ left
+constexpr std::size_t kCompactMinEntries = 16;
+constexpr std::size_t kCompactBelowBytes = 1024;
 } // namespace
 
 void App::render_slot_pick(const SlotPickState& s) noexcept {
@@ -80,6 +84,75 @@ void App::render_slot_pick(const SlotPickState& s) noexcept {
 		}
 }
 
+// one step per pivot column instead of per row op: for big inputs, whose
+// full walkthroughs run to dozens of steps, and when persist_ is nearly full
+matrix_core::ExplainDetail App::explain_detail(matrix_core::MatrixView a) const noexcept {
+		const std::size_t left = persist_.capacity() - persist_.used();
+		if (a.rows * a.cols >= kCompactMinEntries || left < kCompactBelowBytes)
+				return matrix_core::ExplainDetail::Compact;
+		return matrix_core::ExplainDetail::Full;
+}
+
+matrix_core::ResultKey App::result_key(OperationId op, std::uint8_t slot) const noexcept {
+		matrix_core::ResultKey key;
+		key.op = static_cast<std::uint8_t>(op);
+		key.flags = static_cast<std::uint8_t>(explain_detail(slots_[slot].view_active()));
+		key.tag = slot;
+		key.a = slots_[slot].hash;
+		return key;
+}
+
+// Det, Inverse, Ref or Rref of a slot: the result data and the explanation
+// context (for Det and Inverse a recipe, built when the steps are first
+// opened) go to arena, page is the result page to show. BufferTooSmall when
+// arena cannot hold the result
+matrix_core::Error App::compute_slot_result(
+        OperationId op, std::uint8_t slot, matrix_core::Arena& arena, Page* page, matrix_core::Explanation* expl) noexcept {
+		const matrix_core::MatrixView a = slots_[slot].view_active();
+		matrix_core::ArenaScope tx(arena);
+		matrix_core::ArenaScratchScope scratch_tx(scratch_);
+
+		matrix_core::ExplainOptions opts_steps;
+		opts_steps.enable = true;
+		opts_steps.persist = &arena;
+		opts_steps.detail = explain_detail(a);
+		// most results are never opened in the step viewer
+		opts_steps.lazy = true;
+
+		if (op == OperationId::Det) {
+				matrix_core::Rational v = matrix_core::Rational::from_int(0);
+				const matrix_core::Error err = matrix_core::op_det_cached(a, lu_cache_, scratch_, &v, expl, opts_steps);
+				SHELL_DBG("[op] det err=%u a=%ux%u value=", (unsigned)err.code, (unsigned)err.a.rows, (unsigned)err.a.cols);
+				dbg_print_rational(v);
+				SHELL_DBG("\n");
+				if (!matrix_core::is_ok(err))
+						return err;
+				*page = Page::make_result_scalar(op, slot, 0, expl->available(), v.num(), v.den());
+				tx.commit();
+				return err;
+		}
+
+		// an inverse is only asked for a square slot, so both results are rows x cols
+		matrix_core::MatrixMutView outm{};
+		if (!matrix_core::is_ok(matrix_core::matrix_alloc(arena, a.rows, a.cols, &outm)))
+				return {matrix_core::ErrorCode::BufferTooSmall};
+
+		matrix_core::Error err;
+		if (op == OperationId::Inverse) {
+				err = matrix_core::op_inverse_cached(a, lu_cache_, scratch_, outm, expl, opts_steps);
+		} else {
+				const matrix_core::EchelonKind kind =
+				        (op == OperationId::Ref) ? matrix_core::EchelonKind::Ref : matrix_core::EchelonKind::Rref;
+				err = matrix_core::op_echelon(a, kind, outm, expl, opts_steps);
+		}
+		SHELL_DBG("[op] %s err=%u a=%ux%u\n", op_name(op), (unsigned)err.code, (unsigned)err.a.rows, (unsigned)err.a.cols);
+		if (!matrix_core::is_ok(err))
+				return err;
+		*page = Page::make_result_matrix(op, slot, 0, expl->available(), outm.rows, outm.cols, outm.stride, outm.data);
+		tx.commit();
+		return err;
+}
+
 void App::update_slot_pick(SlotPickState& s) noexcept {
 		// back
 		if (input_.pressed(kKbGroup6, kb_Clear)) {
@@ -222,24 +295,15 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 #endif
 
 				if (s.op == OperationId::Transpose) {
+						// A^T is a view of the slot, only the explanation lives in persist_
 						matrix_core::ArenaScope tx(persist_);
-						matrix_core::MatrixMutView out{};
-						const matrix_core::ErrorCode ec = matrix_core::matrix_alloc(persist_, a.cols, a.rows, &out);
-						if (!matrix_core::is_ok(ec)) {
-								SHELL_DBG("[op] transpose alloc failed ec=%u used=%u/%u\n",
-								        (unsigned)ec,
-								        (unsigned)persist_.used(),
-								        (unsigned)persist_.capacity());
-								show_message("common.out_of_memory"_tx);
-								return;
-						}
-
 						matrix_core::ExplainOptions opts_steps;
 						opts_steps.enable = true;
 						opts_steps.persist = &persist_;
 
 						matrix_core::Explanation expl;
-						const matrix_core::Error err = matrix_core::op_transpose(a, out, &expl, opts_steps);
+						matrix_core::MatrixView out{};
+						const matrix_core::Error err = matrix_core::op_transpose_view(a, &out, &expl, opts_steps);
 						SHELL_DBG("[op] transpose err=%u a=%ux%u\n", (unsigned)err.code, (unsigned)err.a.rows, (unsigned)err.a.cols);
 						if (!matrix_core::is_ok(err)) {
 								if (err.code == matrix_core::ErrorCode::Overflow) {
@@ -252,28 +316,58 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 						tx.commit();
 						expl_ = std::move(expl);
 						REQUIRE(pop(), "pop failed (transpose)");
-						REQUIRE(push(Page::make_result_matrix(
-						                OperationId::Transpose, sel, 0, expl_.available(), out.rows, out.cols, out.stride, out.data)),
+						REQUIRE(push(Page::make_result_view(OperationId::Transpose, sel, 0, expl_.available(), out)),
 						        "push transpose result failed");
 						return;
 				}
 
-				if (s.op == OperationId::Det) {
-						matrix_core::ArenaScope tx(persist_);
-						matrix_core::ArenaScratchScope scratch_tx(scratch_);
+				// an unchanged slot reopens its Det/Inverse/Ref/Rref result from the cache;
+				// a miss computes into the entry it hands out
+				if (s.op == OperationId::Det || s.op == OperationId::Inverse || s.op == OperationId::Ref || s.op == OperationId::Rref) {
+						if (s.op == OperationId::Inverse && a.rows != a.cols) {
+								fmt_buf_[0] = '\0';
+								matrix_core::CheckedWriter w{fmt_buf_, sizeof(fmt_buf_)};
+								w.append("msg.inverse_requires_square_prefix"_tx);
+								w.put(static_cast<char>('A' + sel));
+								w.append("=");
+								w.append_u64(a.rows);
+								w.put('x');
+								w.append_u64(a.cols);
+								show_message(fmt_buf_);
+								return;
+						}
 
-						matrix_core::ExplainOptions opts_steps;
-						opts_steps.enable = true;
-						opts_steps.persist = &persist_;
+						const matrix_core::ResultKey key = result_key(s.op, sel);
+						if (const matrix_core::ResultCache::Entry* hit = result_cache_.find(key, a)) {
+								SHELL_DBG("[pick] result cache hit op=%s sel=%c\n", op_name(s.op), (char)('A' + sel));
+								expl_ = hit->expl.borrow();
+								REQUIRE(pop(), "pop failed (cached result)");
+								REQUIRE(push_result(*static_cast<const Page*>(hit->payload)), "push cached result failed");
+								return;
+						}
+						grow_result_cache();
+						matrix_core::ResultCache::Entry* fill = result_cache_.begin(key, a);
 
+						// Ref/Rref run a few row ops per frame under the Busy page (the
+						// first slice right away, so small slots never show it)
+						if (s.op == OperationId::Ref || s.op == OperationId::Rref) {
+								if (!start_busy(s.op, sel, fill)) {
+										show_message("common.out_of_memory"_tx);
+										return;
+								}
+								REQUIRE(pop(), "pop failed (busy op)");
+								REQUIRE(push(Page::make_busy(s.op, sel)), "push busy failed");
+								run_busy();
+								return;
+						}
+
+						Page p{};
 						matrix_core::Explanation expl;
-						matrix_core::Rational v = matrix_core::Rational::from_int(0);
-						const matrix_core::Error err = matrix_core::op_det(a, scratch_, &v, &expl, opts_steps);
-						SHELL_DBG("[op] det err=%u a=%ux%u value=", (unsigned)err.code, (unsigned)err.a.rows, (unsigned)err.a.cols);
-						dbg_print_rational(v);
-						SHELL_DBG("\n");
+						const matrix_core::Error err = compute_slot_result(s.op, sel, fill ? fill->arena : persist_, &p, &expl);
 						if (!matrix_core::is_ok(err)) {
-								if (err.code == matrix_core::ErrorCode::NotSquare) {
+								if (err.code == matrix_core::ErrorCode::BufferTooSmall) {
+										show_message("common.out_of_memory"_tx);
+								} else if (s.op == OperationId::Det && err.code == matrix_core::ErrorCode::NotSquare) {
 										fmt_buf_[0] = '\0';
 										matrix_core::CheckedWriter w{fmt_buf_, sizeof(fmt_buf_)};
 										w.append("msg.det_requires_square_prefix"_tx);
@@ -283,24 +377,29 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 										w.put('x');
 										w.append_u64(a.cols);
 										show_message(fmt_buf_);
-								} else
+								} else if (s.op == OperationId::Inverse && err.code == matrix_core::ErrorCode::Singular) {
+										show_message("msg.singular_no_inverse"_tx);
+								} else if (s.op == OperationId::Inverse && (err.code == matrix_core::ErrorCode::NotSquare ||
+								                                              err.code == matrix_core::ErrorCode::DimensionMismatch ||
+								                                              err.code == matrix_core::ErrorCode::Internal)) {
+										fail_fast("update_slot_pick: inverse returned unexpected error");
+								} else {
 										show_message("common.error"_tx);
+								}
 								return;
 						}
 
-						tx.commit();
-						REQUIRE(pop(), "pop failed (det)");
-						expl_ = std::move(expl);
-						REQUIRE(push(Page::make_result_scalar(OperationId::Det, sel, 0, expl_.available(), v.num(), v.den())),
-						        "push det result failed");
+						REQUIRE(pop(), "pop failed (cached op)");
+						keep_result(fill, std::move(expl), p);
+						REQUIRE(push_result(p), "push result failed");
 						return;
 				}
 
-				if (s.op == OperationId::Inverse) {
+				if (s.op == OperationId::Lu) {
 						if (a.rows != a.cols) {
 								fmt_buf_[0] = '\0';
 								matrix_core::CheckedWriter w{fmt_buf_, sizeof(fmt_buf_)};
-								w.append("msg.inverse_requires_square_prefix"_tx);
+								w.append("msg.requires_square_prefix"_tx);
 								w.put(static_cast<char>('A' + sel));
 								w.append("=");
 								w.append_u64(a.rows);
@@ -312,41 +411,45 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 
 						matrix_core::ArenaScratchScope scratch_tx(scratch_);
 
+						// L, U and P side by side so the result page can toggle between them;
+						// 3n columns exceed kMaxCols, so the block comes straight from the arena
 						const std::uint8_t n = a.rows;
+						const std::uint8_t stride = static_cast<std::uint8_t>(3u * n);
+						const std::size_t count = static_cast<std::size_t>(n) * stride;
 						matrix_core::ArenaScope tx(persist_);
-						matrix_core::MatrixMutView outm{};
-						const matrix_core::ErrorCode ec = matrix_core::matrix_alloc(persist_, n, n, &outm);
-						if (!matrix_core::is_ok(ec)) {
+						auto* packed = static_cast<matrix_core::Rational*>(
+						        persist_.allocate(sizeof(matrix_core::Rational) * count, alignof(matrix_core::Rational)));
+						if (!packed) {
 								show_message("common.out_of_memory"_tx);
 								return;
 						}
+						for (std::size_t i = 0; i < count; i++)
+								packed[i] = matrix_core::Rational::from_int(0);
+						const matrix_core::MatrixMutView l{n, n, stride, packed};
+						const matrix_core::MatrixMutView u{n, n, stride, packed + n};
+						const matrix_core::MatrixMutView p{n, n, stride, packed + 2u * n};
 
 						matrix_core::ExplainOptions opts_steps;
 						opts_steps.enable = true;
 						opts_steps.persist = &persist_;
 
 						matrix_core::Explanation expl;
-						const matrix_core::Error err = matrix_core::op_inverse(a, scratch_, outm, &expl, opts_steps);
-						SHELL_DBG("[op] inverse err=%u a=%ux%u\n", (unsigned)err.code, (unsigned)err.a.rows, (unsigned)err.a.cols);
+						const matrix_core::Error err = matrix_core::op_lu(a, scratch_, l, u, p, &expl, opts_steps);
+						SHELL_DBG("[op] lu err=%u a=%ux%u\n", (unsigned)err.code, (unsigned)err.a.rows, (unsigned)err.a.cols);
 						if (!matrix_core::is_ok(err)) {
-								if (err.code == matrix_core::ErrorCode::Singular) {
-										show_message("msg.singular_no_inverse"_tx);
-								} else if (err.code == matrix_core::ErrorCode::NotSquare ||
-								           err.code == matrix_core::ErrorCode::DimensionMismatch ||
-								           err.code == matrix_core::ErrorCode::Internal) {
-										fail_fast("update_slot_pick: inverse returned unexpected error");
-								} else {
-										show_message("common.error"_tx);
+								if (err.code == matrix_core::ErrorCode::NotSquare || err.code == matrix_core::ErrorCode::DimensionMismatch ||
+								        err.code == matrix_core::ErrorCode::Internal) {
+										fail_fast("update_slot_pick: lu returned unexpected error");
 								}
+								show_message((err.code == matrix_core::ErrorCode::Overflow) ? "common.out_of_memory"_tx : "common.error"_tx);
 								return;
 						}
 
 						tx.commit();
 						expl_ = std::move(expl);
-						REQUIRE(pop(), "pop failed (inverse)");
-						REQUIRE(push(Page::make_result_matrix(
-						                s.op, sel, 0, expl_.available(), outm.rows, outm.cols, outm.stride, outm.data)),
-						        "push inverse result failed");
+						REQUIRE(pop(), "pop failed (lu)");
+						REQUIRE(push(Page::make_result_matrix(s.op, sel, 0, expl_.available(), n, n, stride, packed)),
+						        "push lu result failed");
 						return;
 				}
 
@@ -413,66 +516,36 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 						opts_steps.persist = &persist_;
 						matrix_core::Explanation expl;
 
-						matrix_core::MatrixView input = a;
-						matrix_core::MatrixMutView at_owned{};
-						if (s.op == OperationId::LeftNullSpaceBasis) {
-								// Keep A^T alive for the step renderer.
-								const matrix_core::ErrorCode ec_t = matrix_core::matrix_alloc(persist_, a.cols, a.rows, &at_owned);
-								if (!matrix_core::is_ok(ec_t)) {
-										show_message("common.out_of_memory"_tx);
-										return;
-								}
-								const matrix_core::ErrorCode ec_tt = matrix_core::matrix_transpose(a, at_owned);
-								if (!matrix_core::is_ok(ec_tt)) {
-										show_message("common.error"_tx);
-										return;
-								}
-								input = at_owned.view();
-						}
-
-						matrix_core::MatrixMutView rref{};
-						const matrix_core::ErrorCode ec_r = matrix_core::matrix_alloc(scratch_, input.rows, input.cols, &rref);
-						if (!matrix_core::is_ok(ec_r)) {
-								show_message("common.out_of_memory"_tx);
-								return;
-						}
-
-						const matrix_core::Error err = matrix_core::op_echelon(input, matrix_core::EchelonKind::Rref, rref, &expl, opts_steps);
+						// one RREF of [A | I] serves all four, cached while the slot is unchanged
+						const bool left_null = (s.op == OperationId::LeftNullSpaceBasis);
+						const matrix_core::FundamentalSpaces* spaces = nullptr;
+						const matrix_core::Error err =
+						        matrix_core::op_fundamental_spaces(a, spaces_cache_, scratch_, left_null, &spaces, &expl, opts_steps);
+						SHELL_DBG("[op] spaces err=%u hits=%u misses=%u\n",
+						        (unsigned)err.code,
+						        (unsigned)spaces_cache_.hits(),
+						        (unsigned)spaces_cache_.misses());
 						if (!matrix_core::is_ok(err)) {
 								show_message("common.error"_tx);
 								return;
 						}
-
-						matrix_core::SpaceInfo info{};
-						const matrix_core::ErrorCode ec_info = matrix_core::space_info_from_rref(rref.view(), input.cols, &info);
-						if (!matrix_core::is_ok(ec_info)) {
-								show_message("common.error"_tx);
-								return;
-						}
+						const matrix_core::SpaceInfo& info = spaces->info;
 						const std::uint32_t piv_mask = info.pivot_mask;
-						const std::uint8_t nullity = info.nullity;
+						const std::uint8_t nullity = left_null ? static_cast<std::uint8_t>(a.rows - info.rank) : info.nullity;
 
 						matrix_core::MatrixMutView out{};
-						if (s.op == OperationId::ColSpaceBasis) {
-								const matrix_core::ErrorCode ec_o = matrix_core::space_col_basis(a, info, persist_, &out);
-								if (!matrix_core::is_ok(ec_o)) {
-										show_message("common.out_of_memory"_tx);
-										return;
-								}
-						} else if (s.op == OperationId::RowSpaceBasis) {
-								const matrix_core::ErrorCode ec_o = matrix_core::space_row_basis(rref.view(), input.cols, info, persist_, &out);
-								if (!matrix_core::is_ok(ec_o)) {
-										show_message("common.out_of_memory"_tx);
-										return;
-								}
-						} else {
-								// Null(A) or Null(A^T)
-								const std::uint8_t var_cols = input.cols;
-								const matrix_core::ErrorCode ec_o = matrix_core::space_null_basis(rref.view(), var_cols, info, persist_, &out);
-								if (!matrix_core::is_ok(ec_o)) {
-										show_message("common.out_of_memory"_tx);
-										return;
-								}
+						matrix_core::ErrorCode ec_o = matrix_core::ErrorCode::Ok;
+						if (s.op == OperationId::ColSpaceBasis)
+								ec_o = matrix_core::space_col_basis(a, info, persist_, &out);
+						else if (s.op == OperationId::RowSpaceBasis)
+								ec_o = matrix_core::space_row_basis(spaces->reduced, a.cols, info, persist_, &out);
+						else if (s.op == OperationId::NullSpaceBasis)
+								ec_o = matrix_core::space_null_basis(spaces->reduced, a.cols, info, persist_, &out);
+						else
+								ec_o = matrix_core::space_left_null_basis(*spaces, persist_, &out);
+						if (!matrix_core::is_ok(ec_o)) {
+								show_message("common.out_of_memory"_tx);
+								return;
 						}
 
 						tx.commit();
@@ -487,42 +560,6 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 						return;
 				}
 
-				if (s.op == OperationId::Ref || s.op == OperationId::Rref) {
-						matrix_core::ArenaScope tx(persist_);
-						matrix_core::MatrixMutView outm{};
-						const matrix_core::ErrorCode ec = matrix_core::matrix_alloc(persist_, a.rows, a.cols, &outm);
-						if (!matrix_core::is_ok(ec)) {
-								show_message("common.out_of_memory"_tx);
-								return;
-						}
-
-						matrix_core::Explanation expl;
-						matrix_core::ExplainOptions opts_steps;
-						opts_steps.enable = true;
-						opts_steps.persist = &persist_;
-
-						const matrix_core::EchelonKind kind =
-						        (s.op == OperationId::Ref) ? matrix_core::EchelonKind::Ref : matrix_core::EchelonKind::Rref;
-						const matrix_core::Error err = matrix_core::op_echelon(a, kind, outm, &expl, opts_steps);
-						SHELL_DBG(
-						        "[op] %s err=%u a=%ux%u\n", op_name(s.op), (unsigned)err.code, (unsigned)err.a.rows, (unsigned)err.a.cols);
-						if (!matrix_core::is_ok(err)) {
-								if (err.code == matrix_core::ErrorCode::DimensionMismatch || err.code == matrix_core::ErrorCode::Internal) {
-										fail_fast("update_slot_pick: echelon returned unexpected error");
-								}
-								show_message("common.error"_tx);
-								return;
-						}
-
-						tx.commit();
-						expl_ = std::move(expl);
-						REQUIRE(pop(), "pop failed (echelon)");
-						REQUIRE(push(Page::make_result_matrix(
-						                s.op, sel, 0, expl_.available(), outm.rows, outm.cols, outm.stride, outm.data)),
-						        "push echelon result failed");
-						return;
-				}
-
 				fail_fast("Unhandled unary OperationId in update_slot_pick");
 		}
 
@@ -656,6 +693,43 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 		}
 #endif
 
+		if (s.op == OperationId::SolveRref && b.cols > 1 && b.rows == a.rows) {
+				// several right-hand sides: X with one solution per column of B
+				matrix_core::ArenaScope tx(persist_);
+				matrix_core::ArenaScratchScope scratch_tx(scratch_);
+
+				matrix_core::ExplainOptions opts_steps;
+				opts_steps.enable = true;
+				opts_steps.persist = &persist_;
+				matrix_core::Explanation expl;
+
+				matrix_core::MatrixMutView x{};
+				const matrix_core::ErrorCode ec_x = matrix_core::matrix_alloc(persist_, a.cols, b.cols, &x);
+				if (!matrix_core::is_ok(ec_x)) {
+						show_message("common.out_of_memory"_tx);
+						return;
+				}
+
+				const matrix_core::Error err = matrix_core::op_solve_multi(a, b, scratch_, x, &expl, opts_steps);
+				SHELL_DBG("[op] solve multi err=%u col=%u\n", (unsigned)err.code, (unsigned)err.j);
+				if (err.code == matrix_core::ErrorCode::Inconsistent) {
+						show_message("msg.no_solution"_tx);
+						return;
+				}
+				if (!matrix_core::is_ok(err)) {
+						show_message("common.error"_tx);
+						return;
+				}
+
+				tx.commit();
+				expl_ = std::move(expl);
+				REQUIRE(pop(), "pop failed (solve multi)");
+				Page p = Page::make_result_matrix(s.op, a_slot, b_slot, expl_.available(), x.rows, x.cols, x.stride, x.data);
+				p.u.result.den = b.cols;
+				REQUIRE(push(p), "push solve multi result failed");
+				return;
+		}
+
 		if (s.op == OperationId::SolveRref) {
 				if (b.cols != 1 || b.rows != a.rows) {
 						show_message("msg.need_b_mx1"_tx);
@@ -677,18 +751,13 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 				const std::uint8_t m = a.rows;
 				const std::uint8_t n = a.cols;
 
-				// Build augmented matrix [A | b] in persist so the step renderer can reference it.
-				matrix_core::MatrixMutView aug{};
-				const matrix_core::ErrorCode ec_aug = matrix_core::matrix_alloc(persist_, m, static_cast<std::uint8_t>(n + 1u), &aug);
+				// [A | b] read in place from the slots, which outlive the explanation
+				matrix_core::AugmentedView aug{};
+				const matrix_core::ErrorCode ec_aug = matrix_core::augmented_view(a, b, &aug);
 				if (!matrix_core::is_ok(ec_aug)) {
-						show_message("common.out_of_memory"_tx);
+						show_message("common.error"_tx);
 						return;
 				}
-				for (std::uint8_t r = 0; r < m; r++) {
-						for (std::uint8_t c = 0; c < n; c++)
-								aug.at_mut(r, c) = a.at(r, c);
-						aug.at_mut(r, n) = b.at(r, 0);
-				}
 
 				matrix_core::MatrixMutView rref_aug{};
 				const matrix_core::ErrorCode ec_rref = matrix_core::matrix_alloc(scratch_, m, static_cast<std::uint8_t>(n + 1u), &rref_aug);
@@ -697,7 +766,7 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 						return;
 				}
 
-				const matrix_core::Error err = matrix_core::op_echelon(aug.view(), matrix_core::EchelonKind::Rref, rref_aug, &expl, opts_steps);
+				const matrix_core::Error err = matrix_core::op_echelon_augmented(aug, matrix_core::EchelonKind::Rref, rref_aug, &expl, opts_steps);
 				if (!matrix_core::is_ok(err)) {
 						show_message("common.error"_tx);
 						return;
@@ -907,7 +976,7 @@ void App::update_slot_pick(SlotPickState& s) noexcept {
 				}
 
 				matrix_core::ArenaScratchScope scratch_tx(scratch_);
-				const matrix_core::Error err = matrix_core::op_cramer_solve(a, b, scratch_, x_out);
+				const matrix_core::Error err = matrix_core::op_cramer_solve_cached(a, b, lu_cache_, scratch_, x_out);
 				SHELL_DBG("[op] cramer err=%u a=%ux%u b=%ux%u\n",
 				        (unsigned)err.code,
 				        (unsigned)err.a.rows,
@@ -38,22 +38,121 @@ const char* footer_steps_scroll() noexcept {
 }
 } // namespace
 
+// a new step index: the formatted steps stay for paging back
 void App::steps_tex_reset() noexcept {
-		steps_tex_release();
+		tex_scroll_y_ = 0;
 }
 
 void App::steps_tex_release() noexcept {
-		tex_cached_step_index_ = 0xFFFF;
-		tex_cached_step_ec_ = matrix_core::ErrorCode::Internal;
 		tex_scroll_y_ = 0;
-		tex_total_height_ = 0;
-		tex_doc_[0] = '\0';
-		if (tex_layout_) {
+		if (step_tex_shown_ && tex_renderer_)
+				tex_renderer_invalidate(tex_renderer_);
+		step_tex_shown_ = nullptr;
+		for (StepTex& t : step_tex_) {
+				if (t.layout)
+						tex_free(t.layout);
+				t.layout = nullptr;
+				t.index = StepTex::kEmpty;
+		}
+}
+
+StepTex* App::step_tex_find(std::size_t idx) noexcept {
+		for (StepTex& t : step_tex_) {
+				if (t.index == idx)
+						return &t;
+		}
+		return nullptr;
+}
+
+// renders and formats step idx into the slot farthest from step center. when
+// tex_format runs out of memory the other steps' layouts are dropped and it
+// is tried once more
+StepTex* App::step_tex_format(std::size_t idx, std::size_t center) noexcept {
+		const ui::Layout l = ui::Layout{};
+
+		StepTex* victim = &step_tex_[0];
+		std::size_t victim_dist = 0;
+		for (StepTex& t : step_tex_) {
+				if (t.index == StepTex::kEmpty) {
+						victim = &t;
+						break;
+				}
+				const std::size_t dist = (t.index > center) ? t.index - center : center - t.index;
+				if (dist > victim_dist) {
+						victim = &t;
+						victim_dist = dist;
+				}
+		}
+		if (victim == step_tex_shown_) {
 				if (tex_renderer_)
 						tex_renderer_invalidate(tex_renderer_);
-				tex_free(tex_layout_);
-				tex_layout_ = nullptr;
+				step_tex_shown_ = nullptr;
+		}
+		if (victim->layout)
+				tex_free(victim->layout);
+		victim->layout = nullptr;
+		victim->height = 0;
+		victim->text = nullptr;
+		victim->index = static_cast<std::uint16_t>(idx);
+
+		{
+				matrix_core::ArenaScratchScope scratch_tx(scratch_);
+				matrix_core::StepRenderBuffers out;
+				out.scratch = &scratch_;
+				out.cache = &step_cache_;
+				out.rows = &step_rows_;
+				// shorter documents lay out faster and less tall
+				out.style = matrix_core::latex::MatrixStyle::FactorDenominator;
+
+				// rendered in place, so tex_format reads the core's text as written
+				matrix_core::StepDocument doc{victim->doc, sizeof(victim->doc), kStepCaptionBytes};
+				victim->ec = expl_.render_document(idx, out, &doc);
+				victim->text = doc.text;
+		}
+		SHELL_DBG("[steps] render idx=%u center=%u ec=%u\n", (unsigned)idx, (unsigned)center, (unsigned)victim->ec);
+		if (!matrix_core::is_ok(victim->ec))
+				return victim;
+
+		victim->layout = tex_format(victim->text, kScreenW - 2 * l.margin_x, &kTeXCfg);
+		if (!victim->layout) {
+				bool dropped = false;
+				for (StepTex& t : step_tex_) {
+						if (&t == victim || !t.layout)
+								continue;
+						if (&t == step_tex_shown_) {
+								if (tex_renderer_)
+										tex_renderer_invalidate(tex_renderer_);
+								step_tex_shown_ = nullptr;
+						}
+						tex_free(t.layout);
+						t.layout = nullptr;
+						t.index = StepTex::kEmpty;
+						dropped = true;
+				}
+				if (dropped)
+						victim->layout = tex_format(victim->text, kScreenW - 2 * l.margin_x, &kTeXCfg);
+		}
+		if (!victim->layout) {
+				SHELL_DBG("[tex] tex_format failed idx=%u\n", (unsigned)idx);
+				return victim;
+		}
+		victim->height = tex_get_total_height(victim->layout);
+		return victim;
+}
+
+// formats one neighbor of the step on screen per idle frame, the next one
+// first
+void App::prefetch_steps(const StepsState& s) noexcept {
+		if (!expl_.available() || !step_tex_find(s.index))
+				return;
+		const std::size_t n = expl_.step_count();
+		const std::size_t idx = s.index;
+		if (idx + 1 < n && !step_tex_find(idx + 1)) {
+				step_tex_format(idx + 1, idx);
+				return;
 		}
+		if (idx > 0 && !step_tex_find(idx - 1))
+				step_tex_format(idx - 1, idx);
 }
 
 #if MATRIX_SHELL_ENABLE_CRAMER && MATRIX_CORE_ENABLE_CRAMER
@@ -144,68 +243,41 @@ void App::render_steps(const StepsState& s) noexcept {
 
 		const int content_y = l.header_h + 18;
 
-		// build and cache core step buffers + tex layout only when the step changes
-		if (tex_cached_step_index_ != static_cast<std::uint16_t>(idx)) {
-				steps_tex_release();
-
-				step_caption_[0] = '\0';
-				step_latex_[0] = '\0';
-
-				{
-						matrix_core::ArenaScratchScope scratch_tx(scratch_);
-						matrix_core::StepRenderBuffers out;
-						out.caption = step_caption_;
-						out.caption_cap = sizeof(step_caption_);
-						out.latex = step_latex_;
-						out.latex_cap = sizeof(step_latex_);
-						out.scratch = &scratch_;
-
-						tex_cached_step_ec_ = expl_.render_step(idx, out);
-				}
-				SHELL_DBG("[steps] render idx=%u/%u ec=%u\n", (unsigned)idx, (unsigned)n, (unsigned)tex_cached_step_ec_);
-
-				if (!matrix_core::is_ok(tex_cached_step_ec_)) {
-						gfx_SetTextFGColor(ui::color::kBlack);
-						gfx_SetTextXY(l.margin_x, content_y);
-						gfx_PrintString("steps.render_failed"_tx);
-						render_footer_hint(footer_steps_no_scroll());
-						return;
-				}
-
-				tex_doc_[0] = '\0';
-				matrix_core::CheckedWriter texw{tex_doc_, sizeof(tex_doc_)};
-				if (step_caption_[0] != '\0') {
-						texw.append(step_caption_);
-						texw.put('\n');
-				}
-				texw.append(step_latex_);
+		// a step formatted ahead (or on an earlier visit) is just swapped in
+		StepTex* t = step_tex_find(idx);
+		if (!t)
+				t = step_tex_format(idx, idx);
 
-				tex_layout_ = tex_format(tex_doc_, kScreenW - 2 * l.margin_x, &kTeXCfg);
-				if (!tex_layout_) {
-						SHELL_DBG("[tex] tex_format failed\n");
+		if (!matrix_core::is_ok(t->ec)) {
+				gfx_SetTextFGColor(ui::color::kBlack);
+				gfx_SetTextXY(l.margin_x, content_y);
+				gfx_PrintString("steps.render_failed"_tx);
+				render_footer_hint(footer_steps_no_scroll());
+				return;
+		}
+		if (!t->layout) {
+				// a neighbor formatted ahead with too little memory; the step on
+				// screen gets another try that can drop the others
+				t = step_tex_format(idx, idx);
+				if (!t->layout) {
 						gfx_SetTextXY(l.margin_x, content_y);
 						gfx_PrintString("steps.tex_failed"_tx);
 						render_footer_hint(footer_steps_no_scroll());
 						return;
 				}
-				tex_total_height_ = tex_get_total_height(tex_layout_);
-				tex_cached_step_index_ = static_cast<std::uint16_t>(idx);
-				tex_scroll_y_ = 0;
 		}
 
-		if (!matrix_core::is_ok(tex_cached_step_ec_)) {
-				gfx_SetTextFGColor(ui::color::kBlack);
-				gfx_SetTextXY(l.margin_x, content_y);
-				gfx_PrintString("steps.render_failed"_tx);
-				render_footer_hint(footer_steps_no_scroll());
-				return;
+		if (t != step_tex_shown_) {
+				if (step_tex_shown_ && tex_renderer_)
+						tex_renderer_invalidate(tex_renderer_);
+				step_tex_shown_ = t;
 		}
 
-		if (tex_layout_ && tex_renderer_) {
+		if (tex_renderer_) {
 				// libtexce uses a fixed 240px viewport. render first, then redraw footer to
 				// keep UI on top
 				const int view_h = kScreenH - content_y - l.footer_h;
-				int max_scroll = tex_total_height_ - view_h;
+				int max_scroll = t->height - view_h;
 				if (max_scroll < 0)
 						max_scroll = 0;
 				if (tex_scroll_y_ < 0)
@@ -213,7 +285,7 @@ void App::render_steps(const StepsState& s) noexcept {
 				if (tex_scroll_y_ > max_scroll)
 						tex_scroll_y_ = max_scroll;
 
-				tex_draw(tex_renderer_, tex_layout_, l.margin_x, content_y, tex_scroll_y_);
+				tex_draw(tex_renderer_, t->layout, l.margin_x, content_y, tex_scroll_y_);
 		}
 
 		render_footer_hint(footer_steps_scroll());
@@ -267,6 +339,7 @@ void App::update_cramer_steps_menu(CramerStepsMenuState& s) noexcept {
 		matrix_core::ExplainOptions opts_steps;
 		opts_steps.enable = true;
 		opts_steps.persist = &persist_;
+		opts_steps.detail = explain_detail(a);
 
 		matrix_core::Explanation expl;
 		matrix_core::Rational v = matrix_core::Rational::from_int(0);
@@ -274,7 +347,7 @@ void App::update_cramer_steps_menu(CramerStepsMenuState& s) noexcept {
 
 		if (s.cursor == 0) {
 				SHELL_DBG("[cramer] run det(A)\n");
-				err = matrix_core::op_det(a, scratch_, &v, &expl, opts_steps);
+				err = matrix_core::op_det_cached(a, lu_cache_, scratch_, &v, &expl, opts_steps);
 		} else {
 				const std::uint8_t col = static_cast<std::uint8_t>(s.cursor - 1u);
 				SHELL_DBG("[cramer] run det_replace col=%u\n", (unsigned)col);